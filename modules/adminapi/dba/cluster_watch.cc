@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include "modules/adminapi/dba/cluster_watch.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "modules/adminapi/mod_dba_common.h"
+#include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/interrupt_handler.h"
+
+namespace mysqlsh {
+namespace dba {
+
+namespace {
+// shorter intervals would only keep the members busy answering the checks
+constexpr double k_min_interval = 0.5;
+
+std::string member_state(const mysqlshdk::gr::Member &member) {
+  return mysqlshdk::gr::to_string(member.state) + ", " +
+         mysqlshdk::gr::to_string(member.role);
+}
+}  // namespace
+
+Cluster_watch::Cluster_watch(Cluster *cluster, double interval)
+    : m_cluster(cluster), m_interval(interval) {
+  assert(cluster);
+}
+
+Cluster_watch::~Cluster_watch() {}
+
+void Cluster_watch::prepare() {
+  if (m_interval <= 0)
+    throw shcore::Exception::argument_error(
+        "The interval must be greater than 0.");
+
+  if (m_interval < k_min_interval) m_interval = k_min_interval;
+
+  auto replicaset = m_cluster->get_default_replicaset();
+
+  // Verify if the topology type changed and issue an error if needed.
+  replicaset->sanity_check();
+
+  m_instances = replicaset->get_instances();
+
+  for (const auto &inst : m_instances) m_labels[inst.uuid] = inst.name;
+}
+
+bool Cluster_watch::read_members(
+    std::map<std::string, mysqlshdk::gr::Member> *members) {
+  auto group_session = m_cluster->get_group_session();
+  mysqlshdk::db::Connection_options group_session_copts(
+      group_session->get_connection_options());
+
+  // the view of a member which was expelled from the group only lists that
+  // member, the first view with an ONLINE member is used instead
+  auto read_view =
+      [members](const std::shared_ptr<mysqlshdk::db::ISession> &session) {
+        std::vector<mysqlshdk::gr::Member> view(
+            mysqlshdk::gr::get_members(mysqlshdk::mysql::Instance(session)));
+
+        members->clear();
+        bool online = false;
+
+        for (const auto &member : view) {
+          (*members)[member.uuid] = member;
+          if (member.state == mysqlshdk::gr::Member_state::ONLINE)
+            online = true;
+        }
+
+        return online;
+      };
+
+  bool found = false;
+
+  if (group_session->is_open()) {
+    try {
+      if (read_view(group_session)) return true;
+      found = true;
+    } catch (const std::exception &e) {
+      log_warning("Unable to read the group members from '%s': %s",
+                  group_session_copts.uri_endpoint().c_str(), e.what());
+    }
+  }
+
+  std::map<std::string, mysqlshdk::gr::Member> fallback;
+  if (found) fallback = *members;
+
+  for (const auto &inst : m_instances) {
+    mysqlshdk::db::Connection_options opts(inst.classic_endpoint);
+    if (opts.uri_endpoint() == group_session_copts.uri_endpoint()) continue;
+
+    auto &session = m_member_sessions[inst.classic_endpoint];
+
+    try {
+      if (!session) {
+        opts.set_login_options_from(group_session_copts);
+        session = mysqlshdk::db::mysql::open_session(opts);
+      }
+
+      if (read_view(session)) return true;
+
+      if (!found) {
+        fallback = *members;
+        found = true;
+      }
+    } catch (const std::exception &e) {
+      log_warning("Unable to read the group members from '%s': %s",
+                  inst.classic_endpoint.c_str(), e.what());
+      // the session is opened again on the next check
+      if (session) session->close();
+      session.reset();
+    }
+  }
+
+  *members = fallback;
+
+  return found;
+}
+
+std::vector<std::string> Cluster_watch::describe_changes(
+    const std::map<std::string, mysqlshdk::gr::Member> &before,
+    const std::map<std::string, mysqlshdk::gr::Member> &after,
+    const std::map<std::string, std::string> &labels) {
+  std::vector<std::string> changes;
+
+  auto label = [&labels](const mysqlshdk::gr::Member &member) {
+    auto it = labels.find(member.uuid);
+    if (it != labels.end()) return it->second;
+    return member.host + ":" + std::to_string(member.gr_port);
+  };
+
+  for (const auto &member : after) {
+    auto old = before.find(member.first);
+
+    if (old == before.end()) {
+      changes.push_back(label(member.second) + ": " +
+                        member_state(member.second));
+    } else if (old->second.state != member.second.state ||
+               old->second.role != member.second.role) {
+      changes.push_back(label(member.second) + ": " +
+                        member_state(old->second) + " -> " +
+                        member_state(member.second));
+    }
+  }
+
+  for (const auto &member : before) {
+    if (after.find(member.first) == after.end())
+      changes.push_back(label(member.second) + ": no longer in the group");
+  }
+
+  return changes;
+}
+
+shcore::Value Cluster_watch::execute() {
+  auto console = mysqlsh::current_console();
+
+  console->println("Watching the cluster '" + m_cluster->get_name() +
+                   "', checking every " + shcore::str_format("%g", m_interval) +
+                   " seconds. Press Ctrl+C to stop.");
+
+  std::atomic<bool> stop{false};
+  shcore::Interrupt_handler intr([&stop]() {
+    stop = true;
+    return false;
+  });
+
+  std::map<std::string, mysqlshdk::gr::Member> previous;
+  bool reachable = true;
+  const auto interval = std::chrono::milliseconds(
+      static_cast<int64_t>(m_interval * 1000));
+
+  while (!stop) {
+    const auto next = std::chrono::steady_clock::now() + interval;
+    const std::string now = mysqlshdk::utils::fmttime("%F %T");
+
+    std::map<std::string, mysqlshdk::gr::Member> current;
+
+    if (read_members(&current)) {
+      if (!reachable) {
+        console->println(now + " The cluster can be reached again.");
+        reachable = true;
+      }
+
+      for (const auto &change :
+           describe_changes(previous, current, m_labels)) {
+        console->println(now + " " + change);
+      }
+
+      previous = std::move(current);
+    } else if (reachable) {
+      console->println(now + " No member of the cluster can be reached.");
+      reachable = false;
+    }
+
+    while (!stop && std::chrono::steady_clock::now() < next) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  }
+
+  return shcore::Value();
+}
+
+void Cluster_watch::rollback() {
+  // Do nothing right now, but it might be used in the future when
+  // transactional command execution feature will be available.
+}
+
+void Cluster_watch::finish() {
+  for (const auto &session : m_member_sessions) {
+    if (session.second) session.second->close();
+  }
+
+  m_member_sessions.clear();
+  m_instances.clear();
+  m_labels.clear();
+}
+
+}  // namespace dba
+}  // namespace mysqlsh
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef MODULES_ADMINAPI_DBA_CLUSTER_WATCH_H_
+#define MODULES_ADMINAPI_DBA_CLUSTER_WATCH_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "modules/adminapi/mod_dba_cluster.h"
+#include "modules/command_interface.h"
+#include "mysqlshdk/libs/mysql/group_replication.h"
+
+namespace mysqlsh {
+namespace dba {
+
+class Cluster_watch : public Command_interface {
+ public:
+  Cluster_watch(Cluster *cluster, double interval);
+
+  ~Cluster_watch() override;
+
+  /**
+   * Prepare the cluster watch command for execution.
+   * More specifically:
+   * - Validates the interval, raising it to the minimum of 0.5 seconds
+   * - Reads the members of the default ReplicaSet from the metadata, which is
+   * not read again while watching
+   */
+  void prepare() override;
+
+  /**
+   * Execute the cluster watch command.
+   * More specifically:
+   * - Reads the membership of the group every interval seconds, using a single
+   * query on one of the members, and prints the changes found, until
+   * interrupted
+   *
+   * @return an empty shcore::Value
+   */
+  shcore::Value execute() override;
+
+  /**
+   * Rollback the command.
+   *
+   * NOTE: Not currently used (does nothing).
+   */
+  void rollback() override;
+
+  /**
+   * Finalize the command execution.
+   * More specifically:
+   * - Closes the sessions opened to the members.
+   */
+  void finish() override;
+
+  /**
+   * Describes the differences between two views of the group membership.
+   *
+   * @param before members of the previous view, keyed by UUID
+   * @param after members of the current view, keyed by UUID
+   * @param labels names used to refer to the members, keyed by UUID, members
+   *        which are not listed are named after their address
+   *
+   * @return one line for every member which joined, left or changed its
+   *         state or role
+   */
+  static std::vector<std::string> describe_changes(
+      const std::map<std::string, mysqlshdk::gr::Member> &before,
+      const std::map<std::string, mysqlshdk::gr::Member> &after,
+      const std::map<std::string, std::string> &labels);
+
+ private:
+  Cluster *m_cluster = nullptr;
+  double m_interval = 0;
+
+  std::vector<ReplicaSet::Instance_info> m_instances;
+  std::map<std::string, std::string> m_labels;
+
+  // sessions to the members, kept open while watching, the group session of
+  // the cluster is used while it is available
+  std::map<std::string, std::shared_ptr<mysqlshdk::db::ISession>>
+      m_member_sessions;
+
+  bool read_members(std::map<std::string, mysqlshdk::gr::Member> *members);
+};
+
+}  // namespace dba
+}  // namespace mysqlsh
+
+#endif  // MODULES_ADMINAPI_DBA_CLUSTER_WATCH_H_
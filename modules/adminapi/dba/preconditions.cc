@@ -29,6 +29,7 @@
 #include "mysqlshdk/libs/db/utils_error.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
 #include "mysqlshdk/libs/mysql/instance.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 
 namespace mysqlsh {
 namespace dba {
@@ -98,6 +99,9 @@ const std::map<std::string, FunctionAvailability>
         {"Cluster.status",
          {GRInstanceType::InnoDBCluster, ReplicationQuorum::State::Any,
           ManagedInstance::State::Any}},
+        {"Cluster.watch",
+         {GRInstanceType::InnoDBCluster, ReplicationQuorum::State::Any,
+          ManagedInstance::State::Any}},
         {"Cluster.options",
          {GRInstanceType::InnoDBCluster, ReplicationQuorum::State::Any,
           ManagedInstance::State::Any}},
@@ -353,6 +357,7 @@ Cluster_check_info check_function_preconditions(
     const std::string &function_name,
     const std::shared_ptr<mysqlshdk::db::ISession> &group_session) {
   assert(function_name.find('.') != std::string::npos);
+  mysqlshdk::utils::Profile_stage stage("Checking preconditions");
 
   if (!group_session)
     throw shcore::Exception::runtime_error(
@@ -21,16 +21,49 @@
  * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <thread>
 #include <utility>
 
 #include "modules/adminapi/dba/replicaset_status.h"
 #include "modules/adminapi/mod_dba_common.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_mysql_parsing.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/shell_init.h"
 
 namespace mysqlsh {
 namespace dba {
 
 namespace {
+// a group has at most 9 members, so all of them are contacted at once
+constexpr size_t k_max_member_threads = 9;
+
+// members which do not respond in time are reported as unreachable, the
+// timeouts apply to the connection and to each read from or write to it
+constexpr int k_member_connect_timeout =
+    mysqlshdk::db::k_default_connect_timeout;
+constexpr unsigned int k_member_net_timeout = 10;
+
+std::string error_message(const std::exception_ptr &error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const mysqlshdk::db::Error &e) {
+    return e.format();
+  } catch (const std::exception &e) {
+    return e.what();
+  } catch (...) {
+    return "Unknown error";
+  }
+}
+
 template <typename R>
 inline bool set_uint(shcore::Dictionary_t dict, const std::string &prop,
                      const R &row, const std::string &field) {
@@ -91,6 +124,67 @@ inline bool set_ts(shcore::Dictionary_t dict, const std::string &prop,
 
 }  // namespace
 
+namespace detail {
+
+std::vector<std::exception_ptr> run_for_each_member(
+    size_t count, size_t max_threads,
+    const std::function<void(size_t)> &func) {
+  std::vector<std::exception_ptr> errors(count);
+  std::atomic<size_t> next{0};
+
+  const auto worker = [count, &func, &errors, &next]() {
+    mysqlsh::thread_init();
+
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        func(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+
+    mysqlsh::thread_end();
+  };
+
+  std::vector<std::thread> threads;
+  shcore::on_leave_scope join_threads([&threads]() {
+    for (auto &thread : threads) thread.join();
+  });
+
+  for (size_t t = 0; t < std::min(count, max_threads); t++)
+    threads.emplace_back(worker);
+
+  return errors;
+}
+
+std::vector<std::shared_ptr<mysqlshdk::db::IResult>> query_batch(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const std::string &sql) {
+  std::vector<std::shared_ptr<mysqlshdk::db::IResult>> results;
+
+  if (auto classic =
+          std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(session)) {
+    classic->execute_batch(sql.data(), sql.size(), &results, true);
+  } else {
+    // the statements are split by the SQL parser, so a ';' inside a string
+    // or an identifier does not end them
+    std::stringstream stream(sql);
+    mysqlshdk::utils::iterate_sql_stream(
+        &stream, sql.size() + 1,
+        [&session, &results](const char *s, size_t len, const std::string &,
+                             size_t) {
+          results.push_back(session->querys(s, len));
+          results.back()->buffer();
+          return true;
+        },
+        [](const std::string &err) { throw std::runtime_error(err); });
+  }
+
+  return results;
+}
+
+}  // namespace detail
+
 Replicaset_status::Replicaset_status(
     std::shared_ptr<ReplicaSet> replicaset,
     mysqlshdk::utils::nullable<bool> extended,
@@ -104,12 +198,19 @@ Replicaset_status::Replicaset_status(
 Replicaset_status::~Replicaset_status() {}
 
 void Replicaset_status::prepare() {
-  // Verify if the topology type changed and issue an error if needed.
-  m_replicaset->sanity_check();
+  {
+    mysqlshdk::utils::Profile_stage stage("Checking topology");
+    // Verify if the topology type changed and issue an error if needed.
+    m_replicaset->sanity_check();
+  }
 
-  m_instances = m_replicaset->get_instances();
+  {
+    mysqlshdk::utils::Profile_stage stage("Reading instances");
+    m_instances = m_replicaset->get_instances();
+  }
 
   if (!m_query_members.is_null() && *m_query_members) {
+    mysqlshdk::utils::Profile_stage stage("Connecting to members");
     connect_to_members();
   }
 }
@@ -120,21 +221,50 @@ void Replicaset_status::connect_to_members() {
   mysqlshdk::db::Connection_options group_session_copts(
       group_session->get_connection_options());
 
+  std::vector<std::string> endpoints;
+  std::vector<mysqlshdk::db::Connection_options> member_copts;
+
   for (const auto &inst : m_instances) {
     mysqlshdk::db::Connection_options opts(inst.classic_endpoint);
     if (opts.uri_endpoint() == group_session_copts.uri_endpoint()) {
       m_member_sessions[inst.classic_endpoint] = group_session;
     } else {
       opts.set_login_options_from(group_session_copts);
-
-      try {
-        m_member_sessions[inst.classic_endpoint] =
-            mysqlshdk::db::mysql::open_session(opts);
-      } catch (mysqlshdk::db::Error &e) {
-        m_member_connect_errors[inst.classic_endpoint] = e.format();
+      if (!opts.has(mysqlshdk::db::kConnectTimeout)) {
+        opts.set(mysqlshdk::db::kConnectTimeout,
+                 {std::to_string(k_member_connect_timeout)});
       }
+      endpoints.push_back(inst.classic_endpoint);
+      member_copts.push_back(opts);
+    }
+  }
+
+  // All the members are contacted at the same time, so the members which are
+  // not reachable cost a single connect timeout in total, not one each.
+  std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions(
+      member_copts.size());
+
+  const auto errors = detail::run_for_each_member(
+      member_copts.size(), k_max_member_threads,
+      [&sessions, &member_copts](size_t i) {
+        auto session = mysqlshdk::db::mysql::Session::create();
+        session->set_net_timeout(k_member_net_timeout);
+        session->connect(member_copts[i]);
+        sessions[i] = session;
+      });
+
+  for (size_t i = 0; i < endpoints.size(); i++) {
+    if (errors[i]) {
+      m_member_connect_errors[endpoints[i]] = error_message(errors[i]);
+    } else {
+      m_member_sessions[endpoints[i]] = sessions[i];
     }
   }
+
+  for (const auto &error : m_member_connect_errors) {
+    log_info("DBA: Could not connect to '%s': %s", error.first.c_str(),
+             error.second.c_str());
+  }
 }
 
 shcore::Dictionary_t Replicaset_status::check_group_status(
@@ -416,26 +546,9 @@ void Replicaset_status::collect_local_status(
     sql += TSDIFF_NOW("APPLYING_TRANSACTION", "IMMEDIATE_COMMIT_TIMESTAMP");
     sql += " AS CURRENT_IMMEDIATE_COMMIT_TO_NOW_TIME";
   }
-  sql += " FROM performance_schema.replication_applier_status_by_worker";
+  sql += " FROM performance_schema.replication_applier_status_by_worker;";
 
-  // this can return multiple rows per channel for
-  // multi-threaded applier, otherwise just one. If MT, we also
-  // get stuff in the coordinator table
-  auto result = session->query(sql);
-  auto row = result->fetch_one_named();
-  while (row) {
-    std::string channel_name = row.get_string("CHANNEL_NAME");
-    if (channel_name == "group_replication_recovery") {
-      recovery_workers->push_back(applier_status(row));
-    }
-    if (channel_name == "group_replication_applier" &&
-        row.get_string("SERVICE_STATE") != "OFF") {
-      applier_workers->push_back(applier_status(row));
-    }
-    row = result->fetch_one_named();
-  }
-
-  sql = "SELECT *";
+  sql += "SELECT *";
   if (version >= Version(8, 0, 0)) {
     sql += ",";
     sql += TSDIFF("LAST_PROCESSED_TRANSACTION", "ORIGINAL_COMMIT_TIMESTAMP",
@@ -453,22 +566,9 @@ void Replicaset_status::collect_local_status(
     sql += TSDIFF_NOW("PROCESSING_TRANSACTION", "IMMEDIATE_COMMIT_TIMESTAMP");
     sql += " AS CURRENT_IMMEDIATE_COMMIT_TO_NOW_TIME";
   }
-  sql += " FROM performance_schema.replication_applier_status_by_coordinator";
-  result = session->query(sql);
-  row = result->fetch_one_named();
-  while (row) {
-    std::string channel_name = row.get_string("CHANNEL_NAME");
-    if (channel_name == "group_replication_recovery") {
-      (*recovery_node)["coordinator"] = coordinator_status(row);
-    }
-    if (channel_name == "group_replication_applier" &&
-        row.get_string("SERVICE_STATE") != "OFF") {
-      (*applier_node)["coordinator"] = coordinator_status(row);
-    }
-    row = result->fetch_one_named();
-  }
+  sql += " FROM performance_schema.replication_applier_status_by_coordinator;";
 
-  sql = "SELECT *";
+  sql += "SELECT *";
   if (version >= Version(8, 0, 0)) {
     sql += ",";
     sql += TSDIFF("LAST_QUEUED_TRANSACTION", "ORIGINAL_COMMIT_TIMESTAMP",
@@ -487,7 +587,43 @@ void Replicaset_status::collect_local_status(
     sql += " AS CURRENT_IMMEDIATE_COMMIT_TO_NOW_TIME";
   }
   sql += " FROM performance_schema.replication_connection_status";
-  result = session->query(sql);
+
+  // the three tables are read in a single round trip, the rows of each one
+  // are buffered in its own result
+  const auto results = detail::query_batch(session, sql);
+
+  // this can return multiple rows per channel for
+  // multi-threaded applier, otherwise just one. If MT, we also
+  // get stuff in the coordinator table
+  auto result = results.at(0);
+  auto row = result->fetch_one_named();
+  while (row) {
+    std::string channel_name = row.get_string("CHANNEL_NAME");
+    if (channel_name == "group_replication_recovery") {
+      recovery_workers->push_back(applier_status(row));
+    }
+    if (channel_name == "group_replication_applier" &&
+        row.get_string("SERVICE_STATE") != "OFF") {
+      applier_workers->push_back(applier_status(row));
+    }
+    row = result->fetch_one_named();
+  }
+
+  result = results.at(1);
+  row = result->fetch_one_named();
+  while (row) {
+    std::string channel_name = row.get_string("CHANNEL_NAME");
+    if (channel_name == "group_replication_recovery") {
+      (*recovery_node)["coordinator"] = coordinator_status(row);
+    }
+    if (channel_name == "group_replication_applier" &&
+        row.get_string("SERVICE_STATE") != "OFF") {
+      (*applier_node)["coordinator"] = coordinator_status(row);
+    }
+    row = result->fetch_one_named();
+  }
+
+  result = results.at(2);
   row = result->fetch_one_named();
   while (row) {
     std::string channel_name = row.get_string("CHANNEL_NAME");
@@ -500,7 +636,6 @@ void Replicaset_status::collect_local_status(
     }
     row = result->fetch_one_named();
   }
-
   if (!applier_workers->empty())
     (*applier_node)["workers"] = shcore::Value(applier_workers);
   if (!recovery_workers->empty() && recovering)
@@ -555,7 +690,11 @@ void Replicaset_status::feed_member_stats(
 shcore::Dictionary_t Replicaset_status::get_topology(
     const std::vector<mysqlshdk::gr::Member> &member_info,
     const mysqlshdk::mysql::Instance *primary_instance) {
-  Member_stats_map member_stats = query_member_stats();
+  Member_stats_map member_stats;
+  {
+    mysqlshdk::utils::Profile_stage stage("Reading member stats");
+    member_stats = query_member_stats();
+  }
 
   shcore::Dictionary_t dict = shcore::make_dict();
 
@@ -566,24 +705,67 @@ shcore::Dictionary_t Replicaset_status::get_topology(
     return mysqlshdk::gr::Member();
   };
 
-  for (const auto &inst : m_instances) {
-    shcore::Dictionary_t member = shcore::make_dict();
-    mysqlshdk::gr::Member minfo(get_member(inst.uuid));
+  std::vector<shcore::Dictionary_t> members;
+  for (size_t i = 0; i < m_instances.size(); i++)
+    members.push_back(shcore::make_dict());
 
-    if (!m_query_members.is_null() && *m_query_members) {
-      mysqlshdk::mysql::Instance instance(
-          m_member_sessions[inst.classic_endpoint]);
+  if (!m_query_members.is_null() && *m_query_members) {
+    mysqlshdk::utils::Profile_stage stage("Querying members");
+    auto group_session = m_replicaset->get_cluster()->get_group_session();
 
-      if (instance.get_session()) {
-        collect_local_status(
-            member, instance,
-            minfo.state == mysqlshdk::gr::Member_state::RECOVERING);
-      } else {
-        (*member)["shellConnectError"] =
+    // Each member has its own session, so their status is queried
+    // concurrently. The group session is used by the rest of the command, so
+    // the member it is connected to is queried by this thread.
+    std::vector<size_t> remote;
+
+    for (size_t i = 0; i < m_instances.size(); i++) {
+      const auto &inst = m_instances[i];
+      const auto session = m_member_sessions[inst.classic_endpoint];
+
+      if (!session) {
+        (*members[i])["shellConnectError"] =
             shcore::Value(m_member_connect_errors[inst.classic_endpoint]);
+      } else if (session == group_session) {
+        collect_local_status(members[i], mysqlshdk::mysql::Instance(session),
+                             get_member(inst.uuid).state ==
+                                 mysqlshdk::gr::Member_state::RECOVERING);
+      } else {
+        remote.push_back(i);
       }
     }
 
+    const auto errors = detail::run_for_each_member(
+        remote.size(), k_max_member_threads,
+        [this, &remote, &members, &get_member](size_t q) {
+          mysqlshdk::utils::Profile_stage member_stage("Querying member");
+          const auto &inst = m_instances[remote[q]];
+          collect_local_status(
+              members[remote[q]],
+              mysqlshdk::mysql::Instance(
+                  m_member_sessions.at(inst.classic_endpoint)),
+              get_member(inst.uuid).state ==
+                  mysqlshdk::gr::Member_state::RECOVERING);
+        });
+
+    for (size_t q = 0; q < remote.size(); q++) {
+      if (!errors[q]) continue;
+
+      // the status of this member is not known, the others are reported
+      const auto &inst = m_instances[remote[q]];
+      const auto error = error_message(errors[q]);
+      m_member_sessions.erase(inst.classic_endpoint);
+      members[remote[q]] = shcore::make_dict();
+      (*members[remote[q]])["shellConnectError"] = shcore::Value(error);
+      log_info("DBA: Could not query '%s': %s", inst.classic_endpoint.c_str(),
+               error.c_str());
+    }
+  }
+
+  for (size_t i = 0; i < m_instances.size(); i++) {
+    const auto &inst = m_instances[i];
+    shcore::Dictionary_t member = members[i];
+    mysqlshdk::gr::Member minfo(get_member(inst.uuid));
+
     feed_metadata_info(member, inst);
     feed_member_info(member, minfo);
 
@@ -652,10 +834,13 @@ shcore::Dictionary_t Replicaset_status::collect_replicaset_status() {
     (*ret)["ssl"] = shcore::Value::Null();
 
   bool single_primary;
-  std::vector<mysqlshdk::gr::Member> member_info(
-      mysqlshdk::gr::get_members(group_instance, &single_primary));
+  std::vector<mysqlshdk::gr::Member> member_info;
+  {
+    mysqlshdk::utils::Profile_stage stage("Reading group members");
+    member_info = mysqlshdk::gr::get_members(group_instance, &single_primary);
+    tmp = check_group_status(group_instance, member_info);
+  }
 
-  tmp = check_group_status(group_instance, member_info);
   (*ret)["statusText"] = shcore::Value(tmp->get_string("statusText"));
   (*ret)["status"] = shcore::Value(tmp->get_string("status"));
 
@@ -695,7 +880,10 @@ shcore::Value Replicaset_status::execute() {
   // Get the ReplicaSet status
   shcore::Dictionary_t replicaset_dict;
 
-  replicaset_dict = collect_replicaset_status();
+  {
+    mysqlshdk::utils::Profile_stage stage("Collecting status");
+    replicaset_dict = collect_replicaset_status();
+  }
 
   return shcore::Value(replicaset_dict);
 }
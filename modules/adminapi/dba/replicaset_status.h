@@ -24,7 +24,10 @@
 #ifndef MODULES_ADMINAPI_DBA_REPLICASET_STATUS_H_
 #define MODULES_ADMINAPI_DBA_REPLICASET_STATUS_H_
 
+#include <exception>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -36,6 +39,36 @@
 namespace mysqlsh {
 namespace dba {
 
+namespace detail {
+
+/**
+ * Calls func(i) for every i in [0, count) using at most max_threads threads,
+ * and waits until all the calls complete.
+ *
+ * func has to bound the time it takes, i.e. with the connect and read
+ * timeouts of the sessions it uses. func should not log, the caller reports
+ * the outcome once this returns.
+ *
+ * @returns the exception thrown by the call for each index, if any.
+ */
+std::vector<std::exception_ptr> run_for_each_member(
+    size_t count, size_t max_threads, const std::function<void(size_t)> &func);
+
+/**
+ * Executes the statements separated by ';' in sql and returns the result of
+ * each one, with its rows buffered.
+ *
+ * Classic sessions send all of them in a single round trip, multiple
+ * statements are enabled only while the batch is executed, so the group and
+ * member sessions keep rejecting stacked statements afterwards. Other sessions
+ * execute them one by one.
+ */
+std::vector<std::shared_ptr<mysqlshdk::db::IResult>> query_batch(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const std::string &sql);
+
+}  // namespace detail
+
 typedef std::map<std::string, std::pair<mysqlshdk::db::Row_by_name,
                                         mysqlshdk::db::Row_by_name>>
     Member_stats_map;
@@ -116,15 +149,18 @@ class Replicaset_status : public Command_interface {
       const mysqlshdk::db::Row_ref_by_name &row, const std::string &prefix,
       const std::string &what);
 
-  shcore::Value connection_status(const mysqlshdk::db::Row_ref_by_name &row);
+  static shcore::Value connection_status(
+      const mysqlshdk::db::Row_ref_by_name &row);
 
-  shcore::Value coordinator_status(const mysqlshdk::db::Row_ref_by_name &row);
+  static shcore::Value coordinator_status(
+      const mysqlshdk::db::Row_ref_by_name &row);
 
-  shcore::Value applier_status(const mysqlshdk::db::Row_ref_by_name &row);
+  static shcore::Value applier_status(
+      const mysqlshdk::db::Row_ref_by_name &row);
 
-  void collect_local_status(shcore::Dictionary_t dict,
-                            const mysqlshdk::mysql::Instance &instance,
-                            bool recovering);
+  static void collect_local_status(shcore::Dictionary_t dict,
+                                   const mysqlshdk::mysql::Instance &instance,
+                                   bool recovering);
 
   void feed_metadata_info(shcore::Dictionary_t dict,
                           const ReplicaSet::Instance_info &info);
@@ -55,6 +55,7 @@
 #include "mysqlshdk/libs/mysql/group_replication.h"
 #include "mysqlshdk/libs/mysql/instance.h"
 #include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 
@@ -1655,6 +1656,7 @@ shcore::Value Dba::check_instance_configuration(
   check_preconditions(instance_session, "checkInstanceConfiguration");
 
   try {
+    mysqlshdk::utils::Profile_stage stage("Checking instance");
     // Create the Instance object with the established session
     mysqlshdk::mysql::Instance target_instance(instance_session);
 
@@ -2318,6 +2320,7 @@ shcore::Value Dba::do_configure_instance(const shcore::Argument_list &args,
           &target_instance, mycnf_path, output_mycnf_path, cluster_admin,
           cluster_admin_password, clear_read_only, interactive, restart));
 
+    mysqlshdk::utils::Profile_stage stage("Configuring instance");
     op_configure_instance->prepare();
     ret_val = shcore::Value(op_configure_instance->execute());
     op_configure_instance->finish();
@@ -33,6 +33,7 @@
 #include "modules/adminapi/dba/cluster_options.h"
 #include "modules/adminapi/dba/cluster_set_option.h"
 #include "modules/adminapi/dba/cluster_status.h"
+#include "modules/adminapi/dba/cluster_watch.h"
 #include "modules/adminapi/dba/remove_instance.h"
 #include "modules/adminapi/mod_dba_common.h"
 #include "modules/adminapi/mod_dba_metadata_storage.h"
@@ -42,6 +43,7 @@
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/libs/mysql/group_replication.h"
 #include "mysqlshdk/libs/mysql/replication.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 #include "shellcore/utils_help.h"
 #include "utils/debug.h"
 #include "utils/utils_general.h"
@@ -115,6 +117,7 @@ void Cluster::init() {
              "data");
   add_method("describe", std::bind(&Cluster::describe, this, _1));
   add_method("status", std::bind(&Cluster::status, this, _1));
+  expose("watch", &Cluster::watch, "?interval", 2.0);
   add_varargs_method("dissolve", std::bind(&Cluster::dissolve, this, _1));
 
   expose<shcore::Value, const std::string &, Cluster>(
@@ -584,6 +587,7 @@ shcore::Value Cluster::add_instance(const shcore::Argument_list &args) {
   shcore::Value ret_val;
   try {
     check_preconditions("addInstance");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     // Check if we have a Default ReplicaSet
     if (!_default_replica_set)
@@ -790,6 +794,7 @@ shcore::Value Cluster::rejoin_instance(const shcore::Argument_list &args) {
   shcore::Value ret_val;
   try {
     check_preconditions("rejoinInstance");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     // Check if we have a Default ReplicaSet
     if (!_default_replica_set)
@@ -948,6 +953,7 @@ shcore::Value Cluster::remove_instance(const shcore::Argument_list &args) {
   // Remove the Instance from the Default ReplicaSet
   try {
     check_preconditions("removeInstance");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     // Check if we have a Default ReplicaSet
     if (!_default_replica_set)
@@ -1105,6 +1111,7 @@ shcore::Value Cluster::describe(const shcore::Argument_list &args) {
   shcore::Value ret_val;
   try {
     auto state = check_preconditions("describe");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     bool warning = (state.source_state != ManagedInstance::OnlineRW &&
                     state.source_state != ManagedInstance::OnlineRO);
@@ -1166,6 +1173,9 @@ REGISTER_HELP(
     CLUSTER_STATUS_DETAIL2,
     "@li queryMembers: if true, connect to each Instance of the ReplicaSets to "
     "query for more detailed stats about the replication machinery.");
+REGISTER_HELP(CLUSTER_STATUS_DETAIL3,
+              "To monitor the membership of the cluster, use <<<watch>>>() "
+              "instead of calling this function repeatedly.");
 
 /**
  * $(CLUSTER_STATUS_BRIEF)
@@ -1182,6 +1192,8 @@ REGISTER_HELP(
  *
  * $(CLUSTER_STATUS_DETAIL1)
  * $(CLUSTER_STATUS_DETAIL2)
+ *
+ * $(CLUSTER_STATUS_DETAIL3)
  */
 #if DOXYGEN_JS
 String Cluster::status(Dictionary options) {}
@@ -1208,7 +1220,9 @@ shcore::Value Cluster::status(const shcore::Argument_list &args) {
 
   shcore::Value ret_val;
   try {
+    mysqlshdk::utils::Profile_stage stage("Cluster status");
     auto state = check_preconditions("status");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     bool warning = (state.source_state != ManagedInstance::OnlineRW &&
                     state.source_state != ManagedInstance::OnlineRO);
@@ -1238,6 +1252,75 @@ shcore::Value Cluster::status(const shcore::Argument_list &args) {
   return ret_val;
 }
 
+REGISTER_HELP_FUNCTION(watch, Cluster);
+REGISTER_HELP(CLUSTER_WATCH_BRIEF,
+              "Monitors the membership of the cluster, printing the changes.");
+REGISTER_HELP(CLUSTER_WATCH_PARAM,
+              "@param interval Optional number of seconds between checks, 2 by "
+              "default, at least 0.5.");
+
+REGISTER_HELP(CLUSTER_WATCH_THROWS,
+              "MetadataError in the following scenarios:");
+REGISTER_HELP(CLUSTER_WATCH_THROWS1, "@li If the Metadata is inaccessible.");
+REGISTER_HELP(CLUSTER_WATCH_THROWS2,
+              "ArgumentError in the following scenarios:");
+REGISTER_HELP(CLUSTER_WATCH_THROWS3,
+              "@li If the interval is not greater than 0.");
+
+REGISTER_HELP(CLUSTER_WATCH_RETURNS, "@returns Nothing.");
+
+REGISTER_HELP(CLUSTER_WATCH_DETAIL,
+              "This function prints the state and role of every member of the "
+              "cluster, then checks them again every interval seconds and "
+              "prints only the members which joined, left or changed, until "
+              "interrupted with Ctrl+C.");
+REGISTER_HELP(CLUSTER_WATCH_DETAIL1,
+              "The Metadata is read only once. Each check is a single query to "
+              "performance_schema.replication_group_members on one member, "
+              "using sessions which are kept open while watching. If that "
+              "member cannot be reached or is no longer in the group, the "
+              "other members are queried instead.");
+
+/**
+ * $(CLUSTER_WATCH_BRIEF)
+ *
+ * $(CLUSTER_WATCH_PARAM)
+ *
+ * $(CLUSTER_WATCH_THROWS)
+ * $(CLUSTER_WATCH_THROWS1)
+ *
+ * $(CLUSTER_WATCH_THROWS2)
+ * $(CLUSTER_WATCH_THROWS3)
+ *
+ * $(CLUSTER_WATCH_RETURNS)
+ *
+ * $(CLUSTER_WATCH_DETAIL)
+ *
+ * $(CLUSTER_WATCH_DETAIL1)
+ */
+#if DOXYGEN_JS
+Undefined Cluster::watch(Float interval) {}
+#elif DOXYGEN_PY
+None Cluster::watch(float interval) {}
+#endif
+void Cluster::watch(double interval) {
+  // Throw an error if the cluster has already been dissolved
+  assert_valid("watch");
+  check_preconditions("watch");
+
+  // The metadata is read once, changes to it are not tracked while watching
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
+
+  // Create the Cluster_watch command and execute it.
+  Cluster_watch op_watch(this, interval);
+  // Always execute finish when leaving scope.
+  auto finally = shcore::on_leave_scope([&op_watch]() { op_watch.finish(); });
+  // Prepare the Cluster_watch command execution (validations).
+  op_watch.prepare();
+  // Execute Cluster_watch operations.
+  op_watch.execute();
+}
+
 REGISTER_HELP_FUNCTION(options, Cluster);
 REGISTER_HELP(CLUSTER_OPTIONS_BRIEF,
               "Lists the cluster configuration options.");
@@ -1286,6 +1369,7 @@ shcore::Value Cluster::options(const shcore::Dictionary_t &options) {
   // Throw an error if the cluster has already been dissolved
   assert_valid("options");
   auto state = check_preconditions("options");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   bool all = false;
   // Retrieves optional options
@@ -1513,6 +1597,7 @@ void Cluster::rescan(const shcore::Dictionary_t &options) {
   assert_valid("rescan");
 
   check_preconditions("rescan");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   if (!_default_replica_set)
     throw shcore::Exception::logic_error("ReplicaSet not initialized.");
@@ -1698,6 +1783,7 @@ shcore::Value Cluster::force_quorum_using_partition_of(
   shcore::Value ret_val;
   try {
     check_preconditions("forceQuorumUsingPartitionOf");
+    MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
     // Check if we have a Default ReplicaSet
     if (!_default_replica_set)
@@ -1843,6 +1929,7 @@ shcore::Value Cluster::check_instance_state(
     const Connection_options &instance_def) {
   assert_valid("checkInstanceState");
   check_preconditions("checkInstanceState");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Check if we have a Default ReplicaSet
   if (!_default_replica_set)
@@ -1941,6 +2028,7 @@ void Cluster::switch_to_single_primary_mode(
     const Connection_options &instance_def) {
   assert_valid("switchToSinglePrimaryMode");
   check_preconditions("switchToSinglePrimaryMode");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Check if we have a Default ReplicaSet
   if (!_default_replica_set)
@@ -1992,6 +2080,7 @@ None Cluster::switch_to_multi_primary_mode() {}
 void Cluster::switch_to_multi_primary_mode(void) {
   assert_valid("switchToMultiPrimaryMode");
   check_preconditions("switchToMultiPrimaryMode");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Switch to single-primary mode
 
@@ -2079,6 +2168,7 @@ None Cluster::set_primary_instance(InstanceDef instance) {}
 void Cluster::set_primary_instance(const Connection_options &instance_def) {
   assert_valid("setPrimaryInstance");
   check_preconditions("setPrimaryInstance");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Set primary instance
 
@@ -2216,6 +2306,7 @@ void Cluster::set_option(const std::string &option,
                          const shcore::Value &value) {
   assert_valid("setOption");
   check_preconditions("setOption");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Check if we have a Default ReplicaSet
   if (!_default_replica_set)
@@ -2379,6 +2470,7 @@ void Cluster::set_instance_option(const Connection_options &instance_def,
                                   const shcore::Value &value) {
   assert_valid("setInstanceOption");
   check_preconditions("setInstanceOption");
+  MetadataStorage::Snapshot md_snapshot(_metadata_storage);
 
   // Check if we have a Default ReplicaSet
   if (!_default_replica_set)
@@ -72,6 +72,7 @@ class Cluster : public std::enable_shared_from_this<Cluster>,
   Undefined setOption(String option, String value);
   Undefined setInstanceOption(InstanceDef instance, String option,
                               String value);
+  Undefined watch(Float interval);
 #elif DOXYGEN_PY
   str name;  //!< $(CLUSTER_GETNAME_BRIEF)
   None add_instance(InstanceDef instance, dict options);
@@ -91,6 +92,7 @@ class Cluster : public std::enable_shared_from_this<Cluster>,
   str options(dict options);
   None set_option(str option, str value);
   None set_instance_option(InstanceDef instance, str option, str value);
+  None watch(float interval);
 #endif
 
   Cluster(const std::string &name,
@@ -169,6 +171,7 @@ class Cluster : public std::enable_shared_from_this<Cluster>,
   shcore::Value get_replicaset(const shcore::Argument_list &args);
   shcore::Value describe(const shcore::Argument_list &args);
   shcore::Value status(const shcore::Argument_list &args);
+  void watch(double interval);
   shcore::Value dissolve(const shcore::Argument_list &args);
   shcore::Value check_instance_state(const std::string &instance_def);
   shcore::Value check_instance_state(const shcore::Dictionary_t &instance_def);
@@ -23,6 +23,8 @@
 
 #include "modules/adminapi/mod_dba_metadata_storage.h"
 
+#include <mysqld_error.h>
+#include <algorithm>
 #include <random>
 
 #include "db/mysqlx/mysqlxclient_clean.h"
@@ -43,9 +45,11 @@ using namespace mysqlsh;
 using namespace mysqlsh::dba;
 using namespace shcore;
 
+std::atomic<uint64_t> MetadataStorage::s_generation(0);
+
 MetadataStorage::MetadataStorage(
     std::shared_ptr<mysqlshdk::db::ISession> session)
-    : _session(session), _tx_deep(0) {
+    : _session(session), _tx_deep(0), _snapshot_deep(0) {
   _metadata_mysql = mysqlshdk::innodbcluster::Metadata_mysql::create(session);
 }
 
@@ -63,6 +67,13 @@ std::shared_ptr<mysqlshdk::db::IResult> MetadataStorage::execute_sql(
   if (!_session)
     throw Exception::metadata_error("The Metadata is inaccessible");
 
+  // anything other than a read may change the metadata
+  if (!shcore::str_ibeginswith(shcore::str_strip(sql), "select") &&
+      !shcore::str_ibeginswith(shcore::str_strip(sql), "show")) {
+    ++s_generation;
+    _snapshot.reset();
+  }
+
   int retry_count = kMaxReadOnlyRetries;
   while (retry_count > 0) {
     try {
@@ -119,7 +130,103 @@ void MetadataStorage::rollback() {
   // TODO(rennox): I think this is wrong, I thing rollback should be executed
   // whenever it is called, and it should actually set _tx_deep to 0.
   // I just put the logic as it was in the past, but needs to be reviewed
-  if (_tx_deep == 0) _session->execute("rollback");
+  if (_tx_deep == 0) {
+    ++s_generation;
+    _snapshot.reset();
+    _session->execute("rollback");
+  }
+}
+
+void MetadataStorage::begin_snapshot() {
+  if (_snapshot_deep++ == 0 && _session && _session->is_open()) {
+    try {
+      // read everything up front, instead of on the first lookup
+      snapshot();
+    } catch (...) {
+      _snapshot_deep--;
+      throw;
+    }
+  }
+}
+
+void MetadataStorage::end_snapshot() {
+  _snapshot_deep--;
+
+  assert(_snapshot_deep >= 0);
+
+  if (_snapshot_deep == 0) _snapshot.reset();
+}
+
+const MetadataStorage::Snapshot_data *MetadataStorage::snapshot() const {
+  if (_snapshot_deep == 0) return nullptr;
+
+  // the metadata was changed through another object
+  if (_snapshot && _snapshot->generation != s_generation) _snapshot.reset();
+
+  if (!_snapshot) {
+    static constexpr const char *k_snapshot_query =
+        "SELECT c.cluster_id, c.cluster_name, r.replicaset_id, r.active, "
+        "r.topology_type, i.host_id, i.mysql_server_uuid, i.instance_name, "
+        "i.role, "
+        "JSON_UNQUOTE(JSON_EXTRACT(i.addresses, '$.mysqlClassic')), "
+        "JSON_UNQUOTE(JSON_EXTRACT(i.addresses, '$.mysqlX')), "
+        "JSON_UNQUOTE(JSON_EXTRACT(i.addresses, '$.grLocal')) "
+        "FROM mysql_innodb_cluster_metadata.clusters c "
+        "LEFT JOIN mysql_innodb_cluster_metadata.replicasets r "
+        "ON r.cluster_id = c.cluster_id "
+        "LEFT JOIN mysql_innodb_cluster_metadata.instances i "
+        "ON i.replicaset_id = r.replicaset_id "
+        "ORDER BY c.cluster_id, r.replicaset_id, i.instance_id";
+
+    std::shared_ptr<mysqlshdk::db::IResult> result;
+    const uint64_t generation = s_generation;
+
+    try {
+      result = execute_sql(k_snapshot_query);
+    } catch (const shcore::Exception &e) {
+      // the metadata schema does not exist (yet), every lookup is going to
+      // query the server
+      if (e.code() == ER_BAD_DB_ERROR || e.code() == ER_NO_SUCH_TABLE)
+        return nullptr;
+      throw;
+    }
+
+    auto data = shcore::make_unique<Snapshot_data>();
+    data->generation = generation;
+
+    while (auto row = result->fetch_one()) {
+      data->clusters.emplace(row->get_string(1), row->get_uint(0));
+
+      if (row->is_null(2)) continue;
+
+      auto rs_id = row->get_uint(2);
+      Snapshot_data::Replicaset rs;
+      rs.cluster_id = row->get_uint(0);
+      rs.active = !row->is_null(3) && row->get_int(3) == 1;
+      rs.topology_type = row->is_null(4) ? "" : row->get_string(4);
+      data->replicasets.emplace(rs_id, std::move(rs));
+
+      if (row->is_null(6)) continue;
+
+      Instance_definition instance;
+      instance.host_id = row->is_null(5) ? 0 : row->get_uint(5);
+      instance.replicaset_id = rs_id;
+      instance.uuid = row->get_string(6);
+      instance.label = row->get_string(7);
+      instance.role = row->get_string(8);
+      instance.endpoint = row->is_null(9) ? "" : row->get_string(9);
+      instance.xendpoint = row->is_null(10) ? "" : row->get_string(10);
+      instance.grendpoint = row->is_null(11) ? "" : row->get_string(11);
+      data->instances.emplace_back(std::move(instance));
+    }
+
+    log_debug("DBA: Metadata snapshot has %zu cluster(s), %zu instance(s)",
+              data->clusters.size(), data->instances.size());
+
+    _snapshot = std::move(data);
+  }
+
+  return _snapshot.get();
 }
 
 bool MetadataStorage::metadata_schema_exists() {
@@ -127,6 +234,9 @@ bool MetadataStorage::metadata_schema_exists() {
   std::string schema = "mysql_innodb_cluster_metadata";
 
   if (_session && _session->is_open()) {
+    // snapshot can only be read if the metadata exists
+    if (snapshot()) return true;
+
     std::string statement = sqlstring("show databases like ?", 0) << schema;
 
     auto result = _session->query(statement);
@@ -171,6 +281,11 @@ uint64_t MetadataStorage::get_cluster_id(const std::string &cluster_name) {
   if (!metadata_schema_exists())
     throw Exception::metadata_error("Metadata Schema does not exist.");
 
+  if (auto md = snapshot()) {
+    auto cluster = md->clusters.find(cluster_name);
+    return cluster == md->clusters.end() ? 0 : cluster->second;
+  }
+
   // Get the Cluster ID
   query = shcore::sqlstring(
       "SELECT cluster_id from mysql_innodb_cluster_metadata.clusters "
@@ -192,6 +307,11 @@ uint64_t MetadataStorage::get_cluster_id(uint64_t rs_id) {
   if (!metadata_schema_exists())
     throw Exception::metadata_error("Metadata Schema does not exist.");
 
+  if (auto md = snapshot()) {
+    auto rs = md->replicasets.find(rs_id);
+    return rs == md->replicasets.end() ? 0 : rs->second.cluster_id;
+  }
+
   // Get the Cluster ID
   query = shcore::sqlstring(
       "SELECT cluster_id from mysql_innodb_cluster_metadata.replicasets "
@@ -605,6 +725,11 @@ bool MetadataStorage::is_replicaset_active(uint64_t rs_id) {
   if (!metadata_schema_exists())
     throw Exception::metadata_error("Metadata Schema does not exist.");
 
+  if (auto md = snapshot()) {
+    auto rs = md->replicasets.find(rs_id);
+    return rs != md->replicasets.end() && rs->second.active;
+  }
+
   query = shcore::sqlstring(
       "SELECT active FROM mysql_innodb_cluster_metadata.replicasets WHERE "
       "replicaset_id = ?",
@@ -782,6 +907,8 @@ bool MetadataStorage::has_default_cluster() {
 bool MetadataStorage::is_replicaset_empty(uint64_t rs_id) {
   shcore::sqlstring query;
 
+  if (snapshot()) return get_replicaset_count(rs_id) == 0;
+
   query = shcore::sqlstring(
       "SELECT COUNT(*) as count FROM mysql_innodb_cluster_metadata.instances "
       "WHERE replicaset_id = ?",
@@ -810,6 +937,14 @@ bool MetadataStorage::is_replicaset_empty(uint64_t rs_id) {
 uint64_t MetadataStorage::get_replicaset_count(uint64_t rs_id) const {
   shcore::sqlstring query;
 
+  if (auto md = snapshot()) {
+    return std::count_if(md->instances.begin(), md->instances.end(),
+                         [rs_id](const Instance_definition &i) {
+                           return static_cast<uint64_t>(i.replicaset_id) ==
+                                  rs_id;
+                         });
+  }
+
   query = shcore::sqlstring(
       "SELECT COUNT(*) as count "
       "FROM mysql_innodb_cluster_metadata.instances "
@@ -832,6 +967,15 @@ bool MetadataStorage::is_instance_on_replicaset(uint64_t rs_id,
                                                 const std::string &address) {
   shcore::sqlstring query;
 
+  if (auto md = snapshot()) {
+    return std::count_if(md->instances.begin(), md->instances.end(),
+                         [rs_id, &address](const Instance_definition &i) {
+                           return static_cast<uint64_t>(i.replicaset_id) ==
+                                      rs_id &&
+                                  i.endpoint == address;
+                         }) == 1;
+  }
+
   query = shcore::sqlstring(
       "SELECT COUNT(*) as count FROM mysql_innodb_cluster_metadata.instances "
       "WHERE replicaset_id = ? AND addresses->'$.mysqlClassic' = ?",
@@ -852,6 +996,15 @@ bool MetadataStorage::is_instance_on_replicaset(uint64_t rs_id,
 
 bool MetadataStorage::is_instance_label_unique(uint64_t rs_id,
                                                const std::string &label) const {
+  if (auto md = snapshot()) {
+    return std::none_of(md->instances.begin(), md->instances.end(),
+                        [rs_id, &label](const Instance_definition &i) {
+                          return static_cast<uint64_t>(i.replicaset_id) ==
+                                     rs_id &&
+                                 i.label == label;
+                        });
+  }
+
   shcore::sqlstring query = shcore::sqlstring{
       "SELECT COUNT(*) as count FROM mysql_innodb_cluster_metadata.instances "
       "WHERE replicaset_id = ? AND instance_name = ?",
@@ -926,6 +1079,18 @@ std::vector<Instance_definition> MetadataStorage::get_replicaset_instances(
   std::string statement;
   shcore::sqlstring query;
 
+  // the state of the members is not part of the metadata
+  if (!with_state && states.empty() && !alt_session) {
+    if (auto md = snapshot()) {
+      for (const auto &i : md->instances) {
+        if (static_cast<uint64_t>(i.replicaset_id) == rs_id) {
+          ret_val.push_back(i);
+        }
+      }
+      return ret_val;
+    }
+  }
+
   statement =
       "select mysql_server_uuid, instance_name, role, "
       "JSON_UNQUOTE(JSON_EXTRACT(addresses, '$.mysqlClassic')) as host";
@@ -1013,6 +1178,19 @@ Instance_definition MetadataStorage::get_instance(
   shcore::sqlstring query;
   Instance_definition ret_val;
 
+  if (auto md = snapshot()) {
+    auto instance = std::find_if(md->instances.begin(), md->instances.end(),
+                                 [&instance_address](
+                                     const Instance_definition &i) {
+                                   return i.endpoint == instance_address;
+                                 });
+
+    if (instance != md->instances.end()) return *instance;
+
+    throw Exception::metadata_error("The instance with the address '" +
+                                    instance_address + "' does not exist.");
+  }
+
   query = shcore::sqlstring(
       "SELECT host_id, replicaset_id, mysql_server_uuid, "
       "instance_name, role, weight, "
@@ -1053,15 +1231,22 @@ Instance_definition MetadataStorage::get_instance(
 
 mysqlshdk::gr::Topology_mode MetadataStorage::get_replicaset_topology_mode(
     uint64_t rs_id) {
-  // Execute query to obtain the topology mode from the metadata.
-  shcore::sqlstring query = shcore::sqlstring{
-      "SELECT topology_type FROM mysql_innodb_cluster_metadata.replicasets "
-      "WHERE replicaset_id = ?",
-      0};
-  query << rs_id;
-  query.done();
+  std::string topology_mode;
+  const Snapshot_data *md = snapshot();
 
-  std::string topology_mode = execute_sql(query)->fetch_one()->get_string(0);
+  if (md && md->replicasets.count(rs_id)) {
+    topology_mode = md->replicasets.at(rs_id).topology_type;
+  } else {
+    // Execute query to obtain the topology mode from the metadata.
+    shcore::sqlstring query = shcore::sqlstring{
+        "SELECT topology_type FROM mysql_innodb_cluster_metadata.replicasets "
+        "WHERE replicaset_id = ?",
+        0};
+    query << rs_id;
+    query.done();
+
+    topology_mode = execute_sql(query)->fetch_one()->get_string(0);
+  }
 
   // Convert topology mode string from metadata to enumeration value.
   if (topology_mode == "pm") {
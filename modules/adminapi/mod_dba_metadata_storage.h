@@ -32,6 +32,8 @@
  * should be redesigned and moved thre.
  */
 
+#include <atomic>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -55,7 +57,7 @@ namespace dba {
 class MetadataStorage : public std::enable_shared_from_this<MetadataStorage> {
  protected:
   // Added for minimal gmock support
-  MetadataStorage() : _tx_deep(0) {}
+  MetadataStorage() : _tx_deep(0), _snapshot_deep(0) {}
 
  public:
   MetadataStorage(const MetadataStorage &other) = delete;
@@ -179,17 +181,75 @@ class MetadataStorage : public std::enable_shared_from_this<MetadataStorage> {
     std::shared_ptr<MetadataStorage> _md;
   };
 
+  /**
+   * Caches the contents of the metadata tables for the duration of an
+   * operation.
+   *
+   * While a snapshot is alive, the clusters, replicasets and instances tables
+   * are read in a single query and the lookups that only need their contents
+   * are answered from memory. Any statement which modifies the metadata
+   * through this or any other MetadataStorage object discards the cached
+   * data, which is read again on the next lookup.
+   */
+  class Snapshot {
+   public:
+    explicit Snapshot(std::shared_ptr<MetadataStorage> md) : _md(md) {
+      md->begin_snapshot();
+    }
+
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    ~Snapshot() { _md->end_snapshot(); }
+
+   private:
+    std::shared_ptr<MetadataStorage> _md;
+  };
+
  private:
+  struct Snapshot_data {
+    struct Replicaset {
+      uint64_t cluster_id;
+      bool active;
+      std::string topology_type;
+    };
+
+    // cluster name -> cluster ID
+    std::map<std::string, uint64_t> clusters;
+    // replicaset ID -> replicaset
+    std::map<uint64_t, Replicaset> replicasets;
+    // all the instances, ordered by replicaset
+    std::vector<Instance_definition> instances;
+    // value of s_generation when the data was read
+    uint64_t generation;
+  };
+
+  // incremented whenever the metadata is changed through any MetadataStorage
+  // object, the snapshots read before that are stale
+  static std::atomic<uint64_t> s_generation;
+
   std::shared_ptr<mysqlshdk::db::ISession> _session;
   std::shared_ptr<mysqlshdk::innodbcluster::Metadata_mysql> _metadata_mysql;
   int _tx_deep;
 
+  int _snapshot_deep;
+  mutable std::unique_ptr<Snapshot_data> _snapshot;
+
   virtual void start_transaction();
   virtual void commit();
   virtual void rollback();
 
   bool get_cluster_from_query(const std::string &query,
                               std::shared_ptr<Cluster> cluster);
+
+  void begin_snapshot();
+  void end_snapshot();
+
+  /**
+   * @returns the cached metadata if a snapshot is active, reading it if it was
+   *          invalidated, or nullptr otherwise.
+   */
+  const Snapshot_data *snapshot() const;
 };
 }  // namespace dba
 }  // namespace mysqlsh
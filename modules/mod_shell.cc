@@ -31,6 +31,9 @@
 #include "modules/mod_utils.h"
 #include "modules/mysqlxtest_utils.h"
 #include "mysqlshdk/libs/db/utils_connection.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/shellcore/credential_manager.h"
 #include "shellcore/base_session.h"
 #include "shellcore/shell_notifications.h"
@@ -80,6 +83,7 @@ void Shell::init() {
   add_method("listCredentials", std::bind(&Shell::list_credentials, this, _1));
   expose("enablePager", &Shell::enable_pager);
   expose("disablePager", &Shell::disable_pager);
+  expose("profile", &Shell::profile, "?options");
 }
 
 Shell::~Shell() {}
@@ -1134,4 +1138,82 @@ None Shell::disable_pager() {}
 #endif
 void Shell::disable_pager() { current_console()->disable_global_pager(); }
 
+REGISTER_HELP_FUNCTION(profile, shell);
+REGISTER_HELP(SHELL_PROFILE_BRIEF,
+              "Prints the time spent in the stages of the shell operations.");
+REGISTER_HELP(SHELL_PROFILE_PARAM,
+              "@param options Optional dictionary with report options");
+REGISTER_HELP(SHELL_PROFILE_DETAIL,
+              "The stages are recorded while the <b>shell.options.profile</b> "
+              "option is enabled, i.e. using the --profile command line "
+              "option. This includes connecting to the server, executing "
+              "queries, receiving and printing the results, and the steps of "
+              "the AdminAPI operations.");
+REGISTER_HELP(SHELL_PROFILE_DETAIL1,
+              "The stages are printed as a tree, stages with the same path "
+              "are aggregated into a single entry, with the number of calls, "
+              "total and average time. Stages of the different threads are "
+              "added together, their total time may be greater than the "
+              "elapsed time.");
+REGISTER_HELP(SHELL_PROFILE_DETAIL2,
+              "The options dictionary supports the following options:");
+REGISTER_HELP(SHELL_PROFILE_DETAIL3,
+              "@li traceFile: string - path to a file where all the recorded "
+              "stages are written, using the Trace Event Format, which can be "
+              "loaded by the chrome://tracing tool.");
+REGISTER_HELP(SHELL_PROFILE_DETAIL4,
+              "@li reset: bool (default: false) - discards the recorded "
+              "stages after they are reported.");
+
+/**
+ * $(SHELL_PROFILE_BRIEF)
+ *
+ * $(SHELL_PROFILE_PARAM)
+ *
+ * $(SHELL_PROFILE_DETAIL)
+ *
+ * $(SHELL_PROFILE_DETAIL1)
+ *
+ * $(SHELL_PROFILE_DETAIL2)
+ * $(SHELL_PROFILE_DETAIL3)
+ * $(SHELL_PROFILE_DETAIL4)
+ */
+#if DOXYGEN_JS
+Undefined Shell::profile(Dictionary options) {}
+#elif DOXYGEN_PY
+None Shell::profile(dict options) {}
+#endif
+void Shell::profile(const shcore::Dictionary_t &options) {
+  using mysqlshdk::utils::Profiler;
+
+  std::string trace_file;
+  bool reset = false;
+
+  shcore::Option_unpacker unpacker(options);
+  unpacker.optional("traceFile", &trace_file);
+  unpacker.optional("reset", &reset);
+  unpacker.end();
+
+  const auto tree = Profiler::stage_tree();
+
+  if (tree.empty()) {
+    current_console()->println(
+        "No stages were recorded, enable the 'profile' shell option or use "
+        "the --profile command line option to record them.");
+  } else {
+    current_console()->print(tree);
+  }
+
+  if (!trace_file.empty()) {
+    const auto path = shcore::path::expand_user(trace_file);
+
+    if (!shcore::create_file(path, Profiler::chrome_trace())) {
+      throw std::runtime_error("Failed to write trace file '" + path +
+                               "': " + shcore::errno_to_string(errno));
+    }
+  }
+
+  if (reset) Profiler::reset();
+}
+
 }  // namespace mysqlsh
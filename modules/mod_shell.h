@@ -84,6 +84,7 @@ class SHCORE_PUBLIC Shell : public shcore::Cpp_object_bridge
   List listCredentials();
   Undefined enablePager();
   Undefined disablePager();
+  Undefined profile(Dictionary options);
 #elif DOXYGEN_PY
   Options options;
   dict parse_uri(str uri);
@@ -102,6 +103,7 @@ class SHCORE_PUBLIC Shell : public shcore::Cpp_object_bridge
   list list_credentials();
   None enable_pager();
   None disable_pager();
+  None profile(dict options);
 #endif
 
   shcore::Value list_credential_helpers(const shcore::Argument_list &args);
@@ -119,6 +121,7 @@ class SHCORE_PUBLIC Shell : public shcore::Cpp_object_bridge
 
   void enable_pager();
   void disable_pager();
+  void profile(const shcore::Dictionary_t &options);
 
  protected:
   void init();
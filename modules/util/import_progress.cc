@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include "modules/util/import_progress.h"
+#include <cerrno>
+#include <stdexcept>
+#include "mysqlshdk/include/scripting/types.h"
+#include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_json.h"
+
+namespace mysqlsh {
+
+Import_progress::Import_progress(const std::string &path,
+                                 const std::string &input, bool required)
+    : m_path(path),
+      m_input(input),
+      m_input_size(shcore::file_size(input)),
+      m_required(required) {}
+
+void Import_progress::load() {
+  if (!shcore::file_exists(m_path)) {
+    throw std::runtime_error("Progress file '" + m_path +
+                             "' does not exist, there is no import to be "
+                             "resumed.");
+  }
+
+  std::vector<Range> ranges;
+
+  try {
+    const auto progress = shcore::Value::parse(shcore::get_text_file(m_path));
+    const auto map = progress.as_map();
+
+    if (map->get_string("input") != m_input ||
+        map->get_uint("size") != m_input_size) {
+      throw std::runtime_error("Progress file '" + m_path +
+                               "' was written for a different input file.");
+    }
+
+    for (const auto &value : *map->get_array("ranges")) {
+      const auto range = value.as_map();
+      ranges.push_back({range->get_uint("begin"), range->get_uint("end"),
+                        range->get_uint("committed")});
+
+      if (ranges.back().committed < ranges.back().begin ||
+          ranges.back().committed > ranges.back().end ||
+          ranges.back().end > m_input_size) {
+        throw std::runtime_error("Progress file '" + m_path +
+                                 "' contains an invalid range.");
+      }
+    }
+  } catch (const std::runtime_error &) {
+    throw;
+  } catch (const std::exception &e) {
+    throw std::runtime_error("Failed to read progress file '" + m_path +
+                             "': " + e.what());
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_ranges = std::move(ranges);
+}
+
+void Import_progress::start(
+    const std::vector<std::pair<size_t, size_t>> &ranges) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  m_ranges.clear();
+
+  for (const auto &range : ranges) {
+    m_ranges.push_back({range.first, range.second, range.first});
+  }
+
+  try {
+    save();
+  } catch (const std::runtime_error &e) {
+    if (m_required) throw;
+
+    m_disabled = true;
+    mysqlsh::current_console()->print_warning(
+        std::string{e.what()} +
+        ". Progress of the import is not recorded, it cannot be resumed.");
+  }
+}
+
+std::vector<Import_progress::Range> Import_progress::ranges() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_ranges;
+}
+
+size_t Import_progress::committed_bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  size_t bytes = 0;
+
+  for (const auto &range : m_ranges) {
+    bytes += range.committed - range.begin;
+  }
+
+  return bytes;
+}
+
+void Import_progress::committed(size_t range, size_t offset) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto &target = m_ranges.at(range);
+
+  if (m_disabled || offset <= target.committed) return;
+
+  target.committed = offset;
+  save();
+}
+
+void Import_progress::remove() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  shcore::delete_file(m_path);
+}
+
+void Import_progress::save() const {
+  shcore::JSON_dumper dumper(true);
+
+  dumper.start_object();
+  dumper.append_string("input", m_input);
+  dumper.append_uint64("size", m_input_size);
+
+  dumper.append_string("ranges");
+  dumper.start_array();
+  for (const auto &range : m_ranges) {
+    dumper.start_object();
+    dumper.append_uint64("begin", range.begin);
+    dumper.append_uint64("end", range.end);
+    dumper.append_uint64("committed", range.committed);
+    dumper.end_object();
+  }
+  dumper.end_array();
+  dumper.end_object();
+
+  // file is replaced at once, so it's valid even if the shell is killed while
+  // it is being written
+  const auto tmp = m_path + ".tmp";
+
+  if (!shcore::create_file(tmp, dumper.str() + "\n")) {
+    throw std::runtime_error("Failed to write progress file '" + tmp +
+                             "': " + shcore::errno_to_string(errno));
+  }
+
+#ifdef _WIN32
+  shcore::delete_file(m_path);
+#endif
+
+  shcore::rename_file(tmp, m_path);
+}
+
+}  // namespace mysqlsh
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef MODULES_UTIL_IMPORT_PROGRESS_H_
+#define MODULES_UTIL_IMPORT_PROGRESS_H_
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mysqlsh {
+
+/**
+ * Keeps track of the part of an input file which was committed by an import,
+ * so an interrupted import can be resumed without processing the whole file
+ * again.
+ *
+ * The input is divided into ranges, one for each worker of the import. Each
+ * time a worker commits a transaction, the offset of the end of the last
+ * committed document in its range is stored in the progress file.
+ */
+class Import_progress final {
+ public:
+  struct Range {
+    size_t begin;
+    size_t end;
+    // offset of the first byte which was not committed yet
+    size_t committed;
+  };
+
+  /**
+   * @param path path to the progress file
+   * @param input path to the imported file
+   * @param required if false and the progress file cannot be written when
+   *        the import starts, a warning is printed and the progress is not
+   *        recorded
+   */
+  Import_progress(const std::string &path, const std::string &input,
+                  bool required = true);
+
+  Import_progress(const Import_progress &) = delete;
+  Import_progress &operator=(const Import_progress &) = delete;
+
+  const std::string &path() const { return m_path; }
+
+  /**
+   * Reads the progress file written by a previous import of the same input.
+   *
+   * @throws std::runtime_error if the file does not exist, cannot be parsed
+   *         or it was written for a different input
+   */
+  void load();
+
+  /**
+   * Sets the ranges of a new import and writes the progress file.
+   */
+  void start(const std::vector<std::pair<size_t, size_t>> &ranges);
+
+  /**
+   * @returns the ranges, empty if neither load() nor start() were called.
+   */
+  std::vector<Range> ranges() const;
+
+  /**
+   * @returns number of bytes which were committed in all the ranges.
+   */
+  size_t committed_bytes() const;
+
+  /**
+   * Records that the data of a range up to the given offset was committed and
+   * writes the progress file. Can be called from multiple threads.
+   */
+  void committed(size_t range, size_t offset);
+
+  /**
+   * Removes the progress file, once the import is finished.
+   */
+  void remove();
+
+ private:
+  void save() const;
+
+  std::string m_path;
+  std::string m_input;
+  size_t m_input_size;
+  bool m_required;
+  bool m_disabled = false;
+  std::vector<Range> m_ranges;
+  mutable std::mutex m_mutex;
+};
+
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_IMPORT_PROGRESS_H_
@@ -27,8 +27,12 @@
 #else
 #include <sys/select.h>
 #endif
+#include <algorithm>
+#include <chrono>
 #include <deque>
+#include <exception>
 #include <istream>
+#include <thread>
 #include <utility>
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/db/mysqlx/util/setter_any.h"
@@ -36,10 +40,76 @@
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
 #include "shellcore/interrupt_handler.h"
+#include "shellcore/shell_init.h"
 
 namespace mysqlsh {
 
+namespace {
+
+/**
+ * Finds offset of the first document which begins after the given offset.
+ *
+ * A '{' which is preceded by a '}' with a new line in between can only start
+ * a top level document: JSON strings cannot contain raw new lines and closing
+ * brace of a nested object is always followed by ',', '}' or ']'.
+ *
+ * @returns Offset of the document or file size if there are no more documents
+ * separated by a new line.
+ */
+size_t find_document_start(const std::string &path, size_t offset,
+                           size_t file_size) {
+  shcore::Buffered_input input{path};
+  input.set_range(offset, file_size);
+
+  int last = 0;
+  bool new_line = false;
+
+  while (true) {
+    const int c = input.peek();
+    if (input.eof()) break;
+
+    if (c == '\n') {
+      new_line = true;
+    } else if (!::isspace(c)) {
+      if (c == '{' && last == '}' && new_line) return input.offset();
+      last = c;
+      new_line = false;
+    }
+
+    input.get();
+  }
+
+  return file_size;
+}
+
+/**
+ * Splits file into at most `count` byte ranges aligned on document boundaries.
+ */
+std::vector<std::pair<size_t, size_t>> split_on_document_boundaries(
+    const std::string &path, int count) {
+  const size_t file_size = shcore::file_size(path);
+  std::vector<std::pair<size_t, size_t>> ranges;
+  size_t begin = 0;
+
+  for (int i = 1; i < count && begin < file_size; ++i) {
+    const size_t target = std::max(begin, file_size / count * i);
+    const size_t end = find_document_start(path, target, file_size);
+
+    if (end > begin) {
+      ranges.emplace_back(begin, end);
+      begin = end;
+    }
+  }
+
+  if (begin < file_size) ranges.emplace_back(begin, file_size);
+
+  return ranges;
+}
+
+}  // namespace
+
 void Prepare_json_import::set_defaults() {
   if (m_collection.is_null() && m_table.is_null()) {
     if (m_put_to_collection) {
@@ -171,13 +241,78 @@ Json_importer Prepare_json_import::build() {
 }
 
 /*
- * 8 inserts per transaction with default 64M (for mysql 8.0)
- * max_allowed_packet, do commit every 512M.
+ * By default there are 8 inserts per transaction, with default 64M (for mysql
+ * 8.0) max_allowed_packet this means commit every 512M, the controller makes
+ * the transactions smaller if they take too long.
  * It is advised to "Avoid performing rollbacks after inserting, updating, or
  * deleting huge numbers of rows."
  * https://dev.mysql.com/doc/refman/8.0/en/optimizing-innodb-transaction-management.html
  */
-static constexpr const int k_inserts_per_transaction = 8;
+constexpr size_t Batch_controller::k_default_inserts_per_commit;
+constexpr size_t Batch_controller::k_max_inserts_per_commit;
+
+namespace {
+
+// weight of the latest measurement in the moving averages
+constexpr double k_average_weight = 0.3;
+
+// part of the target latency which is always left for the inserts, even if
+// commits take longer than the target
+constexpr double k_min_insert_budget = 0.1;
+
+// upper limit of the computed number of documents in an insert, the inserts
+// are still limited by the packet size
+constexpr double k_max_documents_per_insert = 1000000000.0;
+
+double moving_average(double average, double value) {
+  return average == 0.0
+             ? value
+             : average + k_average_weight * (value - average);
+}
+
+}  // namespace
+
+void Batch_controller::pin_documents_per_insert(size_t documents) {
+  m_documents_pinned = documents > 0;
+  m_documents_per_insert = documents;
+}
+
+void Batch_controller::pin_inserts_per_commit(size_t inserts) {
+  m_inserts_pinned = inserts > 0;
+  m_inserts_per_commit = inserts > 0 ? inserts : k_default_inserts_per_commit;
+}
+
+void Batch_controller::on_insert(size_t documents, double seconds) {
+  if (documents == 0) return;
+
+  m_document_time = moving_average(m_document_time, seconds / documents);
+  m_insert_time = moving_average(m_insert_time, seconds);
+  update();
+}
+
+void Batch_controller::on_commit(double seconds) {
+  m_commit_time = moving_average(m_commit_time, seconds);
+  update();
+}
+
+void Batch_controller::update() {
+  const double budget = std::max(m_target_latency - m_commit_time,
+                                 m_target_latency * k_min_insert_budget);
+
+  if (!m_documents_pinned && m_document_time > 0.0) {
+    const double documents =
+        budget / k_default_inserts_per_commit / m_document_time;
+    m_documents_per_insert = static_cast<size_t>(
+        std::max(1.0, std::min(documents, k_max_documents_per_insert)));
+  }
+
+  if (!m_inserts_pinned && m_insert_time > 0.0) {
+    const double inserts = budget / m_insert_time;
+    m_inserts_per_commit = static_cast<size_t>(std::max(
+        1.0,
+        std::min(inserts, static_cast<double>(k_max_inserts_per_commit))));
+  }
+}
 
 Json_importer::Json_importer(
     const std::shared_ptr<mysqlshdk::db::mysqlx::Session> &session)
@@ -235,18 +370,47 @@ void Json_importer::print_stats() {
         format_throughput_items("document", "documents",
                                 m_stats.documents_successfully_imported,
                                 import_time_seconds) +
-        ")\n";
+        ")\n" + batch_stats();
     m_print(msg);
   }
 }
 
+std::string Json_importer::batch_stats() const {
+  if (m_stats.inserts == 0 || m_stats.commits == 0) return "";
+
+  const auto mode = [](bool pinned, size_t value) -> std::string {
+    return pinned ? "pinned to " + std::to_string(value) : "adaptive";
+  };
+
+  return shcore::str_format(
+             "Average batch: %.1f documents per insert (%s), %.1f inserts "
+             "per commit (%s)",
+             static_cast<double>(m_stats.items_processed) / m_stats.inserts,
+             mode(m_batch_controller.documents_per_insert_pinned(),
+                  m_batch_controller.documents_per_insert())
+                 .c_str(),
+             static_cast<double>(m_stats.inserts) / m_stats.commits,
+             mode(m_batch_controller.inserts_per_commit_pinned(),
+                  m_batch_controller.inserts_per_commit())
+                 .c_str()) +
+         shcore::str_format(
+             ", target commit latency %.0f ms\n",
+             m_batch_controller.target_latency() * 1000.0);
+}
+
 void Json_importer::load_from(const shcore::Document_reader_options &options) {
   shcore::Buffered_input input{};
   m_stats.timer.stage_begin("Importing documents");
 
   if (!m_file_path.empty()) {
     auto full_path = shcore::path::expand_user(m_file_path);
-    input.open(full_path);
+
+    if (m_threads > 1 || m_progress) {
+      load_parallel(full_path, options);
+      return;
+    }
+
+    input.open(full_path, true);
   }
 
   load_from(&input, options);
@@ -254,8 +418,134 @@ void Json_importer::load_from(const shcore::Document_reader_options &options) {
 
 void Json_importer::load_from(shcore::Buffered_input *input,
                               const shcore::Document_reader_options &options) {
+  std::atomic<bool> cancel{false};
+  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+    cancel = true;
+    return false;
+  });
+
+  import_documents(input, options, cancel);
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+}
+
+void Json_importer::load_parallel(
+    const std::string &full_path,
+    const shcore::Document_reader_options &options) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+
+  if (m_progress && !m_progress->ranges().empty()) {
+    // resumed import, ranges are not split again, so committed offsets match
+    for (const auto &range : m_progress->ranges()) {
+      ranges.emplace_back(range.committed, range.end);
+    }
+  } else {
+    ranges = split_on_document_boundaries(full_path, m_threads);
+    if (m_progress) m_progress->start(ranges);
+  }
+
+  if (ranges.size() < 2) {
+    shcore::Buffered_input input;
+    input.open(full_path, true);
+    if (!ranges.empty()) input.set_range(ranges[0].first, ranges[0].second);
+    m_progress_range = 0;
+    load_from(&input, options);
+    return;
+  }
+
+  std::atomic<uint64_t> progress{0};
+  std::vector<std::unique_ptr<Json_importer>> workers;
+
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    auto session = m_session;
+
+    if (i > 0) {
+      session = mysqlshdk::db::mysqlx::Session::create();
+      session->connect(m_session->get_connection_options());
+    }
+
+    workers.emplace_back(shcore::make_unique<Json_importer>(session));
+    workers.back()->m_batch_insert.CopyFrom(m_batch_insert);
+    workers.back()->m_batch_controller = m_batch_controller;
+    workers.back()->m_shared_progress = &progress;
+    workers.back()->m_progress = m_progress;
+    workers.back()->m_progress_range = i;
+  }
+
+  std::atomic<bool> cancel{false};
+  std::atomic<size_t> finished{0};
+  std::vector<std::exception_ptr> errors(workers.size());
+  std::vector<std::thread> threads;
+
+  {
+    shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+      cancel = true;
+      return false;
+    });
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        mysqlsh::thread_init();
+
+        try {
+          shcore::Buffered_input input;
+          input.open(full_path, true);
+          input.set_range(ranges[i].first, ranges[i].second);
+          workers[i]->import_documents(&input, options, cancel);
+        } catch (...) {
+          errors[i] = std::current_exception();
+          cancel = true;
+        }
+
+        mysqlsh::thread_end();
+        ++finished;
+      });
+    }
+
+    uint64_t reported = 0;
+
+    while (finished < threads.size()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      const uint64_t imported = progress;
+
+      if (m_print && imported != reported) {
+        m_print(".. " + std::to_string(imported));
+        reported = imported;
+      }
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto &worker : workers) {
+    m_stats.items_processed += worker->m_stats.items_processed;
+    m_stats.bytes_processed += worker->m_stats.bytes_processed;
+    m_stats.documents_successfully_imported +=
+        worker->m_stats.documents_successfully_imported;
+    m_stats.inserts += worker->m_stats.inserts;
+    m_stats.commits += worker->m_stats.commits;
+  }
+
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+
+  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
+}
+
+void Json_importer::import_documents(
+    shcore::Buffered_input *input,
+    const shcore::Document_reader_options &options,
+    const std::atomic<bool> &cancel) {
+  // time which is not spent in the nested stages is spent parsing documents
+  mysqlshdk::utils::Profile_stage stage("Importing documents");
   m_stats.items_processed = 0;
   m_stats.bytes_processed = 0;
+  m_stats.inserts = 0;
+  m_stats.commits = 0;
   m_packet_size_tracker.inserts_in_this_transaction = 0;
 
   // schema and collection target are already set here, so we can cache
@@ -264,42 +554,49 @@ void Json_importer::load_from(shcore::Buffered_input *input,
 
   m_session->execute("START TRANSACTION");
 
-  bool cancel = false;
-  shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
-    cancel = true;
-    return false;
-  });
-
   shcore::Json_reader reader(input, options);
+  m_document_end = input->offset();
+
+  if (reader.supports_views()) {
+    // documents are sent straight from the memory mapped input
+    shcore::Document_view doc;
 
-  while (!reader.eof() && !cancel) {
-    std::string jd = reader.next();
+    while (!cancel && reader.next(&doc)) {
+      put(doc.data, doc.size);
+      m_document_end = input->offset();
+    }
+  } else {
+    while (!reader.eof() && !cancel) {
+      std::string jd = reader.next();
 
-    if (!jd.empty()) {
-      // todo(kg): move jd string all the way to protobuf's
-      // Scalar_String::set_value
-      put(std::move(jd));
+      if (!jd.empty()) {
+        put(jd.data(), jd.size());
+        m_document_end = input->offset();
+      }
     }
   }
 
   flush();
   commit(true);
-
-  if (cancel) throw shcore::cancelled("JSON documents import cancelled.");
 }
 
-void Json_importer::put(const std::string &item) {
-  if (m_packet_size_tracker.will_overflow(item.size())) {
+void Json_importer::put(const char *item, size_t size) {
+  const size_t documents_per_insert =
+      m_batch_controller.documents_per_insert();
+
+  if (m_packet_size_tracker.will_overflow(size) ||
+      (documents_per_insert > 0 &&
+       m_packet_size_tracker.rows_in_insert >= documents_per_insert)) {
     flush();
-    if (m_packet_size_tracker.inserts_in_this_transaction >=
-        k_inserts_per_transaction) {
+    if (static_cast<size_t>(m_packet_size_tracker.inserts_in_this_transaction) >=
+        m_batch_controller.inserts_per_commit()) {
       commit();
     }
   }
 
-  m_stats.bytes_processed += item.size();
+  m_stats.bytes_processed += size;
   m_stats.items_processed++;
-  add_to_request(item);
+  add_to_request(item, size);
 }
 
 void Json_importer::update_statistics(xcl::XQuery_result *xquery_result) {
@@ -309,14 +606,16 @@ void Json_importer::update_statistics(xcl::XQuery_result *xquery_result) {
   bool ret = xquery_result->try_get_affected_rows(&affected_rows);
   if (ret) {
     m_stats.documents_successfully_imported += affected_rows;
-    if (m_print) {
+    if (m_shared_progress) {
+      *m_shared_progress += affected_rows;
+    } else if (m_print) {
       m_print(".. " + std::to_string(m_stats.documents_successfully_imported));
     }
   }
 }
 
 void Json_importer::recv_response(bool block) {
-  if (m_pending_response > 0) {
+  if (!m_pending.empty()) {
     my_socket fd = m_session->get_driver_obj()
                        ->get_protocol()
                        .get_connection()
@@ -330,37 +629,63 @@ void Json_importer::recv_response(bool block) {
     auto ready = select(fd + 1, &rfds, nullptr, nullptr, &timeout);
     bool fd_ready = FD_ISSET(fd, &rfds);
     if (block || (ready > 0 && fd_ready)) {
+      mysqlshdk::utils::Profile_stage stage("Receiving response");
       xcl::XError error;
       auto result =
           m_session->get_driver_obj()->get_protocol().recv_resultset(&error);
       update_statistics(result.get());
       if (error) throw mysqlshdk::db::Error(error.what(), error.error());
-      m_pending_response--;
+
+      // requests are executed one after another, server started to execute
+      // this one when it was received or when the previous one was finished
+      const auto now = Clock::now();
+      const auto &request = m_pending.front();
+      const double seconds = std::chrono::duration<double>(
+                                 now - std::max(request.sent, m_last_response))
+                                 .count();
+      m_last_response = now;
+
+      if (request.documents > 0) {
+        m_batch_controller.on_insert(request.documents, seconds);
+      } else {
+        m_batch_controller.on_commit(seconds);
+        if (m_progress) m_progress->committed(m_progress_range, request.offset);
+      }
+
+      m_pending.pop_front();
     }
   }
 }
 
 void Json_importer::flush() {
   if (m_packet_size_tracker.rows_in_insert > 0) {
+    mysqlshdk::utils::Profile_stage stage("Inserting documents");
     xcl::XError error;
     if (m_proto_interleaved) {
       recv_response();
       error = m_session->get_driver_obj()->get_protocol().send(m_batch_insert);
-      m_pending_response++;
+      m_pending.push_back(
+          {Clock::now(), m_packet_size_tracker.rows_in_insert, 0});
     } else {
+      const auto start = Clock::now();
       auto result = m_session->get_driver_obj()->get_protocol().execute_insert(
           m_batch_insert, &error);
       update_statistics(result.get());
+      m_batch_controller.on_insert(
+          m_packet_size_tracker.rows_in_insert,
+          std::chrono::duration<double>(Clock::now() - start).count());
     }
     if (error) throw mysqlshdk::db::Error(error.what(), error.error());
     m_batch_insert.mutable_row()->Clear();
     m_packet_size_tracker.inserts_in_this_transaction++;
     m_packet_size_tracker.bytes_in_insert = 0;
     m_packet_size_tracker.rows_in_insert = 0;
+    m_stats.inserts++;
   }
 }
 
 void Json_importer::commit(bool final_commit) {
+  mysqlshdk::utils::Profile_stage stage("Committing");
   if (m_proto_interleaved) {
     xcl::XError error;
     recv_response();
@@ -371,21 +696,26 @@ void Json_importer::commit(bool final_commit) {
     error = m_session->get_driver_obj()->get_protocol().send(stmt);
     if (error) throw mysqlshdk::db::Error(error.what(), error.error());
 
-    m_pending_response++;
+    m_pending.push_back({Clock::now(), 0, m_document_end});
     if (final_commit) {
-      while (m_pending_response > 0) recv_response(true);
+      while (!m_pending.empty()) recv_response(true);
     }
   } else {
+    const auto start = Clock::now();
     m_session->execute(!final_commit ? "COMMIT AND CHAIN" : "COMMIT");
+    m_batch_controller.on_commit(
+        std::chrono::duration<double>(Clock::now() - start).count());
+    if (m_progress) m_progress->committed(m_progress_range, m_document_end);
   }
   m_packet_size_tracker.inserts_in_this_transaction = 0;
+  m_stats.commits++;
 }
 
-void Json_importer::add_to_request(const std::string &doc) {
+void Json_importer::add_to_request(const char *doc, size_t size) {
   auto fields = m_batch_insert.mutable_row()->Add()->mutable_field();
-  mysqlshdk::db::mysqlx::util::set_scalar(*fields->Add(), doc);
+  mysqlshdk::db::mysqlx::util::set_scalar(*fields->Add(), doc, size);
 
-  m_packet_size_tracker.bytes_in_insert += doc.size();
+  m_packet_size_tracker.bytes_in_insert += size;
   m_packet_size_tracker.rows_in_insert++;
 }
 }  // namespace mysqlsh
@@ -24,8 +24,14 @@
 #ifndef MODULES_UTIL_JSON_IMPORTER_H_
 #define MODULES_UTIL_JSON_IMPORTER_H_
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
+#include "modules/util/import_progress.h"
 #include "mysqlshdk/include/scripting/types.h"
 #include "mysqlshdk/libs/db/mysqlx/session.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
@@ -183,6 +189,67 @@ class Prepare_json_import {
   bool m_put_to_collection = true;
 };
 
+/**
+ * Tunes the number of documents in each insert and the number of inserts in
+ * each transaction of the JSON import, so that a transaction takes about the
+ * target time to be executed and committed.
+ *
+ * Time spent by the server on each insert and commit is measured using their
+ * round trips. Number of documents per insert is chosen so that a transaction
+ * with the default number of inserts meets the target, then the number of
+ * inserts per transaction is chosen to meet the target with the inserts which
+ * are actually sent, these can be smaller if they are limited by the maximum
+ * packet size. Until the first insert is measured, inserts are limited only
+ * by the packet size.
+ *
+ * Both values can also be pinned, in which case they are not tuned.
+ */
+class Batch_controller {
+ public:
+  static constexpr size_t k_default_inserts_per_commit = 8;
+  static constexpr size_t k_max_inserts_per_commit = 64;
+
+  void set_target_latency(double seconds) { m_target_latency = seconds; }
+  double target_latency() const { return m_target_latency; }
+
+  /**
+   * @param documents number of documents in each insert, 0 enables tuning
+   */
+  void pin_documents_per_insert(size_t documents);
+
+  /**
+   * @param inserts number of inserts in each transaction, 0 enables tuning
+   */
+  void pin_inserts_per_commit(size_t inserts);
+
+  bool documents_per_insert_pinned() const { return m_documents_pinned; }
+  bool inserts_per_commit_pinned() const { return m_inserts_pinned; }
+
+  /**
+   * @returns maximum number of documents in an insert, 0 if only the packet
+   *          size limits the inserts
+   */
+  size_t documents_per_insert() const { return m_documents_per_insert; }
+  size_t inserts_per_commit() const { return m_inserts_per_commit; }
+
+  void on_insert(size_t documents, double seconds);
+  void on_commit(double seconds);
+
+ private:
+  void update();
+
+  double m_target_latency = 1.0;
+  bool m_documents_pinned = false;
+  bool m_inserts_pinned = false;
+  size_t m_documents_per_insert = 0;
+  size_t m_inserts_per_commit = k_default_inserts_per_commit;
+
+  // moving averages of the measured times, in seconds
+  double m_document_time = 0.0;
+  double m_insert_time = 0.0;
+  double m_commit_time = 0.0;
+};
+
 class Json_importer {
  public:
   explicit Json_importer(
@@ -201,6 +268,31 @@ class Json_importer {
    * @param path Path to JSON document. Empty path enables read from stdin.
    */
   void set_path(const std::string &path) { m_file_path = path; }
+
+  /**
+   * Set number of threads used to import the file. The file is split into
+   * byte ranges aligned on document boundaries and each range is imported by
+   * its own worker thread using its own X Protocol session. Ignored when
+   * reading from stdin.
+   */
+  void set_threads(int threads) { m_threads = threads; }
+
+  /**
+   * Controller of the insert and transaction sizes, can be used to set the
+   * target latency or to pin the sizes before the import starts.
+   */
+  Batch_controller &batch_controller() { return m_batch_controller; }
+
+  /**
+   * Records offsets of the committed documents in the given progress file,
+   * after each commit. If the progress was loaded from an existing file, the
+   * import resumes right after the committed documents. Ignored when reading
+   * from stdin.
+   */
+  void set_progress(const std::shared_ptr<Import_progress> &progress) {
+    m_progress = progress;
+  }
+
   void load_from(const shcore::Document_reader_options &options);
 
   void print_stats();
@@ -208,11 +300,17 @@ class Json_importer {
  private:
   void load_from(shcore::Buffered_input *input,
                  const shcore::Document_reader_options &options);
-  void put(const std::string &item);
+  void load_parallel(const std::string &full_path,
+                     const shcore::Document_reader_options &options);
+  void import_documents(shcore::Buffered_input *input,
+                        const shcore::Document_reader_options &options,
+                        const std::atomic<bool> &cancel);
+  std::string batch_stats() const;
+  void put(const char *item, size_t size);
   void recv_response(bool block = false);
   void flush();
   void commit(bool final_commit = false);
-  void add_to_request(const std::string &doc);
+  void add_to_request(const char *doc, size_t size);
   void update_statistics(xcl::XQuery_result *xquery_result);
 
   ::Mysqlx::Crud::Insert m_batch_insert;
@@ -285,14 +383,42 @@ class Json_importer {
 #else
   const bool m_proto_interleaved = true;
 #endif
-  int m_pending_response = 0;
+  using Clock = std::chrono::steady_clock;
+
+  // requests sent in the interleaved mode, which are waiting for a response
+  struct Pending_request {
+    Clock::time_point sent;
+    // 0 for a commit
+    size_t documents;
+    // input offset committed by a commit
+    size_t offset;
+  };
+  std::deque<Pending_request> m_pending;
+  Clock::time_point m_last_response;
+
+  Batch_controller m_batch_controller;
+
   std::function<void(const std::string &)> m_print = nullptr;
 
+  int m_threads = 1;
+
+  /// Shared counter of imported documents, set when this importer is a worker
+  /// of a parallel import. Progress is then printed by the coordinator.
+  std::atomic<uint64_t> *m_shared_progress = nullptr;
+
+  std::shared_ptr<Import_progress> m_progress;
+  /// Index of the range of the input handled by this importer.
+  size_t m_progress_range = 0;
+  /// Input offset of the end of the last document added to an insert.
+  size_t m_document_end = 0;
+
   struct {
     uint64_t items_processed = 0;
     uint64_t bytes_processed = 0;
     uint64_t import_filesize = 0;
     uint64_t documents_successfully_imported = 0;
+    uint64_t inserts = 0;
+    uint64_t commits = 0;
     mysqlshdk::utils::Profile_timer timer;
   } m_stats;
 
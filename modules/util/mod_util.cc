@@ -27,7 +27,11 @@
 #include <vector>
 #include "modules/mod_utils.h"
 #include "modules/mysqlxtest_utils.h"
+#include "modules/util/import_progress.h"
 #include "modules/util/json_importer.h"
+#include "modules/util/table_comparator.h"
+#include "modules/util/table_exporter.h"
+#include "modules/util/table_importer.h"
 #include "modules/util/upgrade_check.h"
 #include "mysqlshdk/include/shellcore/base_session.h"
 #include "mysqlshdk/include/shellcore/console.h"
@@ -36,7 +40,11 @@
 #include "mysqlshdk/libs/mysql/instance.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
 #include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 #include "rapidjson/document.h"
 #include "rapidjson/error/en.h"
@@ -61,6 +69,14 @@ Util::Util(shcore::IShell_core *owner) : _shell_core(*owner) {
       "data", shcore::Map);
 
   expose("importJson", &Util::import_json, "path", "?options");
+
+  expose("exportTable", &Util::export_table, "table", "outputDir",
+         "?options");
+
+  expose("importTable", &Util::import_table, "file", "?options");
+
+  expose("compareTables", &Util::compare_tables, "source", "target",
+         "?options");
 }
 
 static std::string format_upgrade_issue(const Upgrade_issue &problem) {
@@ -359,9 +375,14 @@ REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL3,
               "(default=" MYSH_VERSION ")");
 
 REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL4,
+              "@li threads - number of sessions used to run the checks in "
+              "parallel, CHECK TABLE is run for several schemas at a time "
+              "(default=1).");
+
+REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL5,
               "@li password - password for connection.");
 
-REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL5, "${TOPIC_CONNECTION_DATA}");
+REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL6, "${TOPIC_CONNECTION_DATA}");
 
 /**
  * \ingroup util
@@ -377,6 +398,7 @@ REGISTER_HELP(UTIL_CHECKFORSERVERUPGRADE_DETAIL5, "${TOPIC_CONNECTION_DATA}");
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL1)
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL2)
  * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL3)
+ * $(UTIL_CHECKFORSERVERUPGRADE_DETAIL4)
  *
  * \copydoc connection_options
  *
@@ -421,14 +443,20 @@ shcore::Value Util::check_for_server_upgrade(
 
     std::string output_format("TEXT");
     std::string target_version(MYSH_VERSION);
+    int64_t threads = 1;
     if (args.size() > 0 &&
         args[args.size() - 1].type == shcore::Value_type::Map) {
       auto dict = args.map_at(args.size() - 1);
       output_format = dict->get_string("outputFormat", output_format);
       target_version = dict->get_string("targetVersion", target_version);
       if (target_version == "8.0") target_version.assign(MYSH_VERSION);
+      threads = dict->get_int("threads", threads);
     }
 
+    if (threads < 1)
+      throw shcore::Exception::argument_error(
+          "Option 'threads' must be a positive integer.");
+
     auto print = Upgrade_check_output_formatter::get_formatter(output_format);
 
     auto session = establish_session(connection_options,
@@ -481,11 +509,25 @@ shcore::Value Util::check_for_server_upgrade(
       }
     };
 
-    for (auto &check : checklist)
+    // checks run in parallel are still reported in the order of the list
+    std::unique_ptr<Parallel_check_runner> runner;
+    if (threads > 1) {
+      std::vector<std::shared_ptr<mysqlshdk::db::ISession>> sessions{session};
+      for (int64_t i = 1; i < threads; ++i)
+        sessions.emplace_back(
+            establish_session(session->get_connection_options(), false));
+
+      runner.reset(
+          new Parallel_check_runner(checklist, sessions, current_version));
+    }
+
+    for (size_t i = 0; i < checklist.size(); ++i) {
+      const auto &check = checklist[i];
       if (check->is_runnable()) {
         try {
           std::vector<Upgrade_issue> issues =
-              check->run(session, current_version);
+              runner ? runner->get_issues(i)
+                     : check->run(session, current_version);
           for (const auto &issue : issues) update_counts(issue.level);
           print->check_results(*check, issues);
         } catch (const std::exception &e) {
@@ -495,6 +537,7 @@ shcore::Value Util::check_for_server_upgrade(
         update_counts(check->get_level());
         print->manual_check(*check);
       }
+    }
 
     std::string summary;
     if (errors > 0) {
@@ -563,50 +606,79 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL8,
               "field based on the ObjectID timestamp. Only valid if "
               "convertBsonOid is enabled.");
 REGISTER_HELP(UTIL_IMPORTJSON_DETAIL9,
+              "@li threads: int (default: 1) - number of threads used to "
+              "import the file. The file is split into chunks aligned on "
+              "document boundaries and each chunk is imported using its own X "
+              "Protocol session.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
+              "@li commitLatency: int (default: 1000) - time in milliseconds "
+              "which each transaction should take to be executed and "
+              "committed. The number of documents per insert and the number "
+              "of inserts per transaction are tuned to meet it, based on the "
+              "measured response times of the server.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL11,
+              "@li documentsPerInsert: int (default: adaptive) - maximum "
+              "number of documents sent in a single insert, disables its "
+              "tuning. Inserts are also limited by mysqlx_max_allowed_packet.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL12,
+              "@li insertsPerCommit: int (default: adaptive) - number of "
+              "inserts executed in a single transaction, disables its "
+              "tuning.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
+              "@li progressFile: string (default: path to the file with the "
+              ".progress suffix) - file where the offsets of the committed "
+              "documents are recorded after each commit. It is removed once "
+              "the import finishes successfully.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL14,
+              "@li resume: bool (default: false) - resumes an interrupted "
+              "import right after the documents recorded as committed in the "
+              "progress file. The same file, schema and target have to be "
+              "used.");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
               "The following options are valid only when convertBsonTypes is "
               "enabled. They are all boolean flags. ignoreRegexOptions is "
               "enabled by default, rest are disabled by default.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL10,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
               "@li ignoreDate: disables conversion of BSON Date values");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL11,
+    UTIL_IMPORTJSON_DETAIL17,
     "@li ignoreTimestamp: disables conversion of BSON Timestamp values");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL12,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL18,
               "@li ignoreRegex: disables conversion of BSON Regex values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL15,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21,
               "@li ignoreRegexOptions: causes regex options to be ignored when "
               "processing a Regex BSON value. This option is only valid if "
               "ignoreRegex is disabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL13,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL19,
               "@li ignoreBinary: disables conversion of BSON BinData values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL14,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20,
               "@li decimalAsDouble: causes BSON Decimal values to be imported "
               "as double values.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL16,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "If the schema is not provided, an active schema on the global "
               "session, if set, will be used.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL17,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL23,
               "The collection and the table options cannot be combined. If "
               "they are not provided, the basename of the file without "
               "extension will be used as target collection name.");
 
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL18,
+    UTIL_IMPORTJSON_DETAIL24,
     "If the target collection or table does not exist, they are created, "
     "otherwise the data is inserted into the existing collection or table.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL19,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
               "The tableColumn implies the use of the table option and cannot "
               "be combined "
               "with the collection option.");
 
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL20, "<b>BSON Data Type Processing.</b>");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL21,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL26, "<b>BSON Data Type Processing.</b>");
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL27,
               "If only convertBsonOid is enabled, no conversion will be done "
               "on the rest of the BSON Data Types.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL28,
               "To use extractOidTime, it should be set to a name which will "
               "be used to insert an additional field into the main document. "
               "The value of the new field will be the timestamp obtained from "
@@ -614,12 +686,12 @@ REGISTER_HELP(UTIL_IMPORTJSON_DETAIL22,
               "ObjectID value associated to the '_id' field of the main "
               "document.");
 REGISTER_HELP(
-    UTIL_IMPORTJSON_DETAIL23,
+    UTIL_IMPORTJSON_DETAIL29,
     "NumberLong and NumberInt values will be converted to integer values.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL24,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL30,
               "NumberDecimal values are imported as strings, unless "
               "decimalAsDouble is enabled.");
-REGISTER_HELP(UTIL_IMPORTJSON_DETAIL25,
+REGISTER_HELP(UTIL_IMPORTJSON_DETAIL31,
               "Regex values will be converted to strings containing the "
               "regular expression. The regular expression options are ignored "
               "unless ignoreRegexOptions is disabled. When ignoreRegexOptions "
@@ -667,25 +739,19 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  * $(UTIL_IMPORTJSON_DETAIL6)
  * $(UTIL_IMPORTJSON_DETAIL7)
  * $(UTIL_IMPORTJSON_DETAIL8)
- *
  * $(UTIL_IMPORTJSON_DETAIL9)
  * $(UTIL_IMPORTJSON_DETAIL10)
  * $(UTIL_IMPORTJSON_DETAIL11)
  * $(UTIL_IMPORTJSON_DETAIL12)
  * $(UTIL_IMPORTJSON_DETAIL13)
  * $(UTIL_IMPORTJSON_DETAIL14)
- * $(UTIL_IMPORTJSON_DETAIL15)
  *
+ * $(UTIL_IMPORTJSON_DETAIL15)
  * $(UTIL_IMPORTJSON_DETAIL16)
- *
  * $(UTIL_IMPORTJSON_DETAIL17)
- *
  * $(UTIL_IMPORTJSON_DETAIL18)
- *
  * $(UTIL_IMPORTJSON_DETAIL19)
- *
  * $(UTIL_IMPORTJSON_DETAIL20)
- *
  * $(UTIL_IMPORTJSON_DETAIL21)
  *
  * $(UTIL_IMPORTJSON_DETAIL22)
@@ -696,6 +762,18 @@ REGISTER_HELP(UTIL_IMPORTJSON_THROWS12, "@li JSON document is ill-formed");
  *
  * $(UTIL_IMPORTJSON_DETAIL25)
  *
+ * $(UTIL_IMPORTJSON_DETAIL26)
+ *
+ * $(UTIL_IMPORTJSON_DETAIL27)
+ *
+ * $(UTIL_IMPORTJSON_DETAIL28)
+ *
+ * $(UTIL_IMPORTJSON_DETAIL29)
+ *
+ * $(UTIL_IMPORTJSON_DETAIL30)
+ *
+ * $(UTIL_IMPORTJSON_DETAIL31)
+ *
  * $(UTIL_IMPORTJSON_THROWS)
  * $(UTIL_IMPORTJSON_THROWS1)
  * $(UTIL_IMPORTJSON_THROWS2)
@@ -725,12 +803,24 @@ void Util::import_json(const std::string &file,
   std::string collection;
   std::string table;
   std::string table_column;
+  int64_t threads = 1;
+  int64_t commit_latency = 1000;
+  int64_t documents_per_insert = 0;
+  int64_t inserts_per_commit = 0;
+  std::string progress_file;
+  bool resume = false;
 
   shcore::Option_unpacker unpacker(options);
   unpacker.optional("schema", &schema);
   unpacker.optional("collection", &collection);
   unpacker.optional("table", &table);
   unpacker.optional("tableColumn", &table_column);
+  unpacker.optional("threads", &threads);
+  unpacker.optional("commitLatency", &commit_latency);
+  unpacker.optional("documentsPerInsert", &documents_per_insert);
+  unpacker.optional("insertsPerCommit", &inserts_per_commit);
+  unpacker.optional("progressFile", &progress_file);
+  unpacker.optional("resume", &resume);
 
   shcore::Document_reader_options roptions;
   mysqlsh::unpack_json_import_flags(&unpacker, &roptions);
@@ -743,6 +833,28 @@ void Util::import_json(const std::string &file,
         "Option 'extractOidTime' can not be empty.");
   }
 
+  if (threads < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'threads' must be a positive integer.");
+  }
+
+  if (commit_latency < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'commitLatency' must be a positive integer.");
+  }
+
+  if (options && options->has_key("documentsPerInsert") &&
+      documents_per_insert < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'documentsPerInsert' must be a positive integer.");
+  }
+
+  if (options && options->has_key("insertsPerCommit") &&
+      inserts_per_commit < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'insertsPerCommit' must be a positive integer.");
+  }
+
   auto shell_session = _shell_core.get_dev_session();
 
   if (!shell_session) {
@@ -800,6 +912,20 @@ void Util::import_json(const std::string &file,
   // Validate provided parameters and build Json_importer object.
   auto importer = prepare.build();
 
+  const auto full_path = shcore::path::expand_user(file);
+
+  // progress is recorded next to the input by default, if that's not possible
+  // the import continues without it
+  const bool progress_required = !progress_file.empty() || resume;
+  if (progress_file.empty()) progress_file = full_path + ".progress";
+
+  const auto progress = std::make_shared<Import_progress>(
+      shcore::path::expand_user(progress_file), full_path, progress_required);
+
+  if (resume) progress->load();
+
+  importer.set_progress(progress);
+
   auto console = mysqlsh::current_console();
   console->print_info(
       prepare.to_string() + " in MySQL Server at " +
@@ -809,13 +935,629 @@ void Util::import_json(const std::string &file,
   importer.set_print_callback([](const std::string &msg) -> void {
     mysqlsh::current_console()->print(msg);
   });
+  importer.set_threads(static_cast<int>(threads));
+
+  auto &batch_controller = importer.batch_controller();
+  batch_controller.set_target_latency(commit_latency / 1000.0);
+  batch_controller.pin_documents_per_insert(
+      static_cast<size_t>(documents_per_insert));
+  batch_controller.pin_inserts_per_commit(
+      static_cast<size_t>(inserts_per_commit));
+
+  if (resume) {
+    console->print_info(
+        "Resuming the import, " +
+        mysqlshdk::utils::format_bytes(progress->committed_bytes()) +
+        " of the input were already committed.\n");
+  }
 
   try {
     importer.load_from(roptions);
   } catch (...) {
     importer.print_stats();
+
+    if (shcore::file_exists(progress->path())) {
+      console->print_info("Progress of the import was saved to '" +
+                          progress->path() +
+                          "', the import can be continued using the resume "
+                          "option.");
+    }
+
+    throw;
+  }
+  importer.print_stats();
+
+  progress->remove();
+}
+
+REGISTER_HELP_FUNCTION(exportTable, util);
+REGISTER_HELP(UTIL_EXPORTTABLE_BRIEF,
+              "Exports contents of a table to files, using multiple MySQL "
+              "Protocol sessions to read the data in parallel.");
+
+REGISTER_HELP(UTIL_EXPORTTABLE_PARAM,
+              "@param table Name of the table to be exported.");
+REGISTER_HELP(UTIL_EXPORTTABLE_PARAM1,
+              "@param outputDir Path to the directory where the files are "
+              "written.");
+REGISTER_HELP(UTIL_EXPORTTABLE_PARAM2,
+              "@param options Optional dictionary with export options");
+
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL,
+              "If the table has a primary key on a single integer column, "
+              "it is split into chunks of the key values, each chunk is "
+              "written to its own file named after the table and the chunk "
+              "number and the chunks are read concurrently. A manifest file "
+              "named after the table with the .manifest.json suffix, "
+              "describing the columns, the chunks and the replication "
+              "coordinates of the exported data, is written once all the "
+              "chunks are exported. Characters of the table name other than "
+              "letters, digits, '_' and '-' are percent-encoded in the file "
+              "names.");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL1,
+              "The options dictionary supports the following options:");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL2,
+              "@li schema: string - name of the schema of the table.");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL3,
+              "@li format: string (default: \"tsv\") - format of the files, "
+              "one of: tsv (format used by LOAD DATA with default options), "
+              "csv (RFC 4180 with NULL written as \\N and backslashes "
+              "escaped), ndjson (a JSON object per line, values of binary "
+              "columns are base64 encoded strings).");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL4,
+              "@li threads: int (default: 4) - number of threads and sessions "
+              "used to read the chunks.");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL5,
+              "@li chunkRows: int (default: 1000000) - approximate number of "
+              "rows in each chunk.");
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL6,
+              "@li consistent: bool (default: true) - lock the table while "
+              "the sessions start their transactions, so all the chunks are "
+              "read from the same snapshot. FLUSH TABLES WITH READ LOCK is "
+              "used if the user has the RELOAD privilege, LOCK TABLES "
+              "otherwise.");
+
+REGISTER_HELP(UTIL_EXPORTTABLE_DETAIL7,
+              "If the schema is not provided, an active schema on the global "
+              "session, if set, will be used.");
+
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS, "Throws ArgumentError when:");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS1, "@li Option name is invalid");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS2, "@li Format is not valid");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS3,
+              "@li Number of threads or chunk rows is not positive");
+
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS4, "Throws RuntimeError when:");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS5,
+              "@li Shell is not connected to MySQL Server using MySQL "
+              "Protocol");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS6,
+              "@li Schema is not provided and there is no active schema on the "
+              "global session");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS7, "@li The table does not exist");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS8,
+              "@li The files cannot be written");
+REGISTER_HELP(UTIL_EXPORTTABLE_THROWS9, "@li MySQL Server returns an error");
+
+/**
+ * \ingroup util
+ *
+ * $(UTIL_EXPORTTABLE_BRIEF)
+ *
+ * $(UTIL_EXPORTTABLE_PARAM)
+ * $(UTIL_EXPORTTABLE_PARAM1)
+ * $(UTIL_EXPORTTABLE_PARAM2)
+ *
+ * $(UTIL_EXPORTTABLE_DETAIL)
+ *
+ * $(UTIL_EXPORTTABLE_DETAIL1)
+ * $(UTIL_EXPORTTABLE_DETAIL2)
+ * $(UTIL_EXPORTTABLE_DETAIL3)
+ * $(UTIL_EXPORTTABLE_DETAIL4)
+ * $(UTIL_EXPORTTABLE_DETAIL5)
+ * $(UTIL_EXPORTTABLE_DETAIL6)
+ *
+ * $(UTIL_EXPORTTABLE_DETAIL7)
+ *
+ * $(UTIL_EXPORTTABLE_THROWS)
+ * $(UTIL_EXPORTTABLE_THROWS1)
+ * $(UTIL_EXPORTTABLE_THROWS2)
+ * $(UTIL_EXPORTTABLE_THROWS3)
+ *
+ * $(UTIL_EXPORTTABLE_THROWS4)
+ * $(UTIL_EXPORTTABLE_THROWS5)
+ * $(UTIL_EXPORTTABLE_THROWS6)
+ * $(UTIL_EXPORTTABLE_THROWS7)
+ * $(UTIL_EXPORTTABLE_THROWS8)
+ * $(UTIL_EXPORTTABLE_THROWS9)
+ */
+#if DOXYGEN_JS
+Undefined Util::exportTable(String table, String outputDir,
+                            Dictionary options);
+#elif DOXYGEN_PY
+None Util::export_table(str table, str outputDir, dict options);
+#endif
+
+void Util::export_table(const std::string &table,
+                        const std::string &output_dir,
+                        const shcore::Dictionary_t &options) {
+  std::string schema;
+  std::string format = "tsv";
+  int64_t threads = 4;
+  int64_t chunk_rows = 1000000;
+  bool consistent = true;
+
+  shcore::Option_unpacker unpacker(options);
+  unpacker.optional("schema", &schema);
+  unpacker.optional("format", &format);
+  unpacker.optional("threads", &threads);
+  unpacker.optional("chunkRows", &chunk_rows);
+  unpacker.optional("consistent", &consistent);
+  unpacker.end();
+
+  const auto export_format = Table_exporter::to_format(format);
+
+  if (threads < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'threads' must be a positive integer.");
+  }
+
+  if (chunk_rows < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'chunkRows' must be a positive integer.");
+  }
+
+  auto shell_session = _shell_core.get_dev_session();
+
+  if (!shell_session) {
+    throw shcore::Exception::runtime_error(
+        "Please connect the shell to the MySQL server.");
+  }
+
+  if (shell_session->get_node_type().compare("X") == 0) {
+    throw shcore::Exception::runtime_error(
+        "A classic protocol session is required to perform this operation.");
+  }
+
+  if (schema.empty()) schema = shell_session->get_current_schema();
+
+  if (schema.empty()) {
+    throw std::runtime_error(
+        "There is no active schema on the current session, the target schema "
+        "for the export operation must be provided in the options.");
+  }
+
+  Connection_options connection_options =
+      shell_session->get_connection_options();
+
+  auto session = mysqlshdk::db::mysql::Session::create();
+  session->connect(connection_options);
+
+  Table_exporter exporter{session};
+  exporter.set_table(schema, table);
+  exporter.set_output_dir(shcore::path::expand_user(output_dir));
+  exporter.set_format(export_format);
+  exporter.set_threads(static_cast<int>(threads));
+  exporter.set_chunk_rows(static_cast<uint64_t>(chunk_rows));
+  exporter.set_consistent(consistent);
+
+  auto console = mysqlsh::current_console();
+  console->print_info(
+      "Exporting table " + shcore::quote_identifier(schema) + "." +
+      shcore::quote_identifier(table) + " from MySQL Server at " +
+      connection_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
+      " to " + output_dir + "\n");
+
+  exporter.set_print_callback([](const std::string &msg) -> void {
+    mysqlsh::current_console()->print(msg);
+  });
+
+  try {
+    exporter.run();
+  } catch (...) {
+    exporter.print_stats();
+    throw;
+  }
+  exporter.print_stats();
+
+  session->close();
+}
+
+REGISTER_HELP_FUNCTION(importTable, util);
+REGISTER_HELP(UTIL_IMPORTTABLE_BRIEF,
+              "Imports contents of a text file into a table, using multiple "
+              "MySQL Protocol sessions to load the data in parallel.");
+
+REGISTER_HELP(UTIL_IMPORTTABLE_PARAM,
+              "@param file Path to the file with the data to be imported.");
+REGISTER_HELP(UTIL_IMPORTTABLE_PARAM1,
+              "@param options Optional dictionary with import options");
+
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL,
+              "The file is split into chunks aligned on line boundaries and "
+              "each chunk is loaded using a LOAD DATA LOCAL INFILE statement, "
+              "the chunks are loaded concurrently. Fields in the file must "
+              "not contain unescaped new line characters. The local_infile "
+              "global system variable must be enabled on the target server.");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL1,
+              "The options dictionary supports the following options:");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL2,
+              "@li schema: string - name of the target schema.");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL3,
+              "@li table: string - name of the target table, by default it is "
+              "the name of the file up to the first dot.");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL4,
+              "@li format: string (default: \"tsv\") - format of the file, "
+              "one of: tsv (format used by LOAD DATA with default options), "
+              "csv (RFC 4180 with NULL written as \\N and backslashes "
+              "escaped).");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL5,
+              "@li threads: int (default: 4) - number of threads and sessions "
+              "used to load the chunks.");
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL6,
+              "@li bytesPerChunk: int (default: 52428800) - approximate size "
+              "of each chunk in bytes.");
+
+REGISTER_HELP(UTIL_IMPORTTABLE_DETAIL7,
+              "If the schema is not provided, an active schema on the global "
+              "session, if set, will be used.");
+
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS, "Throws ArgumentError when:");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS1, "@li Option name is invalid");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS2, "@li Format is not valid");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS3,
+              "@li Number of threads or bytes per chunk is not positive");
+
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS4, "Throws RuntimeError when:");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS5,
+              "@li Shell is not connected to MySQL Server using MySQL "
+              "Protocol");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS6,
+              "@li Schema is not provided and there is no active schema on the "
+              "global session");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS7,
+              "@li The local_infile global system variable is disabled");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS8,
+              "@li The file does not exist or cannot be mapped into memory");
+REGISTER_HELP(UTIL_IMPORTTABLE_THROWS9, "@li MySQL Server returns an error");
+
+/**
+ * \ingroup util
+ *
+ * $(UTIL_IMPORTTABLE_BRIEF)
+ *
+ * $(UTIL_IMPORTTABLE_PARAM)
+ * $(UTIL_IMPORTTABLE_PARAM1)
+ *
+ * $(UTIL_IMPORTTABLE_DETAIL)
+ *
+ * $(UTIL_IMPORTTABLE_DETAIL1)
+ * $(UTIL_IMPORTTABLE_DETAIL2)
+ * $(UTIL_IMPORTTABLE_DETAIL3)
+ * $(UTIL_IMPORTTABLE_DETAIL4)
+ * $(UTIL_IMPORTTABLE_DETAIL5)
+ * $(UTIL_IMPORTTABLE_DETAIL6)
+ *
+ * $(UTIL_IMPORTTABLE_DETAIL7)
+ *
+ * $(UTIL_IMPORTTABLE_THROWS)
+ * $(UTIL_IMPORTTABLE_THROWS1)
+ * $(UTIL_IMPORTTABLE_THROWS2)
+ * $(UTIL_IMPORTTABLE_THROWS3)
+ *
+ * $(UTIL_IMPORTTABLE_THROWS4)
+ * $(UTIL_IMPORTTABLE_THROWS5)
+ * $(UTIL_IMPORTTABLE_THROWS6)
+ * $(UTIL_IMPORTTABLE_THROWS7)
+ * $(UTIL_IMPORTTABLE_THROWS8)
+ * $(UTIL_IMPORTTABLE_THROWS9)
+ */
+#if DOXYGEN_JS
+Undefined Util::importTable(String file, Dictionary options);
+#elif DOXYGEN_PY
+None Util::import_table(str file, dict options);
+#endif
+
+void Util::import_table(const std::string &file,
+                        const shcore::Dictionary_t &options) {
+  std::string schema;
+  std::string table;
+  std::string format = "tsv";
+  int64_t threads = 4;
+  int64_t bytes_per_chunk = 50 * 1024 * 1024;
+
+  shcore::Option_unpacker unpacker(options);
+  unpacker.optional("schema", &schema);
+  unpacker.optional("table", &table);
+  unpacker.optional("format", &format);
+  unpacker.optional("threads", &threads);
+  unpacker.optional("bytesPerChunk", &bytes_per_chunk);
+  unpacker.end();
+
+  const auto import_format = Table_exporter::to_format(format);
+
+  if (import_format == Table_exporter::Format::NDJSON) {
+    throw std::invalid_argument(
+        "The ndjson format is not supported, use importJson() instead.");
+  }
+
+  if (threads < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'threads' must be a positive integer.");
+  }
+
+  if (bytes_per_chunk < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'bytesPerChunk' must be a positive integer.");
+  }
+
+  auto shell_session = _shell_core.get_dev_session();
+
+  if (!shell_session) {
+    throw shcore::Exception::runtime_error(
+        "Please connect the shell to the MySQL server.");
+  }
+
+  if (shell_session->get_node_type().compare("X") == 0) {
+    throw shcore::Exception::runtime_error(
+        "A classic protocol session is required to perform this operation.");
+  }
+
+  if (schema.empty()) schema = shell_session->get_current_schema();
+
+  if (schema.empty()) {
+    throw std::runtime_error(
+        "There is no active schema on the current session, the target schema "
+        "for the import operation must be provided in the options.");
+  }
+
+  // files written by exportTable() are named <table>@<chunk>.<extension>
+  if (table.empty()) {
+    const auto name = shcore::path::basename(file);
+    table = name.substr(0, name.find_first_of(".@"));
+  }
+
+  Connection_options connection_options =
+      shell_session->get_connection_options();
+
+  auto session = mysqlshdk::db::mysql::Session::create();
+  session->connect(connection_options);
+
+  Table_importer importer{session};
+  importer.set_file(file);
+  importer.set_table(schema, table);
+  importer.set_format(import_format);
+  importer.set_threads(static_cast<int>(threads));
+  importer.set_bytes_per_chunk(static_cast<uint64_t>(bytes_per_chunk));
+
+  auto console = mysqlsh::current_console();
+  console->print_info(
+      "Importing from file '" + file + "' to table " +
+      shcore::quote_identifier(schema) + "." +
+      shcore::quote_identifier(table) + " in MySQL Server at " +
+      connection_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
+      "\n");
+
+  importer.set_print_callback([](const std::string &msg) -> void {
+    mysqlsh::current_console()->print(msg);
+  });
+
+  try {
+    importer.run();
+  } catch (...) {
+    importer.print_stats();
     throw;
   }
   importer.print_stats();
+
+  session->close();
+}
+
+REGISTER_HELP_FUNCTION(compareTables, util);
+REGISTER_HELP(UTIL_COMPARETABLES_BRIEF,
+              "Compares contents of a table on two MySQL Servers, using "
+              "checksums computed by the servers to find the rows which "
+              "differ.");
+
+REGISTER_HELP(UTIL_COMPARETABLES_PARAM,
+              "@param source Connection data of the server with the reference "
+              "data.");
+REGISTER_HELP(UTIL_COMPARETABLES_PARAM1,
+              "@param target Connection data of the server which is "
+              "validated.");
+REGISTER_HELP(UTIL_COMPARETABLES_PARAM2,
+              "@param options Optional dictionary with comparison options");
+
+REGISTER_HELP(UTIL_COMPARETABLES_RETURNS,
+              "@returns A dictionary with the results of the comparison.");
+
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL,
+              "The table is split into chunks of the values of the first "
+              "column of its primary key (unless it is a floating point, "
+              "spatial, JSON, BIT, ENUM or SET column) and the chunks are "
+              "compared concurrently. Both servers "
+              "compute the number of rows and a checksum of each chunk, using "
+              "the CRC32() and BIT_XOR() functions, only the rows of the "
+              "chunks whose checksums differ are read from both servers and "
+              "compared one by one. The table must have a primary key and the "
+              "same definition on both servers.");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL1,
+              "The options dictionary supports the following options:");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL2,
+              "@li schema: string - name of the schema of the table.");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL3,
+              "@li table: string - name of the table, this option is "
+              "required.");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL4,
+              "@li threads: int (default: 4) - number of threads and pairs of "
+              "sessions used to compare the chunks.");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL5,
+              "@li chunkSize: int (default: 100000) - approximate number of "
+              "rows in each chunk.");
+
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL6,
+              "If the schema is not provided, the schema of the source "
+              "connection data, if set, will be used.");
+REGISTER_HELP(UTIL_COMPARETABLES_DETAIL7,
+              "The returned dictionary contains the number of compared "
+              "chunks (chunks), the number of chunks whose checksums differ "
+              "(differentChunks), the number of rows which are missing on the "
+              "target (missingRows), exist only on the target (extraRows) or "
+              "have different values (differentRows) and whether the tables "
+              "are identical (identical). Rows which are modified while the "
+              "table is compared may be reported as different.");
+
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS, "Throws ArgumentError when:");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS1, "@li Option name is invalid");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS2, "@li The table is not provided");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS3,
+              "@li Number of threads or chunk size is not positive");
+
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS4, "Throws RuntimeError when:");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS5,
+              "@li Schema is not provided and it is not set in the source "
+              "connection data");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS6,
+              "@li The table does not exist on any of the servers");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS7,
+              "@li The table does not have a primary key");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS8,
+              "@li The table has different definitions on the servers");
+REGISTER_HELP(UTIL_COMPARETABLES_THROWS9, "@li MySQL Server returns an error");
+
+/**
+ * \ingroup util
+ *
+ * $(UTIL_COMPARETABLES_BRIEF)
+ *
+ * $(UTIL_COMPARETABLES_PARAM)
+ * $(UTIL_COMPARETABLES_PARAM1)
+ * $(UTIL_COMPARETABLES_PARAM2)
+ *
+ * $(UTIL_COMPARETABLES_RETURNS)
+ *
+ * $(UTIL_COMPARETABLES_DETAIL)
+ *
+ * $(UTIL_COMPARETABLES_DETAIL1)
+ * $(UTIL_COMPARETABLES_DETAIL2)
+ * $(UTIL_COMPARETABLES_DETAIL3)
+ * $(UTIL_COMPARETABLES_DETAIL4)
+ * $(UTIL_COMPARETABLES_DETAIL5)
+ *
+ * $(UTIL_COMPARETABLES_DETAIL6)
+ *
+ * $(UTIL_COMPARETABLES_DETAIL7)
+ *
+ * $(UTIL_COMPARETABLES_THROWS)
+ * $(UTIL_COMPARETABLES_THROWS1)
+ * $(UTIL_COMPARETABLES_THROWS2)
+ * $(UTIL_COMPARETABLES_THROWS3)
+ *
+ * $(UTIL_COMPARETABLES_THROWS4)
+ * $(UTIL_COMPARETABLES_THROWS5)
+ * $(UTIL_COMPARETABLES_THROWS6)
+ * $(UTIL_COMPARETABLES_THROWS7)
+ * $(UTIL_COMPARETABLES_THROWS8)
+ * $(UTIL_COMPARETABLES_THROWS9)
+ */
+#if DOXYGEN_JS
+Dictionary Util::compareTables(ConnectionData source, ConnectionData target,
+                               Dictionary options);
+#elif DOXYGEN_PY
+dict Util::compare_tables(ConnectionData source, ConnectionData target,
+                          dict options);
+#endif
+
+shcore::Dictionary_t Util::compare_tables(
+    const shcore::Value &source, const shcore::Value &target,
+    const shcore::Dictionary_t &options) {
+  std::string schema;
+  std::string table;
+  int64_t threads = 4;
+  int64_t chunk_size = 100000;
+
+  shcore::Option_unpacker unpacker(options);
+  unpacker.optional("schema", &schema);
+  unpacker.optional("table", &table);
+  unpacker.optional("threads", &threads);
+  unpacker.optional("chunkSize", &chunk_size);
+  unpacker.end();
+
+  if (table.empty()) {
+    throw shcore::Exception::argument_error(
+        "The name of the table must be provided in the 'table' option.");
+  }
+
+  if (threads < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'threads' must be a positive integer.");
+  }
+
+  if (chunk_size < 1) {
+    throw shcore::Exception::argument_error(
+        "Option 'chunkSize' must be a positive integer.");
+  }
+
+  const auto source_options = mysqlsh::get_connection_options(source);
+  const auto target_options = mysqlsh::get_connection_options(target);
+
+  if (schema.empty() && source_options.has_schema()) {
+    schema = source_options.get_schema();
+  }
+
+  if (schema.empty()) {
+    throw std::runtime_error(
+        "The schema of the table must be provided in the options or in the "
+        "source connection data.");
+  }
+
+  const auto connect = [](const Connection_options &connection_options) {
+    return std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(
+        establish_mysql_session(connection_options,
+                                current_shell_options()->get().wizards));
+  };
+
+  const auto source_session = connect(source_options);
+  const auto target_session = connect(target_options);
+
+  Table_comparator comparator{source_session, target_session};
+  comparator.set_table(schema, table);
+  comparator.set_threads(static_cast<int>(threads));
+  comparator.set_chunk_rows(static_cast<uint64_t>(chunk_size));
+
+  auto console = mysqlsh::current_console();
+  console->print_info(
+      "Comparing table " + shcore::quote_identifier(schema) + "." +
+      shcore::quote_identifier(table) + " in MySQL Server at " +
+      source_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
+      " with MySQL Server at " +
+      target_options.as_uri(mysqlshdk::db::uri::formats::only_transport()) +
+      "\n");
+
+  comparator.set_print_callback([](const std::string &msg) -> void {
+    mysqlsh::current_console()->print(msg);
+  });
+
+  try {
+    comparator.run();
+  } catch (...) {
+    comparator.print_stats();
+    throw;
+  }
+  comparator.print_stats();
+
+  source_session->close();
+  target_session->close();
+
+  const auto result = shcore::make_dict();
+  (*result)["chunks"] = shcore::Value(comparator.chunks());
+  (*result)["differentChunks"] = shcore::Value(comparator.different_chunks());
+  (*result)["missingRows"] = shcore::Value(comparator.missing_rows());
+  (*result)["extraRows"] = shcore::Value(comparator.extra_rows());
+  (*result)["differentRows"] = shcore::Value(comparator.different_rows());
+  (*result)["identical"] = shcore::Value(comparator.identical());
+
+  return result;
 }
+
 }  // namespace mysqlsh
@@ -62,6 +62,33 @@ class SHCORE_PUBLIC Util : public shcore::Cpp_object_bridge,
   void import_json(const std::string &file,
                    const shcore::Dictionary_t &options);
 
+#if DOXYGEN_JS
+  Undefined exportTable(String table, String outputDir, Dictionary options);
+#elif DOXYGEN_PY
+  None export_table(str table, str outputDir, dict options);
+#endif
+  void export_table(const std::string &table, const std::string &output_dir,
+                    const shcore::Dictionary_t &options);
+
+#if DOXYGEN_JS
+  Undefined importTable(String file, Dictionary options);
+#elif DOXYGEN_PY
+  None import_table(str file, dict options);
+#endif
+  void import_table(const std::string &file,
+                    const shcore::Dictionary_t &options);
+
+#if DOXYGEN_JS
+  Dictionary compareTables(ConnectionData source, ConnectionData target,
+                           Dictionary options);
+#elif DOXYGEN_PY
+  dict compare_tables(ConnectionData source, ConnectionData target,
+                      dict options);
+#endif
+  shcore::Dictionary_t compare_tables(const shcore::Value &source,
+                                      const shcore::Value &target,
+                                      const shcore::Dictionary_t &options);
+
  private:
   shcore::IShell_core &_shell_core;
 };
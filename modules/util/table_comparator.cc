@@ -0,0 +1,640 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/table_comparator.h"
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <thread>
+#include <utility>
+#include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/libs/db/utils/diff.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/interrupt_handler.h"
+#include "shellcore/shell_init.h"
+
+namespace mysqlsh {
+
+namespace {
+
+// Signed keys are mapped to unsigned values with the same order, so chunks
+// can be computed using the same arithmetic for both.
+constexpr uint64_t k_sign_bit = 1ULL << 63;
+
+uint64_t to_key(const mysqlshdk::db::IRow &row, uint32_t index,
+                bool is_unsigned) {
+  return is_unsigned ? row.get_uint(index)
+                     : static_cast<uint64_t>(row.get_int(index)) ^ k_sign_bit;
+}
+
+std::string from_key(uint64_t key, bool is_unsigned) {
+  return is_unsigned ? std::to_string(key)
+                     : std::to_string(static_cast<int64_t>(key ^ k_sign_bit));
+}
+
+/**
+ * Whether the server orders values of this type the same way as rows are
+ * compared by the diff functions, other types are ordered as binary strings.
+ */
+bool is_ordered_as_number(mysqlshdk::db::Type type) {
+  switch (type) {
+    case mysqlshdk::db::Type::Integer:
+    case mysqlshdk::db::Type::UInteger:
+    case mysqlshdk::db::Type::Float:
+    case mysqlshdk::db::Type::Double:
+    case mysqlshdk::db::Type::Decimal:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * Whether the rows can be split into ranges of a key of this type, using
+ * literals of its values which the server compares the same way as the values.
+ */
+bool is_chunkable(mysqlshdk::db::Type type) {
+  switch (type) {
+    case mysqlshdk::db::Type::Integer:
+    case mysqlshdk::db::Type::UInteger:
+    case mysqlshdk::db::Type::Decimal:
+    case mysqlshdk::db::Type::String:
+    case mysqlshdk::db::Type::Bytes:
+    case mysqlshdk::db::Type::Date:
+    case mysqlshdk::db::Type::Time:
+    case mysqlshdk::db::Type::DateTime:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+std::string to_literal(const mysqlshdk::db::IRow &row, uint32_t index,
+                       mysqlshdk::db::Type type) {
+  switch (type) {
+    case mysqlshdk::db::Type::Integer:
+    case mysqlshdk::db::Type::UInteger:
+    case mysqlshdk::db::Type::Decimal:
+      return row.get_as_string(index);
+
+    case mysqlshdk::db::Type::Bytes: {
+      // binary values may not be valid in the character set of the connection
+      static constexpr char k_digits[] = "0123456789ABCDEF";
+      std::string literal = "X'";
+
+      for (const auto c : row.get_string(index)) {
+        literal += k_digits[static_cast<unsigned char>(c) >> 4];
+        literal += k_digits[static_cast<unsigned char>(c) & 0xF];
+      }
+
+      return literal + "'";
+    }
+
+    default:
+      return shcore::quote_sql_string(row.get_as_string(index));
+  }
+}
+
+struct Checksum {
+  uint64_t rows = 0;
+  uint64_t crc = 0;
+};
+
+Checksum checksum(const std::shared_ptr<mysqlshdk::db::ISession> &session,
+                  const std::string &sql) {
+  const auto result = session->query(sql);
+  const auto row = result->fetch_one();
+  Checksum checksum;
+
+  if (row) {
+    checksum.rows = row->get_uint(0);
+    checksum.crc = row->is_null(1) ? 0 : row->get_uint(1);
+  }
+
+  return checksum;
+}
+
+}  // namespace
+
+Table_comparator::Table_comparator(
+    const std::shared_ptr<mysqlshdk::db::mysql::Session> &source,
+    const std::shared_ptr<mysqlshdk::db::mysql::Session> &target)
+    : m_source(source), m_target(target) {}
+
+void Table_comparator::set_table(const std::string &schema,
+                                 const std::string &table) {
+  m_schema = schema;
+  m_table = table;
+  m_quoted_table =
+      shcore::quote_identifier(schema) + "." + shcore::quote_identifier(table);
+}
+
+std::string Table_comparator::checksum_query(
+    const std::string &table, const std::vector<std::string> &columns,
+    const std::string &where) {
+  // values are converted to binary strings, so columns with different
+  // collations can be concatenated, each one is prefixed with its length, so
+  // the separator cannot be confused with the contents of a value, NULL values
+  // (and their lengths) are skipped by CONCAT_WS(), the extra field marks which
+  // of the columns are NULL
+  std::string values;
+  std::string nulls;
+
+  for (const auto &column : columns) {
+    const auto name = shcore::quote_identifier(column);
+    const auto value = "CAST(" + name + " AS BINARY)";
+    values += "LENGTH(" + value + ")," + value + ",";
+    if (!nulls.empty()) nulls += ",";
+    nulls += "ISNULL(" + name + ")";
+  }
+
+  return "SELECT COUNT(*), BIT_XOR(CRC32(CONCAT_WS('#'," + values + "CONCAT(" +
+         nulls + ")))) FROM " + table + where;
+}
+
+void Table_comparator::run() {
+  m_timer.stage_begin("Comparing table");
+
+  read_table_info();
+  create_chunks();
+
+  // there's no need to open more sessions than chunks
+  const size_t count = std::min(m_chunks.size(),
+                                static_cast<size_t>(std::max(m_threads, 1)));
+
+  for (size_t i = 0; i < count; ++i) {
+    m_workers.emplace_back(shcore::make_unique<Worker>());
+    auto worker = m_workers.back().get();
+
+    worker->source = mysqlshdk::db::mysql::Session::create();
+    worker->source->connect(m_source->get_connection_options());
+    worker->target = mysqlshdk::db::mysql::Session::create();
+    worker->target->connect(m_target->get_connection_options());
+  }
+
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> finished{0};
+  std::vector<std::exception_ptr> errors(m_workers.size());
+  std::vector<std::thread> threads;
+  std::atomic<bool> interrupted{false};
+
+  {
+    shcore::Interrupt_handler intr_handler([this, &interrupted]() -> bool {
+      interrupted = true;
+      m_cancel = true;
+      return false;
+    });
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        mysqlsh::thread_init();
+
+        try {
+          for (size_t chunk = next_chunk++;
+               chunk < m_chunks.size() && !m_cancel; chunk = next_chunk++) {
+            compare_chunk(m_workers[i].get(), m_chunks[chunk]);
+          }
+        } catch (...) {
+          errors[i] = std::current_exception();
+          m_cancel = true;
+        }
+
+        mysqlsh::thread_end();
+        ++finished;
+      });
+    }
+
+    uint64_t reported = 0;
+
+    while (finished < threads.size()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      const uint64_t compared = m_chunks_compared;
+
+      if (m_print && compared != reported) {
+        m_print(".. " + std::to_string(compared) + " of " +
+                std::to_string(m_chunks.size()) + " chunks compared");
+        reported = compared;
+      }
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto &worker : m_workers) {
+    worker->source->close();
+    worker->target->close();
+  }
+
+  if (interrupted) throw shcore::cancelled("Table comparison cancelled.");
+
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+void Table_comparator::read_table_info() {
+  for (const auto &session : {m_source, m_target}) {
+    const auto result = session->queryf(
+        "SELECT TABLE_ROWS FROM information_schema.tables WHERE "
+        "TABLE_SCHEMA = ? AND TABLE_NAME = ?",
+        m_schema, m_table);
+    const auto row = result->fetch_one();
+
+    if (!row) {
+      throw std::runtime_error(
+          "Table " + m_quoted_table + " does not exist on the " +
+          (session == m_source ? "source" : "target") + " server.");
+    }
+
+    if (session == m_source) {
+      m_rows_estimate = row->is_null(0) ? 0 : row->get_uint(0);
+    }
+  }
+
+  auto result = m_source->queryf(
+      "SELECT COLUMN_NAME FROM information_schema.statistics WHERE "
+      "TABLE_SCHEMA = ? AND TABLE_NAME = ? AND INDEX_NAME = 'PRIMARY' "
+      "ORDER BY SEQ_IN_INDEX",
+      m_schema, m_table);
+
+  std::vector<std::string> key;
+  while (const auto row = result->fetch_one()) {
+    key.emplace_back(row->get_string(0));
+  }
+
+  if (key.empty()) {
+    throw std::runtime_error("Table " + m_quoted_table +
+                             " does not have a primary key, which is required "
+                             "to compare its rows.");
+  }
+
+  // rows are matched using the primary key, its columns are selected first,
+  // in the order of the key, so that the rows can be merged in this order
+  m_column_names = key;
+
+  result = m_source->query("SELECT * FROM " + m_quoted_table + " LIMIT 0");
+
+  for (const auto &column : result->get_metadata()) {
+    const auto &name = column.get_column_name();
+
+    if (std::find(key.begin(), key.end(), name) == key.end()) {
+      m_column_names.emplace_back(name);
+    }
+  }
+
+  std::string columns;
+
+  for (const auto &name : m_column_names) {
+    if (!columns.empty()) columns.append(",");
+    columns.append(shcore::quote_identifier(name));
+  }
+
+  m_select = "SELECT " + columns + " FROM " + m_quoted_table;
+  m_columns = read_columns(m_source);
+
+  if (m_columns != read_columns(m_target)) {
+    throw std::runtime_error("Table " + m_quoted_table +
+                             " has different definitions on the source and "
+                             "target servers.");
+  }
+
+  m_key_fields.clear();
+  m_order_by.clear();
+
+  for (uint32_t i = 0; i < key.size(); ++i) {
+    const auto name = shcore::quote_identifier(key[i]);
+
+    m_key_fields.emplace_back(i);
+    m_order_by.append(m_order_by.empty() ? " ORDER BY " : ",");
+    m_order_by.append(is_ordered_as_number(m_columns[i].get_type())
+                          ? name
+                          : "CAST(" + name + " AS BINARY)");
+  }
+
+  m_chunk_key.clear();
+
+  if (is_chunkable(m_columns[0].get_type())) {
+    m_chunk_key = key[0];
+    m_chunk_key_type = m_columns[0].get_type();
+  } else {
+    mysqlsh::current_console()->print_warning(
+        "The type of the first column of the primary key of the table " +
+        m_quoted_table + " does not allow to split it into chunks, it will "
+        "be compared as a single chunk.");
+  }
+}
+
+std::vector<mysqlshdk::db::Column> Table_comparator::read_columns(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session) const {
+  return session->query(m_select + " LIMIT 0")->get_metadata();
+}
+
+void Table_comparator::create_chunks() {
+  m_chunks.clear();
+
+  if (!m_chunk_key.empty() && m_chunk_rows > 0 &&
+      m_rows_estimate > m_chunk_rows) {
+    if (m_chunk_key_type == mysqlshdk::db::Type::Integer ||
+        m_chunk_key_type == mysqlshdk::db::Type::UInteger) {
+      create_integer_chunks();
+    } else {
+      create_key_chunks();
+    }
+  }
+
+  if (m_chunks.empty()) m_chunks.emplace_back();
+}
+
+void Table_comparator::create_integer_chunks() {
+  const bool is_unsigned = m_chunk_key_type == mysqlshdk::db::Type::UInteger;
+  const std::string key = shcore::quote_identifier(m_chunk_key);
+  const std::string sql =
+      "SELECT MIN(" + key + "), MAX(" + key + ") FROM " + m_quoted_table;
+
+  // chunks have to cover the rows of both tables
+  bool found = false;
+  uint64_t min = 0;
+  uint64_t max = 0;
+
+  for (const auto &session : {m_source, m_target}) {
+    const auto result = session->query(sql);
+    const auto row = result->fetch_one();
+
+    if (row && !row->is_null(0)) {
+      const uint64_t lower = to_key(*row, 0, is_unsigned);
+      const uint64_t upper = to_key(*row, 1, is_unsigned);
+
+      if (!found || lower < min) min = lower;
+      if (!found || upper > max) max = upper;
+      found = true;
+    }
+  }
+
+  if (!found) return;
+
+  const uint64_t count = (m_rows_estimate + m_chunk_rows - 1) / m_chunk_rows;
+  const uint64_t step = (max - min) / count + 1;
+  std::string previous;
+
+  for (uint64_t begin = min;; begin += step) {
+    const uint64_t end = max - begin < step ? max : begin + step - 1;
+
+    Chunk chunk;
+    chunk.begin = previous;
+    chunk.end = from_key(end, is_unsigned);
+    previous = chunk.end;
+    m_chunks.emplace_back(std::move(chunk));
+
+    if (end == max) break;
+  }
+
+  // rows above the range can be added while the table is compared
+  m_chunks.back().end.clear();
+}
+
+void Table_comparator::create_key_chunks() {
+  // values of the key are not evenly distributed, the upper bound of each
+  // chunk is found by skipping the requested number of rows in the primary
+  // key of the source table
+  const std::string key = shcore::quote_identifier(m_chunk_key);
+  const std::string order_by = " ORDER BY " + key + " LIMIT 1 OFFSET " +
+                               std::to_string(m_chunk_rows - 1);
+  std::string previous;
+
+  for (;;) {
+    const auto result = m_source->query(
+        "SELECT " + key + " FROM " + m_quoted_table +
+        (previous.empty() ? "" : " WHERE " + key + " > " + previous) +
+        order_by);
+    const auto row = result->fetch_one();
+
+    if (!row) break;
+
+    Chunk chunk;
+    chunk.begin = previous;
+    chunk.end = to_literal(*row, 0, m_chunk_key_type);
+    previous = chunk.end;
+    m_chunks.emplace_back(std::move(chunk));
+  }
+
+  // the remaining rows, including the ones which exist only on the target
+  if (!m_chunks.empty()) {
+    Chunk chunk;
+    chunk.begin = previous;
+    m_chunks.emplace_back(std::move(chunk));
+  }
+}
+
+std::string Table_comparator::where(const Chunk &chunk) const {
+  const std::string key = shcore::quote_identifier(m_chunk_key);
+  std::string condition;
+
+  if (!chunk.begin.empty()) condition = key + " > " + chunk.begin;
+
+  if (!chunk.end.empty()) {
+    if (!condition.empty()) condition += " AND ";
+    condition += key + " <= " + chunk.end;
+  }
+
+  return condition.empty() ? "" : " WHERE " + condition;
+}
+
+void Table_comparator::compare_chunk(Worker *worker, const Chunk &chunk) {
+  mysqlshdk::utils::Profile_stage stage("Comparing chunk");
+  const auto sql = checksum_query(m_quoted_table, m_column_names, where(chunk));
+
+  worker->timer.stage_begin("Checksum");
+
+  // both servers compute their checksums at the same time
+  Checksum target;
+  std::exception_ptr target_error;
+  std::thread target_thread([&]() {
+    mysqlsh::thread_init();
+
+    try {
+      target = checksum(worker->target, sql);
+    } catch (...) {
+      target_error = std::current_exception();
+    }
+
+    mysqlsh::thread_end();
+  });
+
+  Checksum source;
+  std::exception_ptr source_error;
+
+  try {
+    source = checksum(worker->source, sql);
+  } catch (...) {
+    source_error = std::current_exception();
+  }
+
+  target_thread.join();
+  worker->timer.stage_end();
+
+  if (source_error) std::rethrow_exception(source_error);
+  if (target_error) std::rethrow_exception(target_error);
+
+  ++worker->chunks;
+  worker->rows += source.rows;
+
+  if (source.rows != target.rows || source.crc != target.crc) {
+    ++m_different_chunks;
+    compare_rows(worker, chunk);
+  }
+
+  ++m_chunks_compared;
+}
+
+void Table_comparator::compare_rows(Worker *worker, const Chunk &chunk) {
+  const auto sql = m_select + where(chunk) + m_order_by;
+
+  worker->timer.stage_begin("Comparing rows");
+
+  // rows are streamed from both servers and merged in the key order
+  const auto source = worker->source->query(sql);
+  const auto target = worker->target->query(sql);
+
+  mysqlshdk::db::find_different_rows_with_key_indexes(
+      source.get(), target.get(), m_key_fields,
+      [this](const mysqlshdk::db::IRow *lrow, const mysqlshdk::db::IRow *rrow,
+             mysqlshdk::db::Row_difference difference) {
+        switch (difference) {
+          case mysqlshdk::db::Row_difference::Row_missing:
+            ++m_missing_rows;
+            add_difference("Row " + key_text(*lrow) +
+                           " is missing on the target server.");
+            break;
+
+          case mysqlshdk::db::Row_difference::Row_added:
+            ++m_extra_rows;
+            add_difference("Row " + key_text(*rrow) +
+                           " exists only on the target server.");
+            break;
+
+          case mysqlshdk::db::Row_difference::Fields_differ: {
+            ++m_different_rows;
+            std::vector<std::string> columns;
+            mysqlshdk::db::find_different_row_fields(
+                *lrow, *rrow, [this, &columns](int field) {
+                  columns.emplace_back(m_column_names[field]);
+                  return true;
+                });
+            add_difference("Row " + key_text(*lrow) +
+                           " differs in columns: " +
+                           shcore::str_join(columns, ", ") + ".");
+            break;
+          }
+
+          case mysqlshdk::db::Row_difference::Identical:
+            break;
+        }
+
+        return !m_cancel;
+      });
+
+  worker->timer.stage_end();
+}
+
+std::string Table_comparator::key_text(const mysqlshdk::db::IRow &row) const {
+  std::vector<std::string> values;
+
+  for (const auto field : m_key_fields) {
+    values.emplace_back(row.get_as_string(field));
+  }
+
+  return "(" + shcore::str_join(values, ", ") + ")";
+}
+
+void Table_comparator::add_difference(const std::string &message) {
+  std::lock_guard<std::mutex> lock(m_differences_mutex);
+
+  if (m_differences.size() < m_max_printed_rows) {
+    m_differences.emplace_back(message);
+  }
+}
+
+void Table_comparator::print_stats() {
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_items;
+
+  m_timer.stage_end();
+
+  if (!m_print) return;
+
+  uint64_t rows = 0;
+  std::string per_thread;
+
+  for (size_t i = 0; i < m_workers.size(); ++i) {
+    const auto &worker = *m_workers[i];
+    const double seconds = worker.timer.total_seconds_ellapsed();
+
+    rows += worker.rows;
+
+    per_thread += "Thread " + std::to_string(i) + ": " +
+                  std::to_string(worker.rows) + " rows from " +
+                  std::to_string(worker.chunks) +
+                  (worker.chunks == 1 ? " chunk" : " chunks") + " in " +
+                  format_seconds(seconds) + " (" +
+                  format_throughput_items("row", "rows", worker.rows,
+                                          seconds) +
+                  ")\n";
+  }
+
+  std::string differences;
+
+  for (const auto &difference : m_differences) {
+    differences += difference + "\n";
+  }
+
+  const uint64_t total = m_missing_rows + m_extra_rows + m_different_rows;
+
+  if (total > m_differences.size()) {
+    differences += "... " + std::to_string(total - m_differences.size()) +
+                   " more rows differ.\n";
+  }
+
+  const double seconds = m_timer.total_seconds_ellapsed();
+
+  m_print("\n" + differences + "Compared " + std::to_string(rows) +
+          " rows from " + std::to_string(m_chunks_compared) + " of " +
+          std::to_string(m_chunks.size()) +
+          (m_chunks.size() == 1 ? " chunk" : " chunks") + " in " +
+          format_seconds(seconds) + " (" +
+          format_throughput_items("row", "rows", rows, seconds) + ")\n" +
+          per_thread + "Different chunks: " +
+          std::to_string(m_different_chunks) +
+          "\nRows missing on the target: " + std::to_string(m_missing_rows) +
+          "\nRows only on the target: " + std::to_string(m_extra_rows) +
+          "\nDifferent rows: " + std::to_string(m_different_rows) + "\n");
+}
+
+}  // namespace mysqlsh
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_TABLE_COMPARATOR_H_
+#define MODULES_UTIL_TABLE_COMPARATOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+
+namespace mysqlsh {
+
+/**
+ * Compares contents of a table on two servers.
+ *
+ * The table is split into ranges of the first column of its primary key
+ * (chunks). Integer keys are split into ranges of equal width, for other types
+ * the bounds are read from the primary key of the source table. For each
+ * chunk, the number of rows and a checksum of their contents are computed by
+ * both servers, using aggregate functions, so the rows are not transferred to
+ * the client. Only the rows of the chunks whose checksums differ are read from
+ * both servers (ordered by the primary key) and compared one by one. Chunks are
+ * compared concurrently, each thread uses its own pair of classic protocol
+ * sessions.
+ */
+class Table_comparator {
+ public:
+  /**
+   * @param source session to the server with the reference data
+   * @param target session to the server which is validated, i.e. a replica
+   *
+   * Connection options of the sessions are used to open the sessions which
+   * compare the chunks.
+   */
+  Table_comparator(
+      const std::shared_ptr<mysqlshdk::db::mysql::Session> &source,
+      const std::shared_ptr<mysqlshdk::db::mysql::Session> &target);
+
+  Table_comparator(const Table_comparator &) = delete;
+  Table_comparator &operator=(const Table_comparator &) = delete;
+
+  void set_table(const std::string &schema, const std::string &table);
+
+  /**
+   * Number of threads (and pairs of sessions) comparing the chunks.
+   */
+  void set_threads(int threads) { m_threads = threads; }
+
+  /**
+   * Approximate number of rows in each chunk.
+   */
+  void set_chunk_rows(uint64_t rows) { m_chunk_rows = rows; }
+
+  /**
+   * Maximum number of different rows which are printed, all of them are
+   * counted.
+   */
+  void set_max_printed_rows(size_t rows) { m_max_printed_rows = rows; }
+
+  void set_print_callback(
+      const std::function<void(const std::string &)> &callback) {
+    m_print = callback;
+  }
+
+  void run();
+
+  void print_stats();
+
+  uint64_t chunks() const { return m_chunks.size(); }
+  uint64_t different_chunks() const { return m_different_chunks; }
+  uint64_t missing_rows() const { return m_missing_rows; }
+  uint64_t extra_rows() const { return m_extra_rows; }
+  uint64_t different_rows() const { return m_different_rows; }
+
+  bool identical() const {
+    return m_missing_rows == 0 && m_extra_rows == 0 && m_different_rows == 0;
+  }
+
+  /**
+   * Builds a query which returns the number of rows and a checksum of their
+   * contents, the checksum does not depend on the order of the rows.
+   *
+   * @param table qualified and quoted name of the table
+   * @param columns names of all the columns of the table
+   * @param where condition selecting the rows, may be empty
+   */
+  static std::string checksum_query(const std::string &table,
+                                    const std::vector<std::string> &columns,
+                                    const std::string &where);
+
+ private:
+  struct Chunk {
+    // SQL literals of the exclusive lower and inclusive upper bound, empty
+    // bounds mean that the range is not limited on that side
+    std::string begin;
+    std::string end;
+  };
+
+  struct Worker {
+    std::shared_ptr<mysqlshdk::db::mysql::Session> source;
+    std::shared_ptr<mysqlshdk::db::mysql::Session> target;
+
+    uint64_t chunks = 0;
+    uint64_t rows = 0;
+    mysqlshdk::utils::Profile_timer timer;
+  };
+
+  void read_table_info();
+
+  std::vector<mysqlshdk::db::Column> read_columns(
+      const std::shared_ptr<mysqlshdk::db::ISession> &session) const;
+
+  void create_chunks();
+
+  void create_integer_chunks();
+
+  void create_key_chunks();
+
+  std::string where(const Chunk &chunk) const;
+
+  void compare_chunk(Worker *worker, const Chunk &chunk);
+
+  void compare_rows(Worker *worker, const Chunk &chunk);
+
+  std::string key_text(const mysqlshdk::db::IRow &row) const;
+
+  void add_difference(const std::string &message);
+
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_source;
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_target;
+
+  std::string m_schema;
+  std::string m_table;
+  std::string m_quoted_table;
+  int m_threads = 4;
+  uint64_t m_chunk_rows = 100000;
+  size_t m_max_printed_rows = 100;
+
+  uint64_t m_rows_estimate = 0;
+  // columns in the order they are selected: the primary key first
+  std::vector<mysqlshdk::db::Column> m_columns;
+  std::vector<std::string> m_column_names;
+  std::vector<uint32_t> m_key_fields;
+  std::string m_select;
+  std::string m_order_by;
+
+  // first column of the primary key, used to create chunks, empty if its type
+  // does not allow that
+  std::string m_chunk_key;
+  mysqlshdk::db::Type m_chunk_key_type = mysqlshdk::db::Type::Null;
+
+  std::vector<Chunk> m_chunks;
+
+  std::atomic<uint64_t> m_chunks_compared{0};
+  std::atomic<uint64_t> m_different_chunks{0};
+  std::atomic<uint64_t> m_missing_rows{0};
+  std::atomic<uint64_t> m_extra_rows{0};
+  std::atomic<uint64_t> m_different_rows{0};
+  std::atomic<bool> m_cancel{false};
+
+  std::mutex m_differences_mutex;
+  std::vector<std::string> m_differences;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  std::function<void(const std::string &)> m_print = nullptr;
+
+  mysqlshdk::utils::Profile_timer m_timer;
+};
+
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_TABLE_COMPARATOR_H_
@@ -0,0 +1,827 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/table_exporter.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <exception>
+#include <thread>
+#include <utility>
+#include "mysqlshdk/include/shellcore/console.h"
+#include "mysqlshdk/libs/utils/dtoa.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_json.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/interrupt_handler.h"
+#include "shellcore/shell_init.h"
+
+namespace mysqlsh {
+
+namespace {
+
+constexpr size_t k_write_buffer_size = 64 * 1024;
+
+// Signed keys are mapped to unsigned values with the same order, so chunks
+// can be computed using the same arithmetic for both.
+constexpr uint64_t k_sign_bit = 1ULL << 63;
+
+uint64_t to_key(const mysqlshdk::db::IRow &row, uint32_t index,
+                bool is_unsigned) {
+  return is_unsigned ? row.get_uint(index)
+                     : static_cast<uint64_t>(row.get_int(index)) ^ k_sign_bit;
+}
+
+std::string from_key(uint64_t key, bool is_unsigned) {
+  return is_unsigned ? std::to_string(key)
+                     : std::to_string(static_cast<int64_t>(key ^ k_sign_bit));
+}
+
+bool is_numeric(mysqlshdk::db::Type type) {
+  switch (type) {
+    case mysqlshdk::db::Type::Integer:
+    case mysqlshdk::db::Type::UInteger:
+    case mysqlshdk::db::Type::Float:
+    case mysqlshdk::db::Type::Double:
+    case mysqlshdk::db::Type::Decimal:
+    case mysqlshdk::db::Type::Bit:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * Returns text representation of a field which is not NULL, numbers are
+ * written to the buffer of 32 bytes, other values which cannot be accessed
+ * directly are copied to tmp.
+ */
+std::pair<const char *, size_t> field_text(const mysqlshdk::db::IRow &row,
+                                           uint32_t index,
+                                           mysqlshdk::db::Type type,
+                                           char *buffer, std::string *tmp) {
+  constexpr size_t k_buffer_size = 32;
+  size_t length = 0;
+
+  switch (type) {
+    case mysqlshdk::db::Type::Integer:
+      length = snprintf(buffer, k_buffer_size, "%" PRId64, row.get_int(index));
+      break;
+
+    case mysqlshdk::db::Type::UInteger:
+      length =
+          snprintf(buffer, k_buffer_size, "%" PRIu64, row.get_uint(index));
+      break;
+
+    case mysqlshdk::db::Type::Bit:
+      length = snprintf(buffer, k_buffer_size, "%" PRIu64, row.get_bit(index));
+      break;
+
+    case mysqlshdk::db::Type::Float:
+      length = my_gcvt(row.get_float(index), MY_GCVT_ARG_FLOAT,
+                       k_buffer_size - 1, buffer, NULL);
+      break;
+
+    case mysqlshdk::db::Type::Double:
+      length = my_gcvt(row.get_double(index), MY_GCVT_ARG_DOUBLE,
+                       k_buffer_size - 1, buffer, NULL);
+      break;
+
+    case mysqlshdk::db::Type::String:
+    case mysqlshdk::db::Type::Bytes:
+      return row.get_string_data(index);
+
+    default:
+      *tmp = row.get_as_string(index);
+      return {tmp->data(), tmp->length()};
+  }
+
+  return {buffer, length};
+}
+
+void append_json_string(const char *data, size_t length, std::string *out) {
+  static constexpr char k_hex[] = "0123456789abcdef";
+
+  out->push_back('"');
+
+  const char *end = data + length;
+
+  while (data < end) {
+    const char *special = std::find_if(data, end, [](char c) {
+      return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+    });
+
+    out->append(data, special - data);
+
+    if (special == end) break;
+
+    const unsigned char c = static_cast<unsigned char>(*special);
+
+    switch (c) {
+      case '"':
+        out->append("\\\"");
+        break;
+      case '\\':
+        out->append("\\\\");
+        break;
+      case '\b':
+        out->append("\\b");
+        break;
+      case '\f':
+        out->append("\\f");
+        break;
+      case '\n':
+        out->append("\\n");
+        break;
+      case '\r':
+        out->append("\\r");
+        break;
+      case '\t':
+        out->append("\\t");
+        break;
+      default:
+        out->append("\\u00");
+        out->push_back(k_hex[c >> 4]);
+        out->push_back(k_hex[c & 0xf]);
+        break;
+    }
+
+    data = special + 1;
+  }
+
+  out->push_back('"');
+}
+
+/**
+ * Checks if a column holds binary data: BINARY, VARBINARY, BLOB and spatial
+ * columns use the binary character set.
+ */
+bool is_binary_column(const mysqlshdk::db::Column &column) {
+  constexpr uint32_t k_binary_collation = 63;
+  const auto type = column.get_type();
+
+  return column.get_collation() == k_binary_collation &&
+         (type == mysqlshdk::db::Type::String ||
+          type == mysqlshdk::db::Type::Bytes ||
+          type == mysqlshdk::db::Type::Geometry);
+}
+
+}  // namespace
+
+Table_exporter::Table_exporter(
+    const std::shared_ptr<mysqlshdk::db::mysql::Session> &session)
+    : m_session(session) {}
+
+void Table_exporter::set_table(const std::string &schema,
+                               const std::string &table) {
+  m_schema = schema;
+  m_table = table;
+}
+
+Table_exporter::Format Table_exporter::to_format(const std::string &name) {
+  if (shcore::str_caseeq(name, "tsv")) return Format::TSV;
+  if (shcore::str_caseeq(name, "csv")) return Format::CSV;
+  if (shcore::str_caseeq(name, "ndjson")) return Format::NDJSON;
+
+  throw std::invalid_argument(
+      "The format must be one of: tsv, csv, ndjson, got: '" + name + "'.");
+}
+
+const char *Table_exporter::extension(Format format) {
+  switch (format) {
+    case Format::TSV:
+      return "tsv";
+    case Format::CSV:
+      return "csv";
+    case Format::NDJSON:
+      return "ndjson";
+  }
+
+  return "";
+}
+
+void Table_exporter::append_field(Format format, const char *data,
+                                  size_t length, std::string *out) {
+  const char *end = data + length;
+
+  switch (format) {
+    case Format::TSV:
+      // escaped the same way as expected by LOAD DATA with default options
+      while (data < end) {
+        const char *special =
+            std::find_if(data, end, [](char c) {
+              return c == '\t' || c == '\n' || c == '\r' || c == '\\' ||
+                     c == '\0';
+            });
+
+        out->append(data, special - data);
+
+        if (special == end) break;
+
+        out->push_back('\\');
+
+        switch (*special) {
+          case '\t':
+            out->push_back('t');
+            break;
+          case '\n':
+            out->push_back('n');
+            break;
+          case '\r':
+            out->push_back('r');
+            break;
+          case '\0':
+            out->push_back('0');
+            break;
+          default:
+            out->push_back(*special);
+            break;
+        }
+
+        data = special + 1;
+      }
+      break;
+
+    case Format::CSV: {
+      // RFC 4180 with the escaping used by LOAD DATA ... ESCAPED BY '\\', so
+      // NULL can be written as \N, empty strings are quoted for readability
+      // and the word NULL is quoted, as otherwise it would be loaded as NULL
+      const bool quoted =
+          length == 0 ||
+          (length == 4 && shcore::str_caseeq(data, "NULL", 4)) ||
+          std::find_if(data, end, [](char c) {
+            return c == ',' || c == '"' || c == '\n' || c == '\r';
+          }) != end;
+
+      if (quoted) out->push_back('"');
+
+      while (data < end) {
+        const char *special = std::find_if(data, end, [](char c) {
+          return c == '"' || c == '\\' || c == '\0';
+        });
+
+        out->append(data, special - data);
+
+        if (special == end) break;
+
+        switch (*special) {
+          case '"':
+            out->append("\"\"");
+            break;
+          case '\0':
+            out->append("\\0");
+            break;
+          default:
+            out->append("\\\\");
+            break;
+        }
+
+        data = special + 1;
+      }
+
+      if (quoted) out->push_back('"');
+      break;
+    }
+
+    case Format::NDJSON:
+      append_json_string(data, length, out);
+      break;
+  }
+}
+
+void Table_exporter::append_base64(const char *data, size_t length,
+                                   std::string *out) {
+  static constexpr char k_base64[] =
+      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  const auto bytes = reinterpret_cast<const unsigned char *>(data);
+  out->reserve(out->size() + (length + 2) / 3 * 4);
+
+  size_t i = 0;
+
+  for (; i + 2 < length; i += 3) {
+    const uint32_t n = bytes[i] << 16 | bytes[i + 1] << 8 | bytes[i + 2];
+    out->push_back(k_base64[n >> 18]);
+    out->push_back(k_base64[(n >> 12) & 0x3f]);
+    out->push_back(k_base64[(n >> 6) & 0x3f]);
+    out->push_back(k_base64[n & 0x3f]);
+  }
+
+  if (i < length) {
+    const bool two = i + 1 < length;
+    const uint32_t n = bytes[i] << 16 | (two ? bytes[i + 1] << 8 : 0);
+    out->push_back(k_base64[n >> 18]);
+    out->push_back(k_base64[(n >> 12) & 0x3f]);
+    out->push_back(two ? k_base64[(n >> 6) & 0x3f] : '=');
+    out->push_back('=');
+  }
+}
+
+void Table_exporter::run() {
+  m_timer.stage_begin("Exporting table");
+
+  read_table_info();
+
+  shcore::create_directory(m_output_dir);
+
+  // one session is used to read the table metadata, the data is read by the
+  // sessions of the workers
+  auto sessions = open_sessions(static_cast<size_t>(std::max(m_threads, 1)));
+
+  start_snapshot(sessions);
+  create_chunks(sessions[0]);
+
+  // there's no need to keep more sessions than chunks
+  if (sessions.size() > m_chunks.size()) sessions.resize(m_chunks.size());
+
+  std::atomic<bool> cancel{false};
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> finished{0};
+  std::vector<std::exception_ptr> errors(sessions.size());
+  std::vector<std::thread> threads;
+
+  {
+    shcore::Interrupt_handler intr_handler([&cancel]() -> bool {
+      cancel = true;
+      return false;
+    });
+
+    for (size_t i = 0; i < sessions.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        mysqlsh::thread_init();
+
+        try {
+          for (size_t chunk = next_chunk++; chunk < m_chunks.size() && !cancel;
+               chunk = next_chunk++) {
+            export_chunk(sessions[i], &m_chunks[chunk], cancel);
+          }
+        } catch (...) {
+          errors[i] = std::current_exception();
+          cancel = true;
+        }
+
+        mysqlsh::thread_end();
+        ++finished;
+      });
+    }
+
+    uint64_t reported = 0;
+
+    while (finished < threads.size()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      const uint64_t exported = m_rows_exported;
+
+      if (m_print && exported != reported) {
+        m_print(".. " + std::to_string(exported));
+        reported = exported;
+      }
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto &session : sessions) session->close();
+
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+
+  if (cancel) throw shcore::cancelled("Table export cancelled.");
+
+  write_manifest();
+}
+
+void Table_exporter::read_table_info() {
+  auto result = m_session->queryf(
+      "SELECT TABLE_ROWS FROM information_schema.tables WHERE "
+      "TABLE_SCHEMA = ? AND TABLE_NAME = ?",
+      m_schema, m_table);
+  auto row = result->fetch_one();
+
+  if (!row) {
+    throw std::runtime_error("Table " + shcore::quote_identifier(m_schema) +
+                             "." + shcore::quote_identifier(m_table) +
+                             " does not exist.");
+  }
+
+  m_rows_estimate = row->is_null(0) ? 0 : row->get_uint(0);
+
+  const std::string table = shcore::quote_identifier(m_schema) + "." +
+                            shcore::quote_identifier(m_table);
+
+  result = m_session->query("SELECT * FROM " + table + " LIMIT 0");
+  m_columns = result->get_metadata();
+
+  std::string columns;
+  m_json_names.clear();
+  m_binary_columns.clear();
+
+  for (const auto &column : m_columns) {
+    if (!columns.empty()) columns.append(",");
+    columns.append(shcore::quote_identifier(column.get_column_name()));
+
+    std::string name;
+    append_json_string(column.get_column_name().data(),
+                       column.get_column_name().length(), &name);
+    m_json_names.emplace_back(name + ":");
+    m_binary_columns.push_back(is_binary_column(column));
+  }
+
+  m_select = "SELECT " + columns + " FROM " + table;
+
+  // only a primary key on a single integer column is used to create chunks
+  result = m_session->queryf(
+      "SELECT COLUMN_NAME FROM information_schema.statistics WHERE "
+      "TABLE_SCHEMA = ? AND TABLE_NAME = ? AND INDEX_NAME = 'PRIMARY' "
+      "ORDER BY SEQ_IN_INDEX",
+      m_schema, m_table);
+
+  std::vector<std::string> key;
+  while ((row = result->fetch_one())) key.emplace_back(row->get_string(0));
+
+  m_key.clear();
+
+  if (key.size() == 1) {
+    for (const auto &column : m_columns) {
+      if (column.get_column_name() == key[0] &&
+          (column.get_type() == mysqlshdk::db::Type::Integer ||
+           column.get_type() == mysqlshdk::db::Type::UInteger)) {
+        m_key = key[0];
+        m_key_unsigned = column.get_type() == mysqlshdk::db::Type::UInteger;
+      }
+    }
+  }
+
+  if (m_key.empty() && m_threads > 1) {
+    mysqlsh::current_console()->print_warning(
+        "Table " + table +
+        " does not have a primary key on a single integer column, it will be "
+        "exported using a single thread.");
+  }
+}
+
+std::vector<std::shared_ptr<mysqlshdk::db::mysql::Session>>
+Table_exporter::open_sessions(size_t count) {
+  std::vector<std::shared_ptr<mysqlshdk::db::mysql::Session>> sessions;
+
+  for (size_t i = 0; i < count; ++i) {
+    sessions.emplace_back(mysqlshdk::db::mysql::Session::create());
+    sessions.back()->connect(m_session->get_connection_options());
+  }
+
+  return sessions;
+}
+
+void Table_exporter::start_snapshot(
+    const std::vector<std::shared_ptr<mysqlshdk::db::mysql::Session>>
+        &sessions) {
+  m_snapshot = Snapshot();
+
+  if (!m_consistent) return;
+
+  // Transactions of all the sessions are started while changes to the table
+  // are blocked, so they all see the same data. The lock is held by a
+  // separate session, as starting a transaction releases the table locks.
+  auto lock = open_sessions(1)[0];
+
+  try {
+    lock->execute("FLUSH TABLES WITH READ LOCK");
+  } catch (const mysqlshdk::db::Error &e) {
+    log_info("FLUSH TABLES WITH READ LOCK failed: %s", e.what());
+
+    try {
+      lock->execute("LOCK TABLES " + shcore::quote_identifier(m_schema) + "." +
+                    shcore::quote_identifier(m_table) + " READ");
+    } catch (const mysqlshdk::db::Error &e) {
+      log_warning("LOCK TABLES failed: %s", e.what());
+      lock.reset();
+      mysqlsh::current_console()->print_warning(
+          "Unable to lock the table, chunks will not be exported from a "
+          "consistent snapshot: " +
+          std::string(e.what()));
+    }
+  }
+
+  for (const auto &session : sessions) {
+    session->execute("SET SESSION TRANSACTION ISOLATION LEVEL REPEATABLE READ");
+    session->execute("START TRANSACTION WITH CONSISTENT SNAPSHOT");
+  }
+
+  if (!lock) return;
+
+  m_snapshot.consistent = true;
+
+  try {
+    auto result = lock->query("SELECT @@GLOBAL.gtid_executed");
+    if (auto row = result->fetch_one()) {
+      if (!row->is_null(0)) m_snapshot.gtid_executed = row->get_string(0);
+    }
+
+    result = lock->query("SHOW MASTER STATUS");
+    if (auto row = result->fetch_one()) {
+      m_snapshot.binlog_file = row->get_string(0);
+      m_snapshot.binlog_position = row->get_uint(1);
+    }
+  } catch (const mysqlshdk::db::Error &e) {
+    // binary log coordinates are informational only
+    log_warning("Unable to read binary log coordinates: %s", e.what());
+  }
+
+  lock->execute("UNLOCK TABLES");
+  lock->close();
+}
+
+std::string Table_exporter::encode_file_name(const std::string &name) {
+  static constexpr char k_digits[] = "0123456789ABCDEF";
+  std::string encoded;
+
+  for (const auto c : name) {
+    const auto byte = static_cast<unsigned char>(c);
+
+    if (isalnum(byte) || byte == '_' || byte == '-' || byte >= 0x80) {
+      encoded += c;
+    } else {
+      encoded += '%';
+      encoded += k_digits[byte >> 4];
+      encoded += k_digits[byte & 0xF];
+    }
+  }
+
+  return encoded;
+}
+
+void Table_exporter::create_chunks(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session) {
+  m_chunks.clear();
+
+  const std::string base = encode_file_name(m_table) + "@";
+  const std::string ext = std::string(".") + extension(m_format);
+
+  if (!m_key.empty() && m_threads > 1 && m_chunk_rows > 0 &&
+      m_rows_estimate > m_chunk_rows) {
+    const std::string key = shcore::quote_identifier(m_key);
+
+    // executed in the snapshot, so chunks cover all the rows
+    auto result = session->query(
+        "SELECT MIN(" + key + "), MAX(" + key + ") FROM " +
+        shcore::quote_identifier(m_schema) + "." +
+        shcore::quote_identifier(m_table));
+    auto row = result->fetch_one();
+
+    if (row && !row->is_null(0)) {
+      const uint64_t min = to_key(*row, 0, m_key_unsigned);
+      const uint64_t max = to_key(*row, 1, m_key_unsigned);
+      const uint64_t count =
+          (m_rows_estimate + m_chunk_rows - 1) / m_chunk_rows;
+      const uint64_t step = (max - min) / count + 1;
+
+      for (uint64_t begin = min;; begin += step) {
+        const uint64_t end = max - begin < step ? max : begin + step - 1;
+
+        Chunk chunk;
+        chunk.begin = from_key(begin, m_key_unsigned);
+        chunk.end = from_key(end, m_key_unsigned);
+        m_chunks.emplace_back(std::move(chunk));
+
+        if (end == max) break;
+      }
+
+      // rows outside of the range can only be added after the snapshot
+      m_chunks.front().begin.clear();
+      m_chunks.back().end.clear();
+    }
+  }
+
+  if (m_chunks.empty()) m_chunks.emplace_back();
+
+  for (size_t i = 0; i < m_chunks.size(); ++i) {
+    m_chunks[i].file = base + std::to_string(i) + ext;
+  }
+}
+
+void Table_exporter::export_chunk(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session, Chunk *chunk,
+    const std::atomic<bool> &cancel) {
+  const auto path = shcore::path::join_path(m_output_dir, chunk->file);
+  std::unique_ptr<FILE, int (*)(FILE *)> file(fopen(path.c_str(), "wb"),
+                                              &fclose);
+
+  if (!file) {
+    throw std::runtime_error("Cannot open file '" + path +
+                             "' for writing: " + shcore::errno_to_string(errno));
+  }
+
+  std::string sql = m_select;
+
+  if (!chunk->begin.empty() || !chunk->end.empty()) {
+    const std::string key = shcore::quote_identifier(m_key);
+    sql += " WHERE ";
+    if (!chunk->begin.empty()) sql += key + " >= " + chunk->begin;
+    if (!chunk->begin.empty() && !chunk->end.empty()) sql += " AND ";
+    if (!chunk->end.empty()) sql += key + " <= " + chunk->end;
+  }
+
+  std::string buffer;
+  buffer.reserve(k_write_buffer_size * 2);
+
+  const auto write = [&]() {
+    if (fwrite(buffer.data(), 1, buffer.size(), file.get()) != buffer.size()) {
+      throw std::runtime_error("Failed to write to file '" + path +
+                               "': " + shcore::errno_to_string(errno));
+    }
+
+    chunk->bytes += buffer.size();
+    buffer.clear();
+  };
+
+  // rows are streamed, the result is not buffered by the client
+  auto result = session->query(sql);
+
+  while (const auto row = result->fetch_one()) {
+    if (cancel) return;
+
+    write_row(*row, &buffer);
+
+    ++chunk->rows;
+    ++m_rows_exported;
+
+    if (buffer.size() >= k_write_buffer_size) write();
+  }
+
+  write();
+
+  if (fclose(file.release()) != 0) {
+    throw std::runtime_error("Failed to write to file '" + path +
+                             "': " + shcore::errno_to_string(errno));
+  }
+}
+
+void Table_exporter::write_row(const mysqlshdk::db::IRow &row,
+                               std::string *out) const {
+  char buffer[32];
+  std::string tmp;
+
+  if (m_format == Format::NDJSON) out->push_back('{');
+
+  for (uint32_t i = 0; i < m_columns.size(); ++i) {
+    const auto type = m_columns[i].get_type();
+
+    if (m_format == Format::NDJSON) {
+      if (i > 0) out->push_back(',');
+      out->append(m_json_names[i]);
+
+      if (row.is_null(i)) {
+        out->append("null");
+      } else {
+        const auto text = field_text(row, i, type, buffer, &tmp);
+
+        // numbers and JSON documents are written as they are
+        if (is_numeric(type) || type == mysqlshdk::db::Type::Json) {
+          out->append(text.first, text.second);
+        } else if (m_binary_columns[i]) {
+          out->push_back('"');
+          append_base64(text.first, text.second, out);
+          out->push_back('"');
+        } else {
+          append_field(m_format, text.first, text.second, out);
+        }
+      }
+    } else {
+      if (i > 0) out->push_back(m_format == Format::TSV ? '\t' : ',');
+
+      if (row.is_null(i)) {
+        out->append("\\N");
+      } else {
+        const auto text = field_text(row, i, type, buffer, &tmp);
+        append_field(m_format, text.first, text.second, out);
+      }
+    }
+  }
+
+  if (m_format == Format::NDJSON) out->push_back('}');
+  out->push_back('\n');
+}
+
+void Table_exporter::write_manifest() {
+  shcore::JSON_dumper dumper(true);
+  uint64_t rows = 0;
+
+  dumper.start_object();
+  dumper.append_string("schema", m_schema);
+  dumper.append_string("table", m_table);
+  dumper.append_string("format", extension(m_format));
+
+  dumper.append_string("chunkKey");
+  if (m_key.empty())
+    dumper.append_null();
+  else
+    dumper.append_string(m_key);
+
+  dumper.append_bool("consistent", m_snapshot.consistent);
+  dumper.append_string("gtidExecuted", m_snapshot.gtid_executed);
+  dumper.append_string("binlogFile", m_snapshot.binlog_file);
+  dumper.append_uint64("binlogPosition", m_snapshot.binlog_position);
+
+  dumper.append_string("columns");
+  dumper.start_array();
+  for (const auto &column : m_columns) {
+    dumper.start_object();
+    dumper.append_string("name", column.get_column_name());
+    dumper.append_string("type", mysqlshdk::db::to_string(column.get_type()));
+    dumper.end_object();
+  }
+  dumper.end_array();
+
+  dumper.append_string("chunks");
+  dumper.start_array();
+  for (const auto &chunk : m_chunks) {
+    dumper.start_object();
+    dumper.append_string("file", chunk.file);
+
+    dumper.append_string("begin");
+    if (chunk.begin.empty())
+      dumper.append_null();
+    else
+      dumper.append_json(chunk.begin);
+
+    dumper.append_string("end");
+    if (chunk.end.empty())
+      dumper.append_null();
+    else
+      dumper.append_json(chunk.end);
+
+    dumper.append_uint64("rows", chunk.rows);
+    dumper.append_uint64("bytes", chunk.bytes);
+    dumper.end_object();
+
+    rows += chunk.rows;
+  }
+  dumper.end_array();
+
+  dumper.append_uint64("rows", rows);
+  dumper.end_object();
+
+  const auto path = shcore::path::join_path(
+      m_output_dir, encode_file_name(m_table) + ".manifest.json");
+
+  if (!shcore::create_file(path, dumper.str() + "\n")) {
+    throw std::runtime_error("Failed to write manifest file '" + path +
+                             "': " + shcore::errno_to_string(errno));
+  }
+}
+
+void Table_exporter::print_stats() {
+  using mysqlshdk::utils::format_bytes;
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_bytes;
+  using mysqlshdk::utils::format_throughput_items;
+
+  m_timer.stage_end();
+
+  if (!m_print) return;
+
+  const double seconds = m_timer.total_seconds_ellapsed();
+  uint64_t bytes = 0;
+  for (const auto &chunk : m_chunks) bytes += chunk.bytes;
+
+  m_print("\nExported " + std::to_string(m_rows_exported) + " rows (" +
+          format_bytes(bytes) + ") to " + std::to_string(m_chunks.size()) +
+          (m_chunks.size() == 1 ? " file" : " files") + " in " +
+          format_seconds(seconds) + " (" +
+          format_throughput_items("row", "rows", m_rows_exported, seconds) +
+          ", " + format_throughput_bytes(bytes, seconds) + ")\n");
+}
+
+}  // namespace mysqlsh
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_TABLE_EXPORTER_H_
+#define MODULES_UTIL_TABLE_EXPORTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/row.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+
+namespace mysqlsh {
+
+/**
+ * Exports contents of a table to a set of files.
+ *
+ * If the table has an integer primary key, it is split into ranges of the key
+ * values (chunks), each chunk is written to its own file and the chunks are
+ * read concurrently using multiple classic protocol sessions. All sessions
+ * read from the same consistent snapshot, established while the table is
+ * locked. A JSON manifest describing the files, the columns and the
+ * replication coordinates of the snapshot is written once all the chunks are
+ * exported.
+ */
+class Table_exporter {
+ public:
+  enum class Format { TSV, CSV, NDJSON };
+
+  /**
+   * @param session session used to read the table metadata, its connection
+   *        options are used to open the sessions which read the data
+   */
+  explicit Table_exporter(
+      const std::shared_ptr<mysqlshdk::db::mysql::Session> &session);
+
+  Table_exporter(const Table_exporter &) = delete;
+  Table_exporter &operator=(const Table_exporter &) = delete;
+
+  void set_table(const std::string &schema, const std::string &table);
+
+  /**
+   * Directory where the files are written, it is created if it does not exist.
+   */
+  void set_output_dir(const std::string &dir) { m_output_dir = dir; }
+
+  void set_format(Format format) { m_format = format; }
+
+  /**
+   * Number of threads (and sessions) reading the chunks.
+   */
+  void set_threads(int threads) { m_threads = threads; }
+
+  /**
+   * Approximate number of rows in each chunk.
+   */
+  void set_chunk_rows(uint64_t rows) { m_chunk_rows = rows; }
+
+  /**
+   * If false, the table is not locked and each chunk is read in its own
+   * snapshot.
+   */
+  void set_consistent(bool consistent) { m_consistent = consistent; }
+
+  void set_print_callback(
+      const std::function<void(const std::string &)> &callback) {
+    m_print = callback;
+  }
+
+  void run();
+
+  void print_stats();
+
+  static Format to_format(const std::string &name);
+  static const char *extension(Format format);
+
+  /**
+   * Encodes the name of a table, so that it can be used as a file name.
+   *
+   * Bytes other than ASCII letters, digits, '_', '-' and the ones of non-ASCII
+   * UTF-8 characters are percent-encoded, this includes the path separators,
+   * the '.' and the '@' used to separate the chunk number.
+   */
+  static std::string encode_file_name(const std::string &name);
+
+  /**
+   * Appends a field value in the given format to the output line.
+   */
+  static void append_field(Format format, const char *data, size_t length,
+                           std::string *out);
+
+  /**
+   * Appends the data encoded as base64 (RFC 4648, with padding), used for the
+   * values of binary columns in NDJSON, which are not valid UTF-8 strings.
+   */
+  static void append_base64(const char *data, size_t length,
+                            std::string *out);
+
+ private:
+  struct Chunk {
+    // empty bounds mean that the range is not limited on that side
+    std::string begin;
+    std::string end;
+    std::string file;
+    uint64_t rows = 0;
+    uint64_t bytes = 0;
+  };
+
+  struct Snapshot {
+    bool consistent = false;
+    std::string gtid_executed;
+    std::string binlog_file;
+    uint64_t binlog_position = 0;
+  };
+
+  void read_table_info();
+
+  std::vector<std::shared_ptr<mysqlshdk::db::mysql::Session>> open_sessions(
+      size_t count);
+
+  void start_snapshot(
+      const std::vector<std::shared_ptr<mysqlshdk::db::mysql::Session>>
+          &sessions);
+
+  void create_chunks(const std::shared_ptr<mysqlshdk::db::ISession> &session);
+
+  void export_chunk(const std::shared_ptr<mysqlshdk::db::ISession> &session,
+                    Chunk *chunk, const std::atomic<bool> &cancel);
+
+  void write_row(const mysqlshdk::db::IRow &row, std::string *out) const;
+
+  void write_manifest();
+
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_session;
+
+  std::string m_schema;
+  std::string m_table;
+  std::string m_output_dir;
+  Format m_format = Format::TSV;
+  int m_threads = 4;
+  uint64_t m_chunk_rows = 1000000;
+  bool m_consistent = true;
+
+  uint64_t m_rows_estimate = 0;
+  std::vector<mysqlshdk::db::Column> m_columns;
+  // column names as JSON strings followed by a colon, used by NDJSON
+  std::vector<std::string> m_json_names;
+  // columns using the binary character set, base64 encoded by NDJSON
+  std::vector<bool> m_binary_columns;
+  std::string m_select;
+
+  // integer primary key used to create the chunks, empty if there is none
+  std::string m_key;
+  bool m_key_unsigned = false;
+
+  std::vector<Chunk> m_chunks;
+  Snapshot m_snapshot;
+
+  std::atomic<uint64_t> m_rows_exported{0};
+
+  std::function<void(const std::string &)> m_print = nullptr;
+
+  mysqlshdk::utils::Profile_timer m_timer;
+};
+
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_TABLE_EXPORTER_H_
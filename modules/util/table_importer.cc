@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "modules/util/table_importer.h"
+#include <errmsg.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <thread>
+#include "mysqlshdk/libs/utils/strformat.h"
+#include "mysqlshdk/libs/utils/utils_buffered_input.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "shellcore/interrupt_handler.h"
+#include "shellcore/shell_init.h"
+
+namespace mysqlsh {
+
+Table_importer::Table_importer(
+    const std::shared_ptr<mysqlshdk::db::mysql::Session> &session)
+    : m_session(session) {}
+
+void Table_importer::set_table(const std::string &schema,
+                               const std::string &table) {
+  m_schema = schema;
+  m_table = table;
+}
+
+namespace {
+
+/**
+ * Finds the end of the line containing the given position of a line which
+ * starts at begin.
+ *
+ * @returns position right after the new line character, or end if the line is
+ *          not terminated
+ */
+const char *find_line_end(const char *begin, const char *pos, const char *end,
+                          char escape, char quote) {
+  if (!quote) {
+    // new line characters preceded by an odd number of escape characters are
+    // part of the data
+    while (const auto nl =
+               static_cast<const char *>(memchr(pos, '\n', end - pos))) {
+      size_t escapes = 0;
+      while (escape && nl - escapes > begin && nl[-1 - escapes] == escape)
+        ++escapes;
+
+      if (escapes % 2 == 0) return nl + 1;
+      pos = nl + 1;
+    }
+
+    return end;
+  }
+
+  // quoted fields may contain new line characters, the whole line needs to
+  // be scanned, as done by LOAD DATA with OPTIONALLY ENCLOSED BY
+  bool field_start = true;
+  bool quoted = false;
+
+  for (const char *p = begin; p < end; ++p) {
+    const char c = *p;
+
+    if (escape && c == escape) {
+      ++p;
+      field_start = false;
+    } else if (quoted) {
+      if (c == quote) {
+        if (p + 1 < end && p[1] == quote)
+          ++p;
+        else if (p + 1 == end || p[1] == ',' || p[1] == '\n')
+          quoted = false;
+      }
+    } else if (c == '\n') {
+      if (p >= pos) return p + 1;
+      field_start = true;
+    } else {
+      quoted = field_start && c == quote;
+      field_start = c == ',';
+    }
+  }
+
+  return end;
+}
+
+}  // namespace
+
+std::vector<std::pair<size_t, size_t>> Table_importer::split_on_lines(
+    const char *data, size_t size, uint64_t bytes_per_chunk, char escape,
+    char quote) {
+  std::vector<std::pair<size_t, size_t>> ranges;
+  const size_t step = std::max<uint64_t>(bytes_per_chunk, 1);
+  size_t begin = 0;
+
+  while (begin < size) {
+    size_t end = size;
+
+    if (size - begin > step) {
+      // chunk ends after the new line which terminates the line containing
+      // the last byte of the requested range
+      end = find_line_end(data + begin, data + begin + step - 1, data + size,
+                          escape, quote) -
+            data;
+    }
+
+    ranges.emplace_back(begin, end);
+    begin = end;
+  }
+
+  return ranges;
+}
+
+int Table_importer::local_infile_init(void **ptr, const char *,
+                                      void *userdata) {
+  *ptr = userdata;
+  return 0;
+}
+
+int Table_importer::local_infile_read(void *ptr, char *buf,
+                                      unsigned int buf_len) {
+  auto worker = static_cast<Worker *>(ptr);
+
+  if (worker->owner->m_cancel) return -1;
+
+  const size_t bytes = std::min<size_t>(buf_len, worker->end - worker->pos);
+  memcpy(buf, worker->pos, bytes);
+  worker->pos += bytes;
+  worker->owner->m_bytes_loaded += bytes;
+
+  return static_cast<int>(bytes);
+}
+
+void Table_importer::local_infile_end(void *) {}
+
+int Table_importer::local_infile_error(void *, char *error_msg,
+                                       unsigned int error_msg_len) {
+  snprintf(error_msg, error_msg_len, "Table import cancelled.");
+  return CR_UNKNOWN_ERROR;
+}
+
+void Table_importer::check_server() {
+  const auto result = m_session->query("SELECT @@GLOBAL.local_infile");
+  const auto row = result->fetch_one();
+
+  if (!row || row->get_int(0) == 0) {
+    throw std::runtime_error(
+        "The 'local_infile' global system variable must be set to ON in the "
+        "target server, after the server is verified to be trusted.");
+  }
+}
+
+void Table_importer::run() {
+  m_timer.stage_begin("Importing table");
+
+  if (m_format == Format::NDJSON) {
+    throw std::invalid_argument(
+        "The ndjson format is not supported by the table import.");
+  }
+
+  check_server();
+
+  const std::string path = shcore::path::expand_user(m_file);
+
+  // the mapping is shared by all the workers, each one streams its chunks
+  // directly from the mapped memory
+  shcore::Buffered_input input;
+  input.open(path, true);
+
+  if (!input.is_mapped()) {
+    if (shcore::file_size(path) == 0) return;
+
+    throw std::runtime_error("Unable to map file '" + path +
+                             "' into memory, a regular file is required.");
+  }
+
+  const size_t size = shcore::file_size(path);
+  input.set_range(0, size);
+  const char *data = reinterpret_cast<const char *>(input.pos());
+
+  const auto chunks =
+      split_on_lines(data, size, m_bytes_per_chunk, '\\',
+                     m_format == Format::CSV ? '"' : '\0');
+  m_chunk_count = chunks.size();
+
+  m_load_sql = "LOAD DATA LOCAL INFILE " + shcore::quote_sql_string(path) +
+               " INTO TABLE " + shcore::quote_identifier(m_schema) + "." +
+               shcore::quote_identifier(m_table) + " CHARACTER SET utf8mb4 ";
+
+  if (m_format == Format::CSV) {
+    m_load_sql +=
+        "FIELDS TERMINATED BY ',' OPTIONALLY ENCLOSED BY '\"' "
+        "ESCAPED BY '\\\\' "
+        "LINES TERMINATED BY '\\n'";
+  } else {
+    m_load_sql +=
+        "FIELDS TERMINATED BY '\\t' ESCAPED BY '\\\\' "
+        "LINES TERMINATED BY '\\n'";
+  }
+
+  // there's no need to open more sessions than chunks
+  const size_t count = std::min(
+      chunks.size(), static_cast<size_t>(std::max(m_threads, 1)));
+
+  for (size_t i = 0; i < count; ++i) {
+    m_workers.emplace_back(shcore::make_unique<Worker>());
+    auto worker = m_workers.back().get();
+
+    mysqlshdk::db::mysql::Local_infile_callbacks callbacks;
+    callbacks.init = &Table_importer::local_infile_init;
+    callbacks.read = &Table_importer::local_infile_read;
+    callbacks.end = &Table_importer::local_infile_end;
+    callbacks.error = &Table_importer::local_infile_error;
+    callbacks.userdata = worker;
+
+    worker->owner = this;
+    worker->session = mysqlshdk::db::mysql::Session::create();
+    worker->session->set_local_infile_callbacks(callbacks);
+    worker->session->connect(m_session->get_connection_options());
+  }
+
+  std::atomic<size_t> next_chunk{0};
+  std::atomic<size_t> finished{0};
+  std::vector<std::exception_ptr> errors(m_workers.size());
+  std::vector<std::thread> threads;
+  std::atomic<bool> interrupted{false};
+
+  {
+    shcore::Interrupt_handler intr_handler([this, &interrupted]() -> bool {
+      interrupted = true;
+      m_cancel = true;
+      return false;
+    });
+
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+      threads.emplace_back([&, i]() {
+        mysqlsh::thread_init();
+
+        try {
+          for (size_t chunk = next_chunk++; chunk < chunks.size() && !m_cancel;
+               chunk = next_chunk++) {
+            load_chunk(m_workers[i].get(), data + chunks[chunk].first,
+                       chunks[chunk].second - chunks[chunk].first);
+          }
+        } catch (...) {
+          errors[i] = std::current_exception();
+          m_cancel = true;
+        }
+
+        mysqlsh::thread_end();
+        ++finished;
+      });
+    }
+
+    uint64_t reported = 0;
+
+    while (finished < threads.size()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+      const uint64_t loaded = m_bytes_loaded;
+
+      if (m_print && loaded != reported) {
+        m_print(".. " + mysqlshdk::utils::format_bytes(loaded));
+        reported = loaded;
+      }
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  for (const auto &worker : m_workers) worker->session->close();
+
+  // loads which were interrupted fail, these errors are not reported
+  if (interrupted) throw shcore::cancelled("Table import cancelled.");
+
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+void Table_importer::load_chunk(Worker *worker, const char *data,
+                                size_t size) {
+  mysqlshdk::utils::Profile_stage stage("Loading chunk");
+  worker->pos = data;
+  worker->end = data + size;
+
+  worker->timer.stage_begin("Loading chunk");
+  const auto result = worker->session->query(m_load_sql);
+  worker->timer.stage_end();
+
+  ++worker->chunks;
+  worker->bytes += size;
+  worker->rows += result->get_affected_row_count();
+  worker->warnings += result->get_warning_count();
+}
+
+void Table_importer::print_stats() {
+  using mysqlshdk::utils::format_bytes;
+  using mysqlshdk::utils::format_seconds;
+  using mysqlshdk::utils::format_throughput_bytes;
+  using mysqlshdk::utils::format_throughput_items;
+
+  m_timer.stage_end();
+
+  if (!m_print) return;
+
+  uint64_t chunks = 0;
+  uint64_t bytes = 0;
+  uint64_t rows = 0;
+  uint64_t warnings = 0;
+  std::string per_thread;
+
+  for (size_t i = 0; i < m_workers.size(); ++i) {
+    const auto &worker = *m_workers[i];
+    const double seconds = worker.timer.total_seconds_ellapsed();
+
+    chunks += worker.chunks;
+    bytes += worker.bytes;
+    rows += worker.rows;
+    warnings += worker.warnings;
+
+    per_thread += "Thread " + std::to_string(i) + ": " +
+                  std::to_string(worker.rows) + " rows (" +
+                  format_bytes(worker.bytes) + ") from " +
+                  std::to_string(worker.chunks) +
+                  (worker.chunks == 1 ? " chunk" : " chunks") + " in " +
+                  format_seconds(seconds) + " (" +
+                  format_throughput_items("row", "rows", worker.rows,
+                                          seconds) +
+                  ", " + format_throughput_bytes(worker.bytes, seconds) +
+                  ")\n";
+  }
+
+  const double seconds = m_timer.total_seconds_ellapsed();
+
+  m_print("\nImported " + std::to_string(rows) + " rows (" +
+          format_bytes(bytes) + ") from " + std::to_string(chunks) + " of " +
+          std::to_string(m_chunk_count) +
+          (m_chunk_count == 1 ? " chunk" : " chunks") + " in " +
+          format_seconds(seconds) + " (" +
+          format_throughput_items("row", "rows", rows, seconds) + ", " +
+          format_throughput_bytes(bytes, seconds) + ")\n" + per_thread +
+          "Total warnings: " + std::to_string(warnings) + "\n");
+}
+
+}  // namespace mysqlsh
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MODULES_UTIL_TABLE_IMPORTER_H_
+#define MODULES_UTIL_TABLE_IMPORTER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "modules/util/table_exporter.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/profiling.h"
+
+namespace mysqlsh {
+
+/**
+ * Imports contents of a text file into a table.
+ *
+ * The file is memory mapped and split into chunks aligned on line boundaries.
+ * The chunks are loaded concurrently using multiple classic protocol sessions,
+ * each chunk with its own LOAD DATA LOCAL INFILE statement, which reads the
+ * data directly from the mapped range of the file.
+ */
+class Table_importer {
+ public:
+  using Format = Table_exporter::Format;
+
+  /**
+   * @param session session used to verify the server settings, its connection
+   *        options are used to open the sessions which load the data
+   */
+  explicit Table_importer(
+      const std::shared_ptr<mysqlshdk::db::mysql::Session> &session);
+
+  Table_importer(const Table_importer &) = delete;
+  Table_importer &operator=(const Table_importer &) = delete;
+
+  void set_file(const std::string &path) { m_file = path; }
+
+  void set_table(const std::string &schema, const std::string &table);
+
+  /**
+   * Format of the file, as written by Table_exporter. NDJSON is not supported.
+   */
+  void set_format(Format format) { m_format = format; }
+
+  /**
+   * Number of threads (and sessions) loading the chunks.
+   */
+  void set_threads(int threads) { m_threads = threads; }
+
+  /**
+   * Approximate size of each chunk, chunks are extended to the end of the
+   * line.
+   */
+  void set_bytes_per_chunk(uint64_t bytes) { m_bytes_per_chunk = bytes; }
+
+  void set_print_callback(
+      const std::function<void(const std::string &)> &callback) {
+    m_print = callback;
+  }
+
+  void run();
+
+  void print_stats();
+
+  /**
+   * Splits data into byte ranges of about the given size, each range ends
+   * right after a new line character which terminates a line or at the end
+   * of the data. New line characters which are escaped or are inside of
+   * a quoted field do not terminate a line.
+   *
+   * @param escape escape character, 0 if there is none
+   * @param quote character optionally enclosing the fields, 0 if there is none
+   */
+  static std::vector<std::pair<size_t, size_t>> split_on_lines(
+      const char *data, size_t size, uint64_t bytes_per_chunk,
+      char escape = '\\', char quote = '\0');
+
+ private:
+  struct Worker {
+    Table_importer *owner = nullptr;
+    std::shared_ptr<mysqlshdk::db::mysql::Session> session;
+
+    // data of the chunk which is being loaded
+    const char *pos = nullptr;
+    const char *end = nullptr;
+
+    uint64_t chunks = 0;
+    uint64_t bytes = 0;
+    uint64_t rows = 0;
+    uint64_t warnings = 0;
+    mysqlshdk::utils::Profile_timer timer;
+  };
+
+  static int local_infile_init(void **ptr, const char *filename,
+                               void *userdata);
+  static int local_infile_read(void *ptr, char *buf, unsigned int buf_len);
+  static void local_infile_end(void *ptr);
+  static int local_infile_error(void *ptr, char *error_msg,
+                                unsigned int error_msg_len);
+
+  void check_server();
+
+  void load_chunk(Worker *worker, const char *data, size_t size);
+
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_session;
+
+  std::string m_file;
+  std::string m_schema;
+  std::string m_table;
+  Format m_format = Format::TSV;
+  int m_threads = 4;
+  uint64_t m_bytes_per_chunk = 50 * 1024 * 1024;
+
+  std::string m_load_sql;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  size_t m_chunk_count = 0;
+
+  std::atomic<uint64_t> m_bytes_loaded{0};
+  std::atomic<bool> m_cancel{false};
+
+  std::function<void(const std::string &)> m_print = nullptr;
+
+  mysqlshdk::utils::Profile_timer m_timer;
+};
+
+}  // namespace mysqlsh
+
+#endif  // MODULES_UTIL_TABLE_IMPORTER_H_
@@ -23,6 +23,8 @@
 
 #include <algorithm>
 #include <array>
+#include <cassert>
+#include <iterator>
 #include <map>
 #include <sstream>
 #include <utility>
@@ -36,6 +38,7 @@
 #include "mysqlshdk/libs/utils/utils_sqlstring.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 #include "mysqlshdk/libs/utils/utils_translate.h"
+#include "shellcore/shell_init.h"
 
 namespace mysqlsh {
 
@@ -941,19 +944,43 @@ Check_table_command::Check_table_command()
 
 std::vector<Upgrade_issue> Check_table_command::run(
     std::shared_ptr<mysqlshdk::db::ISession> session, const std::string &) {
+  std::vector<Upgrade_issue> issues;
+  for (const auto &tables : list_tables(session)) {
+    auto schema_issues = check_tables(session, tables);
+    std::move(schema_issues.begin(), schema_issues.end(),
+              std::back_inserter(issues));
+  }
+  return issues;
+}
+
+std::vector<Check_table_command::Table_list> Check_table_command::list_tables(
+    std::shared_ptr<mysqlshdk::db::ISession> session) const {
   // Needed for warnings related to triggers
   session->execute("FLUSH TABLES;");
 
-  std::vector<std::pair<std::string, std::string>> tables;
+  std::vector<Table_list> schemas;
+  std::map<std::string, size_t> schema_index;
   auto result = session->query(
       "SELECT TABLE_SCHEMA, TABLE_NAME FROM "
       "INFORMATION_SCHEMA.TABLES WHERE TABLE_SCHEMA not in "
       "('information_schema', 'performance_schema', 'sys')");
   const mysqlshdk::db::IRow *pair = nullptr;
-  while ((pair = result->fetch_one()) != nullptr)
-    tables.push_back(std::pair<std::string, std::string>(pair->get_string(0),
-                                                         pair->get_string(1)));
+  while ((pair = result->fetch_one()) != nullptr) {
+    std::string schema = pair->get_string(0);
+    auto it = schema_index.find(schema);
+    if (it == schema_index.end()) {
+      it = schema_index.emplace(schema, schemas.size()).first;
+      schemas.emplace_back();
+    }
+    schemas[it->second].emplace_back(std::move(schema), pair->get_string(1));
+  }
 
+  return schemas;
+}
+
+std::vector<Upgrade_issue> Check_table_command::check_tables(
+    std::shared_ptr<mysqlshdk::db::ISession> session,
+    const Table_list &tables) const {
   std::vector<Upgrade_issue> issues;
   for (const auto &pair : tables) {
     auto check_result =
@@ -1009,4 +1036,106 @@ bool register_manual_checks() {
 bool UNUSED_VARIABLE(reg_manual_checks) = register_manual_checks();
 }  // namespace
 
+Parallel_check_runner::Parallel_check_runner(
+    const std::vector<std::unique_ptr<Upgrade_check>> &checklist,
+    const std::vector<std::shared_ptr<mysqlshdk::db::ISession>> &sessions,
+    const std::string &server_version)
+    : m_results(checklist.size()), m_next_task(0), m_cancelled(false) {
+  assert(!sessions.empty());
+
+  for (size_t i = 0; i < checklist.size(); ++i) {
+    Upgrade_check *check = checklist[i].get();
+    Result *result = &m_results[i];
+
+    if (!check->is_runnable()) continue;
+
+    auto table_check = dynamic_cast<Check_table_command *>(check);
+    if (table_check) {
+      try {
+        result->tables = table_check->list_tables(sessions[0]);
+      } catch (...) {
+        result->error = std::current_exception();
+        continue;
+      }
+
+      // tables of each schema are checked by a separate task
+      for (size_t part = 0; part < result->tables.size(); ++part) {
+        m_tasks.push_back(
+            {[table_check, result,
+              part](std::shared_ptr<mysqlshdk::db::ISession> session) {
+               return table_check->check_tables(session, result->tables[part]);
+             },
+             result, part});
+      }
+      result->pending = result->tables.size();
+    } else {
+      m_tasks.push_back(
+          {[check,
+            server_version](std::shared_ptr<mysqlshdk::db::ISession> session) {
+             return check->run(session, server_version);
+           },
+           result, 0});
+      result->pending = 1;
+    }
+
+    result->issues.resize(result->pending);
+  }
+
+  for (const auto &session : sessions) {
+    m_threads.emplace_back([this, session]() {
+      mysqlsh::thread_init();
+      run_tasks(session);
+      mysqlsh::thread_end();
+    });
+  }
+}
+
+Parallel_check_runner::~Parallel_check_runner() {
+  m_cancelled = true;
+
+  for (auto &thread : m_threads) thread.join();
+}
+
+void Parallel_check_runner::run_tasks(
+    std::shared_ptr<mysqlshdk::db::ISession> session) {
+  while (!m_cancelled) {
+    const size_t index = m_next_task++;
+    if (index >= m_tasks.size()) break;
+
+    Task &task = m_tasks[index];
+    std::vector<Upgrade_issue> issues;
+    std::exception_ptr error;
+
+    try {
+      issues = task.run(session);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    task.result->issues[task.part] = std::move(issues);
+    if (error && !task.result->error) task.result->error = error;
+    --task.result->pending;
+    m_task_done.notify_all();
+  }
+}
+
+std::vector<Upgrade_issue> Parallel_check_runner::get_issues(size_t index) {
+  Result &result = m_results[index];
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task_done.wait(lock, [&result]() { return result.pending == 0; });
+  }
+
+  if (result.error) std::rethrow_exception(result.error);
+
+  // parts are merged in the order they were listed
+  std::vector<Upgrade_issue> issues;
+  for (auto &part : result.issues) {
+    std::move(part.begin(), part.end(), std::back_inserter(issues));
+  }
+  return issues;
+}
+
 } /* namespace mysqlsh */
@@ -24,10 +24,15 @@
 #ifndef MODULES_UTIL_UPGRADE_CHECK_H_
 #define MODULES_UTIL_UPGRADE_CHECK_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <forward_list>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 #include "mysqlshdk/libs/utils/version.h"
@@ -170,12 +175,27 @@ class Sql_upgrade_check : public Upgrade_check {
 
 class Check_table_command : public Upgrade_check {
  public:
+  using Table_list = std::vector<std::pair<std::string, std::string>>;
+
   Check_table_command();
 
   std::vector<Upgrade_issue> run(
       std::shared_ptr<mysqlshdk::db::ISession> session,
       const std::string &) override;
 
+  /**
+   * Flushes the tables and returns the ones to be checked, grouped by schema.
+   */
+  std::vector<Table_list> list_tables(
+      std::shared_ptr<mysqlshdk::db::ISession> session) const;
+
+  /**
+   * Runs CHECK TABLE ... FOR UPGRADE on each of the given tables.
+   */
+  std::vector<Upgrade_issue> check_tables(
+      std::shared_ptr<mysqlshdk::db::ISession> session,
+      const Table_list &tables) const;
+
   Upgrade_issue::Level get_level() const override {
     throw std::runtime_error("Unimplemented");
   }
@@ -210,6 +230,72 @@ class Manual_check : public Upgrade_check {
   Upgrade_issue::Level m_level;
 };
 
+/**
+ * Runs the runnable checks of a checklist using a pool of sessions, one thread
+ * per session. Check_table_command is split into one task per schema.
+ *
+ * Checks are started in the order of the checklist, so results can be
+ * reported in that order while the following checks are still running.
+ */
+class Parallel_check_runner {
+ public:
+  /**
+   * Starts running the checks.
+   *
+   * @param checklist checks to run, must outlive the runner
+   * @param sessions sessions used to run the checks, the first one is also
+   *        used to list the tables checked by Check_table_command
+   * @param server_version version of the server being checked
+   */
+  Parallel_check_runner(
+      const std::vector<std::unique_ptr<Upgrade_check>> &checklist,
+      const std::vector<std::shared_ptr<mysqlshdk::db::ISession>> &sessions,
+      const std::string &server_version);
+
+  Parallel_check_runner(const Parallel_check_runner &) = delete;
+  Parallel_check_runner &operator=(const Parallel_check_runner &) = delete;
+
+  /**
+   * Skips the checks which were not started yet and waits for the running
+   * ones.
+   */
+  ~Parallel_check_runner();
+
+  /**
+   * Waits for the check at the given position of the checklist.
+   *
+   * @returns the issues found by the check
+   * @throws the exception thrown by the check
+   */
+  std::vector<Upgrade_issue> get_issues(size_t index);
+
+ private:
+  struct Result {
+    std::vector<Check_table_command::Table_list> tables;
+    std::vector<std::vector<Upgrade_issue>> issues;
+    std::exception_ptr error;
+    size_t pending = 0;
+  };
+
+  struct Task {
+    std::function<std::vector<Upgrade_issue>(
+        std::shared_ptr<mysqlshdk::db::ISession>)>
+        run;
+    Result *result;
+    size_t part;
+  };
+
+  void run_tasks(std::shared_ptr<mysqlshdk::db::ISession> session);
+
+  std::vector<Result> m_results;
+  std::vector<Task> m_tasks;
+  std::atomic<size_t> m_next_task;
+  std::atomic<bool> m_cancelled;
+  std::mutex m_mutex;
+  std::condition_variable m_task_done;
+  std::vector<std::thread> m_threads;
+};
+
 } /* namespace mysqlsh */
 
 #endif  // MODULES_UTIL_UPGRADE_CHECK_H_
@@ -53,6 +53,7 @@ struct TYPES_COMMON_PUBLIC Interpreter_delegate {
     password = nullptr;
     print_error = nullptr;
     print_diag = nullptr;
+    flush = nullptr;
   }
 
   Interpreter_delegate(
@@ -62,13 +63,15 @@ struct TYPES_COMMON_PUBLIC Interpreter_delegate {
       Prompt_result (*password)(void *user_data, const char *prompt,
                                 std::string *ret_password),
       void (*print_error)(void *user_data, const char *text),
-      void (*print_diag)(void *user_data, const char *text)) {
+      void (*print_diag)(void *user_data, const char *text),
+      void (*flush)(void *user_data) = nullptr) {
     this->user_data = user_data;
     this->print = print;
     this->prompt = prompt;
     this->password = password;
     this->print_error = print_error;
     this->print_diag = print_diag;
+    this->flush = flush;
   }
 
   void *user_data;
@@ -79,6 +82,8 @@ struct TYPES_COMMON_PUBLIC Interpreter_delegate {
                             std::string *ret_password);
   void (*print_error)(void *user_data, const char *text);
   void (*print_diag)(void *user_data, const char *text);
+  // writes out any output buffered by print(), can be null
+  void (*flush)(void *user_data);
 };
 };  // namespace shcore
 
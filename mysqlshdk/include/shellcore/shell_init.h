@@ -38,6 +38,17 @@ void global_init();
  */
 void global_end();
 
+/*
+ * Call at the start of every thread, other than the one which called
+ * global_init(), that uses the shell library.
+ */
+void thread_init();
+
+/*
+ * Call before exiting a thread which called thread_init().
+ */
+void thread_end();
+
 }  // namespace mysqlsh
 
 #endif  // MYSQLSHDK_INCLUDE_SHELLCORE_SHELL_INIT_H_
@@ -30,6 +30,8 @@
 #define SHCORE_INTERACTIVE "interactive"
 #define SHCORE_SHOW_WARNINGS "showWarnings"
 #define SHCORE_BATCH_CONTINUE_ON_ERROR "batchContinueOnError"
+#define SHCORE_BATCH_STATEMENTS "batchStatements"
+#define SHCORE_BATCH_THREADS "batchThreads"
 #define SHCORE_USE_WIZARDS "useWizards"
 
 #define SHCORE_SANDBOX_DIR "sandboxDir"
@@ -46,6 +48,8 @@
 
 #define SHCORE_DEFAULT_COMPRESS "defaultCompress"
 
+#define SHCORE_PROFILE "profile"
+
 #include <stdlib.h>
 #include <iostream>
 #include <memory>
@@ -111,6 +115,8 @@ class Shell_options : public shcore::Options {
     bool wizards = true;
     bool admin_mode = false;
     std::string histignore;
+    int batch_statements = 1;
+    int batch_threads = 1;
     int history_max_size = 1000;
     bool history_autosave = false;
     enum { None, Primary, Secondary } redirect_session = None;
@@ -126,6 +132,7 @@ class Shell_options : public shcore::Options {
     Quiet_start quiet_start = Quiet_start::NOT_SET;
     bool show_column_type_info = false;
     bool default_compress = false;
+    bool profile = false;
 
     int exit_code = 0;
 
@@ -29,9 +29,14 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 #include "mysqlshdk/libs/db/result.h"
 #include "mysqlshdk/libs/utils/enumset.h"
 
+namespace shcore {
+class JSON_dumper;
+}  // namespace shcore
+
 namespace mysqlsh {
 namespace mysqlx {
 class SqlResult;
@@ -53,6 +58,8 @@ enum class Print_flag {
 using Print_flags =
     mysqlshdk::utils::Enum_set<Print_flag, Print_flag::PRINT_CTRL>;
 
+class Field_formatter;
+
 std::tuple<size_t, size_t> get_utf8_sizes(const char *text, size_t length,
                                           Print_flags flags);
 
@@ -76,9 +83,11 @@ class Resultset_dumper {
   void dump_records(std::string &output_stats);
   size_t dump_tabbed();
   size_t dump_table();
+  size_t stream_table(std::vector<Field_formatter> *fmt);
   size_t dump_vertical();
   size_t dump_documents();
   size_t dump_json(const std::string &item_label, bool is_doc_result);
+  void flush_json(shcore::JSON_dumper *dumper, bool all);
   void dump_warnings();
 };
 
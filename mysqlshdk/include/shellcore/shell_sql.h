@@ -26,7 +26,9 @@
 
 #include <memory>
 #include <stack>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "mysqlshdk/libs/db/result.h"
 #include "mysqlshdk/libs/db/session.h"
@@ -35,6 +37,14 @@
 #include "shellcore/ishell_core.h"
 #include "shellcore/shell_core.h"
 
+namespace mysqlshdk {
+namespace db {
+namespace mysql {
+class Session;
+}  // namespace mysql
+}  // namespace db
+}  // namespace mysqlshdk
+
 namespace shcore {
 
 struct Sql_result_info {
@@ -80,10 +90,25 @@ class SHCORE_PUBLIC Shell_sql : public Shell_language {
                      const Sql_result_info &)>
       _result_processor;
 
+  struct Batched_statement {
+    size_t offset;
+    size_t length;
+    std::string delimiter;
+    size_t line_num;
+  };
+
+  // Statements of a script waiting to be sent to the server together, each
+  // one followed by a ';' separator
+  std::string m_batch;
+  std::vector<Batched_statement> m_batch_statements;
+
   bool process_sql(const char *query_str, size_t query_len,
                    const std::string &delimiter, size_t line_num,
                    std::shared_ptr<mysqlshdk::db::ISession> session);
 
+  bool flush_batch(std::shared_ptr<mysqlshdk::db::mysql::Session> session,
+                   bool stop_on_error);
+
   std::pair<size_t, bool> handle_command(const char *p, size_t len, bool bol);
 
   void cmd_process_file(const std::vector<std::string> &params);
@@ -29,8 +29,19 @@
 namespace mysqlshdk {
 namespace db {
 
+namespace {
+std::vector<Type> column_types(const std::vector<Column> &metadata) {
+  std::vector<Type> types;
+  for (const auto &column : metadata) types.push_back(column.get_type());
+  return types;
+}
+}  // namespace
+
 Mutable_result::Mutable_result() {}
 
+Mutable_result::Mutable_result(const std::vector<Column> &metadata)
+    : _metadata(metadata), _rows(column_types(metadata)) {}
+
 Mutable_result::Mutable_result(const std::vector<Type> &types) {
   for (size_t i = 0; i < types.size(); ++i) {
     add_column(Column("", "dummy", "generic", "", "A" + std::to_string(i), "",
@@ -39,10 +50,10 @@ Mutable_result::Mutable_result(const std::vector<Type> &types) {
 }
 
 Mutable_result::Mutable_result(IResult *result)
-    : _metadata(result->get_metadata()) {
+    : _metadata(result->get_metadata()), _rows(column_types(_metadata)) {
   auto *row = result->fetch_one();
   while (row) {
-    _rows.emplace_back(std::unique_ptr<Row_copy>(new Row_copy(*row)));
+    _rows.append(*row);
     row = result->fetch_one();
   }
 }
@@ -54,32 +65,33 @@ void Mutable_result::add_column(const Column &column, size_t offset) {
     throw std::invalid_argument("Attempt to add column past table size");
 
   _metadata.insert(_metadata.begin() + offset, column);
-  for (auto &row : _rows) row->add_field(column.get_type(), offset);
+  _rows.add_field(column.get_type(), offset);
 }
 
 void Mutable_result::add_column(const Column &column) {
   _metadata.push_back(column);
-  for (auto &row : _rows)
-    row->add_field(column.get_type(), _metadata.size() - 1);
+  _rows.add_field(column.get_type(), _metadata.size() - 1);
 }
 
 void Mutable_result::add_row(std::unique_ptr<Mem_row> row) {
   if (_metadata.size() != row->num_fields())
     throw std::invalid_argument("row has wrong number of fields");
-  _rows.emplace_back(std::move(row));
+  _rows.append(*row);
 }
 
 const IRow *Mutable_result::fetch_one() {
   if (_rows.size() > _fetched_row_count)
-    return _rows[_fetched_row_count++].get();
+    return _rows.at(_fetched_row_count++);
   return nullptr;
 }
 
 void Mutable_result::add_from(IResult *result) {
   _metadata = result->get_metadata();
+  auto types = column_types(_metadata);
+  if (types != _rows.types()) _rows.reset(types);
   auto *row = result->fetch_one();
   while (row) {
-    _rows.emplace_back(new Row_copy(*row));
+    _rows.append(*row);
     row = result->fetch_one();
   }
 }
@@ -88,7 +100,7 @@ bool operator==(const Mutable_result &left, const Mutable_result &right) {
   if (left._metadata != right._metadata) return false;
   if (left._rows.size() != right._rows.size()) return false;
   for (std::size_t i = 0; i < left._rows.size(); i++)
-    if (compare(*left._rows[i], *right._rows[i]) != 0) return false;
+    if (compare(*left._rows.at(i), *right._rows.at(i)) != 0) return false;
   return true;
 }
 
@@ -44,8 +44,7 @@ class Mutable_result : public IResult {
 
  public:
   Mutable_result();
-  explicit Mutable_result(const std::vector<Column> &metadata)
-      : _metadata(metadata) {}
+  explicit Mutable_result(const std::vector<Column> &metadata);
   explicit Mutable_result(const std::vector<Type> &types);
   explicit Mutable_result(IResult *result);
   ~Mutable_result();
@@ -82,9 +81,7 @@ class Mutable_result : public IResult {
     if (sizeof...(args) != _metadata.size())
       throw std::invalid_argument(
           "Mismatch between row size and data to append");
-    std::vector<Type> cols(_metadata.size());
-    for (size_t i = 0; i < cols.size(); ++i) cols[i] = _metadata[i].get_type();
-    _rows.emplace_back(new Mutable_row(cols, args...));
+    _rows.append(Mutable_row(_rows.types(), args...));
   }
 
   void reset() { _fetched_row_count = 0; }
@@ -108,7 +105,7 @@ class Mutable_result : public IResult {
 
  private:
   std::vector<Column> _metadata;
-  std::vector<std::unique_ptr<Mem_row>> _rows;
+  Row_batch _rows;
   std::vector<std::string> _gtids;
   size_t _fetched_row_count = 0;
 
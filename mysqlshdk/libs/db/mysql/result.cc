@@ -175,24 +175,12 @@ Result::~Result() {}
 
 const IRow *Result::fetch_one() {
   if (_pre_fetched) {
-    if (!_persistent_pre_fetch) {
-      if (!_pre_fetched_rows.empty()) {
-        if (_fetched_row_count > 0)  // free the previously fetched row
-          _pre_fetched_rows.pop_front();
-        if (!_pre_fetched_rows.empty()) {
-          // return the next row, but don't pop it yet otherwise it'll be freed
-          const IRow *row = &_pre_fetched_rows.front();
-          _fetched_row_count++;
-          return row;
-        }
-      }
-    } else {
-      if (_fetched_row_count < _pre_fetched_rows.size()) {
-        return &_pre_fetched_rows[_fetched_row_count++];
-      }
-    }
+    if (_fetched_row_count < _pre_fetched_rows.size())
+      return _pre_fetched_rows.at(_fetched_row_count++);
+
+    // rows which are not kept for rewind() are freed once all were read
+    if (!_persistent_pre_fetch) _pre_fetched_rows.clear();
   } else {
-    _row.reset();
     if (has_resultset()) {
       // Loads the first row
       std::shared_ptr<MYSQL_RES> res = _result.lock();
@@ -203,10 +191,13 @@ const IRow *Result::fetch_one() {
           unsigned long *lengths;
           lengths = mysql_fetch_lengths(res.get());
 
-          _row.reset(new Row(this, mysql_row, lengths));
+          if (!_row) _row.reset(new Row(this));
+          _row->reset(mysql_row, lengths);
 
           // Each read row increases the count
           _fetched_row_count++;
+
+          return _row.get();
         } else {
           if (auto session = _session.lock()) {
             int code = 0;
@@ -219,7 +210,6 @@ const IRow *Result::fetch_one() {
         }
       }
     }
-    return _row.get();
   }
 
   return nullptr;
@@ -296,9 +286,16 @@ bool Result::pre_fetch_rows(bool persistent) {
     _persistent_pre_fetch = persistent;
     _stop_pre_fetch = false;
     if (!has_resultset()) return false;
+
+    std::vector<Type> types;
+    for (const auto &column : _metadata) types.push_back(column.get_type());
+    _pre_fetched_rows.reset(types);
+    // rows exceeding the limit are buffered in a temporary file
+    _pre_fetched_rows.set_memory_limit(Row_batch::k_result_memory_limit);
+
     while (auto row = fetch_one()) {
       if (_stop_pre_fetch) return true;
-      _pre_fetched_rows.push_back(mysqlshdk::db::Row_copy(*row));
+      _pre_fetched_rows.append(*row);
     }
     _fetched_row_count = 0;
 
@@ -27,9 +27,10 @@
 #ifndef MYSQLSHDK_LIBS_DB_MYSQL_RESULT_H_
 #define MYSQLSHDK_LIBS_DB_MYSQL_RESULT_H_
 
+#include "mysqlshdk/libs/db/mysql/row.h"
 #include "mysqlshdk/libs/db/result.h"
+#include "mysqlshdk/libs/db/row_copy.h"
 
-#include <deque>
 #include <list>
 #include <memory>
 #include <string>
@@ -74,7 +75,7 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
          uint64_t last_insert_id, const char *info);
   void reset(std::shared_ptr<MYSQL_RES> res);
 
-  std::deque<mysqlshdk::db::Row_copy> _pre_fetched_rows;
+  mysqlshdk::db::Row_batch _pre_fetched_rows;
   // size_t _fetched_row_count = 0;
   // size_t _fetched_warning_count = 0;
   bool _stop_pre_fetch = false;
@@ -91,7 +92,7 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
 
   std::weak_ptr<mysqlshdk::db::mysql::Session_impl> _session;
   std::vector<Column> _metadata;
-  std::unique_ptr<IRow> _row;
+  std::unique_ptr<Row> _row;
   std::weak_ptr<MYSQL_RES> _result;
   std::vector<std::string> _gtids;
   mutable std::shared_ptr<Field_names> _field_names;
@@ -25,6 +25,7 @@
 #include <cerrno>
 #include <climits>  // C limit constants
 #include <cmath>    // HUGE_VAL
+#include <cstring>
 #include <limits>   // std::numeric_limits
 #include <string>
 #include <utility>
@@ -83,13 +84,11 @@ namespace mysqlshdk {
 namespace db {
 namespace mysql {
 
-Row::Row(Result *result, MYSQL_ROW row, const unsigned long *lengths)
-    : _result(*result), _row(row) {
-  // TODO(alfredo) there's actually no need to keep a copy of the lengths list
-  // because it is valid for as long as MYSQL_ROW is and both should become
-  // invalidated when the next row is fetched
-  for (size_t index = 0; index < result->get_metadata().size(); index++)
-    _lengths.push_back(lengths[index]);
+Row::Row(Result *result) : _result(*result) {}
+
+void Row::reset(MYSQL_ROW row, const unsigned long *lengths) {
+  _row = row;
+  _lengths = lengths;
 }
 
 #define FIELD_ERROR(index, msg) \
@@ -149,7 +148,15 @@ int64_t Row::get_int(uint32_t index) const {
   int64_t ret_val = 0;
 
   VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
-                        (ftype == Type::Decimal && !strchr(_row[index], '.'))));
+                        (ftype == Type::Decimal &&
+                         !memchr(_row[index], '.', _lengths[index]))));
+
+  // fast path, errors are reported by the code below
+  if (shcore::str_to_int64(_row[index], _row[index] + _lengths[index],
+                           &ret_val))
+    return ret_val;
+
+  errno = 0;
 
   if (_result.get_metadata()[index].is_unsigned()) {
     uint64_t unsigned_val = strtoull(_row[index], nullptr, 10);
@@ -172,7 +179,15 @@ uint64_t Row::get_uint(uint32_t index) const {
   uint64_t ret_val = 0;
 
   VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
-                        (ftype == Type::Decimal && !strchr(_row[index], '.'))));
+                        (ftype == Type::Decimal &&
+                         !memchr(_row[index], '.', _lengths[index]))));
+
+  // fast path, errors are reported by the code below
+  if (shcore::str_to_uint64(_row[index], _row[index] + _lengths[index],
+                            &ret_val))
+    return ret_val;
+
+  errno = 0;
 
   if (_result.get_metadata()[index].is_unsigned()) {
     ret_val = strtoull(_row[index], nullptr, 10);
@@ -205,6 +220,11 @@ float Row::get_float(uint32_t index) const {
   VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Double ||
                         ftype == Type::Decimal));
 
+  if (shcore::str_to_float(_row[index], _row[index] + _lengths[index],
+                           &ret_val))
+    return ret_val;
+
+  errno = 0;
   ret_val = strtof(_row[index], nullptr);
   if (errno == ERANGE && (ret_val == HUGE_VAL || ret_val == -HUGE_VAL))
     throw FIELD_ERROR(index, "float value out of the allowed range");
@@ -217,6 +237,11 @@ double Row::get_double(uint32_t index) const {
   VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Double ||
                         ftype == Type::Decimal));
 
+  if (shcore::str_to_double(_row[index], _row[index] + _lengths[index],
+                            &ret_val))
+    return ret_val;
+
+  errno = 0;
   ret_val = strtod(_row[index], nullptr);
   if (errno == ERANGE && (ret_val == HUGE_VAL || ret_val == -HUGE_VAL))
     throw FIELD_ERROR(index, "double value out of the allowed range");
@@ -62,11 +62,15 @@ class SHCORE_PUBLIC Row : public mysqlshdk::db::IRow {
 
  private:
   friend class Result;
-  Row(Result *result, MYSQL_ROW row, const unsigned long *lengths);
+  explicit Row(Result *result);
+
+  // The row data and lengths are owned by the MYSQL_RES, both are valid until
+  // the next row is fetched, the same Row object is reused for all the rows.
+  void reset(MYSQL_ROW row, const unsigned long *lengths);
 
   Result &_result;
-  MYSQL_ROW _row;
-  std::vector<uint64_t> _lengths;
+  MYSQL_ROW _row = nullptr;
+  const unsigned long *_lengths = nullptr;
 };
 
 }  // namespace mysql
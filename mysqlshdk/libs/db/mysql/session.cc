@@ -45,6 +45,7 @@ Session_impl::Session_impl() : _mysql(NULL) {}
 
 void Session_impl::connect(
     const mysqlshdk::db::Connection_options &connection_options) {
+  mysqlshdk::utils::Profile_stage stage("Classic connect");
   long flags = CLIENT_MULTI_RESULTS | CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS;
   _mysql = mysql_init(NULL);
 
@@ -99,6 +100,20 @@ void Session_impl::connect(
       _connection_options.get_compression())
     mysql_options(_mysql, MYSQL_OPT_COMPRESS, nullptr);
 
+  if (m_net_timeout > 0) {
+    mysql_options(_mysql, MYSQL_OPT_READ_TIMEOUT, &m_net_timeout);
+    mysql_options(_mysql, MYSQL_OPT_WRITE_TIMEOUT, &m_net_timeout);
+  }
+
+  if (m_local_infile.init) {
+    unsigned int local_infile = 1;
+    mysql_options(_mysql, MYSQL_OPT_LOCAL_INFILE, &local_infile);
+    mysql_set_local_infile_handler(_mysql, m_local_infile.init,
+                                   m_local_infile.read, m_local_infile.end,
+                                   m_local_infile.error,
+                                   m_local_infile.userdata);
+  }
+
   if (!mysql_real_connect(
           _mysql,
           _connection_options.has_host()
@@ -226,6 +241,7 @@ void Session_impl::execute(const char *sql, size_t len) {
 std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
                                                bool buffered) {
   if (_mysql == nullptr) throw std::runtime_error("Not connected");
+  mysqlshdk::utils::Profile_stage stage("Classic query");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("run_sql");
   if (_prev_result) {
@@ -241,9 +257,13 @@ std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
     mysql_free_result(trailing_result);
   }
 
-  if (mysql_real_query(_mysql, sql, len) != 0) {
-    throw Error(mysql_error(_mysql), mysql_errno(_mysql),
-                mysql_sqlstate(_mysql));
+  {
+    mysqlshdk::utils::Profile_stage execute_stage("Execute");
+
+    if (mysql_real_query(_mysql, sql, len) != 0) {
+      throw Error(mysql_error(_mysql), mysql_errno(_mysql),
+                  mysql_sqlstate(_mysql));
+    }
   }
 
   std::shared_ptr<Result> result(
@@ -251,7 +271,10 @@ std::shared_ptr<IResult> Session_impl::run_sql(const char *sql, size_t len,
                  mysql_warning_count(_mysql), mysql_insert_id(_mysql),
                  mysql_info(_mysql)));
 
-  prepare_fetch(result.get(), buffered);
+  {
+    mysqlshdk::utils::Profile_stage receive_stage("Receive result");
+    prepare_fetch(result.get(), buffered);
+  }
   timer.stage_end();
   result->set_execution_time(timer.total_seconds_ellapsed());
   return std::static_pointer_cast<IResult>(result);
@@ -263,6 +286,85 @@ static void free_result(T *result) {
   result = NULL;
 }
 
+void Session_impl::execute_batch(
+    const char *sql, size_t len, std::vector<std::shared_ptr<IResult>> *results,
+    bool keep_resultsets) {
+  if (_mysql == nullptr) throw std::runtime_error("Not connected");
+
+  if (_prev_result) {
+    _prev_result.reset();
+  } else {
+    MYSQL_RES *unread_result = mysql_use_result(_mysql);
+    mysql_free_result(unread_result);
+  }
+
+  // Discards any pending result
+  while (mysql_next_result(_mysql) == 0) {
+    MYSQL_RES *trailing_result = mysql_use_result(_mysql);
+    mysql_free_result(trailing_result);
+  }
+
+  // Multiple statements are only enabled while the batch is executed
+  if (mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON) != 0) {
+    throw Error(mysql_error(_mysql), mysql_errno(_mysql),
+                mysql_sqlstate(_mysql));
+  }
+
+  shcore::on_leave_scope restore_option([this]() {
+    if (_mysql)
+      mysql_set_server_option(_mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+  });
+
+  std::vector<std::shared_ptr<Result>> executed;
+  mysqlshdk::utils::Profile_stage stage("Classic batch");
+  mysqlshdk::utils::Profile_timer timer;
+  timer.stage_begin("execute_batch");
+
+  // mysql_real_query() reports the error of the first statement, the errors
+  // of the following ones are reported by mysql_next_result()
+  int status = mysql_real_query(_mysql, sql, len) == 0 ? 0 : 1;
+
+  while (status == 0) {
+    timer.stage_end();
+
+    std::shared_ptr<Result> result(
+        new Result(shared_from_this(), mysql_affected_rows(_mysql),
+                   mysql_warning_count(_mysql), mysql_insert_id(_mysql),
+                   mysql_info(_mysql)));
+
+    MYSQL_RES *data = mysql_store_result(_mysql);
+    if (data && keep_resultsets) {
+      // rows are copied into the result, since the following statements
+      // replace the data held by the client library
+      std::shared_ptr<MYSQL_RES> stored(data, &free_result<MYSQL_RES>);
+      result->reset(stored);
+      result->fetch_metadata();
+      result->pre_fetch_rows(false);
+    } else {
+      if (data) mysql_free_result(data);
+      result->reset(nullptr);
+    }
+    result->set_execution_time(timer.total_seconds_ellapsed());
+    executed.push_back(result);
+
+    timer = mysqlshdk::utils::Profile_timer();
+    timer.stage_begin("execute_batch");
+    status = mysql_next_result(_mysql);
+  }
+
+  // SHOW WARNINGS only reports the warnings of the last statement executed
+  for (size_t i = 0; i < executed.size(); i++) {
+    if (status > 0 || i + 1 < executed.size())
+      executed[i]->_fetched_warnings = true;
+    results->push_back(executed[i]);
+  }
+
+  if (status > 0) {
+    throw Error(mysql_error(_mysql), mysql_errno(_mysql),
+                mysql_sqlstate(_mysql));
+  }
+}
+
 bool Session_impl::next_resultset() {
   if (_prev_result) _prev_result.reset();
 
@@ -42,6 +42,21 @@
 namespace mysqlshdk {
 namespace db {
 namespace mysql {
+
+/**
+ * Callbacks providing the data sent by LOAD DATA LOCAL INFILE statements,
+ * instead of reading it from the file named in the statement. See
+ * mysql_set_local_infile_handler() for the description of each callback.
+ */
+struct Local_infile_callbacks {
+  int (*init)(void **ptr, const char *filename, void *userdata) = nullptr;
+  int (*read)(void *ptr, char *buf, unsigned int buf_len) = nullptr;
+  void (*end)(void *ptr) = nullptr;
+  int (*error)(void *ptr, char *error_msg,
+               unsigned int error_msg_len) = nullptr;
+  void *userdata = nullptr;
+};
+
 /*
  * Session implementation for the MySQL protocol.
  *
@@ -62,6 +77,9 @@ class Session_impl : public std::enable_shared_from_this<Session_impl> {
 
   std::shared_ptr<IResult> query(const char *sql, size_t len, bool buffered);
   void execute(const char *sql, size_t len);
+  void execute_batch(const char *sql, size_t len,
+                     std::vector<std::shared_ptr<IResult>> *results,
+                     bool keep_resultsets);
 
   void start_transaction();
   void commit();
@@ -161,6 +179,8 @@ class Session_impl : public std::enable_shared_from_this<Session_impl> {
   std::shared_ptr<MYSQL_RES> _prev_result;
   mysqlshdk::db::Connection_options _connection_options;
   std::unique_ptr<Error> m_last_error;
+  Local_infile_callbacks m_local_infile;
+  unsigned int m_net_timeout = 0;
 };
 
 class SHCORE_PUBLIC Session : public ISession,
@@ -190,6 +210,27 @@ class SHCORE_PUBLIC Session : public ISession,
     _impl->execute(sql, len);
   }
 
+  /**
+   * Executes several statements separated by ';' using a single round trip.
+   *
+   * A result is added to results for every statement executed. Execution
+   * stops at the first statement which fails, in that case the error is
+   * thrown and the size of results is the index of the failed statement.
+   *
+   * The data of statements returning a result set is discarded, unless
+   * keep_resultsets is true, in which case the rows are buffered in the
+   * corresponding result. Warnings can only be fetched from the result of the
+   * last statement, since the server keeps only the warnings of that one.
+   *
+   * Multiple statements are only enabled while the batch is executed, also if
+   * it fails, so other queries sent through the session cannot be stacked.
+   */
+  virtual void execute_batch(const char *sql, size_t len,
+                             std::vector<std::shared_ptr<IResult>> *results,
+                             bool keep_resultsets = false) {
+    _impl->execute_batch(sql, len, results, keep_resultsets);
+  }
+
   void close() override { _impl->close(); }
   const char *get_ssl_cipher() const override {
     return _impl->get_ssl_cipher();
@@ -211,6 +252,20 @@ class SHCORE_PUBLIC Session : public ISession,
 
   virtual const char *get_stats() { return _impl->get_stats(); }
 
+  /**
+   * Enables LOAD DATA LOCAL INFILE statements, their data is provided by the
+   * given callbacks. Needs to be called before connect().
+   */
+  void set_local_infile_callbacks(const Local_infile_callbacks &callbacks) {
+    _impl->m_local_infile = callbacks;
+  }
+
+  /**
+   * Sets the timeout in seconds of each read from and write to the server, 0
+   * means no timeout. Needs to be called before connect().
+   */
+  void set_net_timeout(unsigned int seconds) { _impl->m_net_timeout = seconds; }
+
   mysqlshdk::utils::Version get_server_version() const override {
     return _impl->get_server_version();
   }
@@ -82,7 +82,7 @@ class SHCORE_PUBLIC Result : public mysqlshdk::db::IResult,
 
   std::vector<Column> _metadata;
 
-  std::deque<mysqlshdk::db::Row_copy> _pre_fetched_rows;
+  mysqlshdk::db::Row_batch _pre_fetched_rows;
   std::unique_ptr<xcl::XQuery_result> _result;
   mutable std::shared_ptr<Field_names> _field_names;
 
@@ -229,22 +229,11 @@ Result::~Result() {
 
 const IRow *Result::fetch_one() {
   if (_pre_fetched) {
-    if (!_persistent_pre_fetch) {
-      if (!_pre_fetched_rows.empty()) {
-        if (_fetched_row_count > 0)  // free the previously fetched row
-          _pre_fetched_rows.pop_front();
-        if (!_pre_fetched_rows.empty()) {
-          // return the next row, but don't pop it yet otherwise it'll be freed
-          const IRow *row = &_pre_fetched_rows.front();
-          _fetched_row_count++;
-          return row;
-        }
-      }
-    } else {
-      if (_fetched_row_count < _pre_fetched_rows.size()) {
-        return &_pre_fetched_rows[_fetched_row_count++];
-      }
-    }
+    if (_fetched_row_count < _pre_fetched_rows.size())
+      return _pre_fetched_rows.at(_fetched_row_count++);
+
+    // rows which are not kept for rewind() are freed once all were read
+    if (!_persistent_pre_fetch) _pre_fetched_rows.clear();
   } else {
     // Loads the first row
     if (_result) {
@@ -276,12 +265,19 @@ bool Result::pre_fetch_rows(bool persistent) {
     _persistent_pre_fetch = persistent;
     _stop_pre_fetch = false;
     if (!_result->has_resultset()) return false;
+
+    std::vector<Type> types;
+    for (const auto &column : _metadata) types.push_back(column.get_type());
+    _pre_fetched_rows.reset(types);
+    // rows exceeding the limit are buffered in a temporary file
+    _pre_fetched_rows.set_memory_limit(Row_batch::k_result_memory_limit);
+
     Row wrapper(this);
     xcl::XError error;
     while (const ::xcl::XRow *row = _result->get_next_row(&error)) {
       if (_stop_pre_fetch) return true;
       wrapper.reset(row);
-      _pre_fetched_rows.push_back(Row_copy(wrapper));
+      _pre_fetched_rows.append(wrapper);
     }
     if (error) {
       std::stringstream msg;
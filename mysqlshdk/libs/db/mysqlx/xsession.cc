@@ -134,6 +134,7 @@ XSession_impl::XSession_impl() : m_prep_stmt_count(0) {
 }
 
 void XSession_impl::connect(const mysqlshdk::db::Connection_options &data) {
+  mysqlshdk::utils::Profile_stage stage("X connect");
   _mysql.reset(::xcl::create_session().release());
   if (_enable_trace) _trace_handler = do_enable_trace(_mysql.get());
 
@@ -456,19 +457,25 @@ std::shared_ptr<IResult> XSession_impl::after_query(
 
 std::shared_ptr<IResult> XSession_impl::query(const char *sql, size_t len,
                                               bool buffered) {
+  mysqlshdk::utils::Profile_stage stage("X query");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("query");
   before_query();
   xcl::XError error;
   std::unique_ptr<xcl::XQuery_result> xresult;
   {
+    mysqlshdk::utils::Profile_stage execute_stage("Execute");
     ::Mysqlx::Sql::StmtExecute stmt;
 
     stmt.set_stmt(sql, len);
     xresult = _mysql->get_protocol().execute_stmt(stmt, &error);
   }
   check_error_and_throw(error);
-  auto result = after_query(std::move(xresult), buffered);
+  std::shared_ptr<IResult> result;
+  {
+    mysqlshdk::utils::Profile_stage receive_stage("Receive result");
+    result = after_query(std::move(xresult), buffered);
+  }
   timer.stage_end();
   result->set_execution_time(timer.total_seconds_ellapsed());
   return result;
@@ -483,6 +490,7 @@ void XSession_impl::execute(const char *sql, size_t len) {
 std::shared_ptr<IResult> XSession_impl::execute_stmt(
     const std::string &ns, const std::string &stmt,
     const xcl::Arguments &args) {
+  mysqlshdk::utils::Profile_stage stage("X statement");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("execute_stmt");
   before_query();
@@ -498,6 +506,7 @@ std::shared_ptr<IResult> XSession_impl::execute_stmt(
 
 std::shared_ptr<IResult> XSession_impl::execute_crud(
     const ::Mysqlx::Crud::Insert &msg) {
+  mysqlshdk::utils::Profile_stage stage("X CRUD insert");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("Mysqlx::Crud::Insert");
   before_query();
@@ -514,6 +523,7 @@ std::shared_ptr<IResult> XSession_impl::execute_crud(
 std::shared_ptr<IResult> XSession_impl::execute_crud(
     const ::Mysqlx::Crud::Update &msg) {
   before_query();
+  mysqlshdk::utils::Profile_stage stage("X CRUD update");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("Mysqlx::Crud::Update");
   xcl::XError error;
@@ -528,6 +538,7 @@ std::shared_ptr<IResult> XSession_impl::execute_crud(
 
 std::shared_ptr<IResult> XSession_impl::execute_crud(
     const ::Mysqlx::Crud::Delete &msg) {
+  mysqlshdk::utils::Profile_stage stage("X CRUD delete");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("Mysqlx::Crud::Delete");
   before_query();
@@ -543,6 +554,7 @@ std::shared_ptr<IResult> XSession_impl::execute_crud(
 
 std::shared_ptr<IResult> XSession_impl::execute_crud(
     const ::Mysqlx::Crud::Find &msg) {
+  mysqlshdk::utils::Profile_stage stage("X CRUD find");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("Mysqlx::Crud::Find");
   before_query();
@@ -567,6 +579,7 @@ void XSession_impl::prepare_stmt(const ::Mysqlx::Prepare::Prepare &msg) {
 
 std::shared_ptr<IResult> XSession_impl::execute_prep_stmt(
     const ::Mysqlx::Prepare::Execute &msg) {
+  mysqlshdk::utils::Profile_stage stage("X prepared statement");
   mysqlshdk::utils::Profile_timer timer;
   timer.stage_begin("execute_prep_stmt");
   before_query();
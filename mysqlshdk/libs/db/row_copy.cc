@@ -24,8 +24,10 @@
 #include "mysqlshdk/libs/db/row_copy.h"
 #include <bitset>
 #include <cassert>
+#include <cerrno>
 #include <climits>  // C limit constants
 #include <cmath>    // HUGE_VAL
+#include <cstring>
 #include <limits>   // std::numeric_limits
 #include <memory>
 #include <stdexcept>
@@ -51,8 +53,7 @@ namespace db {
 
 #define GET_VALIDATE_TYPE(index, TYPE_CHECK)                                  \
   if (index >= num_fields()) throw FIELD_ERROR(index, "index out of bounds"); \
-  if (_data->fields[index] == nullptr)                                        \
-    throw FIELD_ERROR(index, "field is NULL");                                \
+  if (is_null(index)) throw FIELD_ERROR(index, "field is NULL");              \
   ftype = get_type(index);                                                    \
   if (!(TYPE_CHECK))                                                          \
     throw FIELD_ERROR1(index, "field type is %s", to_string(ftype).c_str());
@@ -312,5 +313,506 @@ void Mem_row::add_field(Type type) {
 }
 
 Mutable_row::~Mutable_row() {}
+
+namespace {
+// Size of the memory blocks used to store the rows of a Row_batch, rows
+// bigger than a quarter of it get a block of their own
+constexpr size_t k_batch_block_size = 64 * 1024;
+
+size_t null_bitmap_size(size_t field_count) { return (field_count + 7) / 8; }
+
+template <typename T>
+void append_value(std::string *buffer, const T &value) {
+  buffer->append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+/**
+ * Presents a row with an additional null field, used to change the layout of
+ * the rows in a Row_batch.
+ */
+class Row_with_null_field : public IRow {
+ public:
+  Row_with_null_field(const IRow &row, Type type, uint32_t offset)
+      : m_row(row), m_type(type), m_offset(offset) {}
+
+  uint32_t num_fields() const override { return m_row.num_fields() + 1; }
+
+  Type get_type(uint32_t index) const override {
+    return index == m_offset ? m_type : m_row.get_type(source(index));
+  }
+
+  bool is_null(uint32_t index) const override {
+    return index == m_offset || m_row.is_null(source(index));
+  }
+
+  std::string get_as_string(uint32_t index) const override {
+    return m_row.get_as_string(source(index));
+  }
+
+  std::string get_string(uint32_t index) const override {
+    return m_row.get_string(source(index));
+  }
+
+  int64_t get_int(uint32_t index) const override {
+    return m_row.get_int(source(index));
+  }
+
+  uint64_t get_uint(uint32_t index) const override {
+    return m_row.get_uint(source(index));
+  }
+
+  float get_float(uint32_t index) const override {
+    return m_row.get_float(source(index));
+  }
+
+  double get_double(uint32_t index) const override {
+    return m_row.get_double(source(index));
+  }
+
+  std::pair<const char *, size_t> get_string_data(
+      uint32_t index) const override {
+    return m_row.get_string_data(source(index));
+  }
+
+  uint64_t get_bit(uint32_t index) const override {
+    return m_row.get_bit(source(index));
+  }
+
+ private:
+  uint32_t source(uint32_t index) const {
+    return index > m_offset ? index - 1 : index;
+  }
+
+  const IRow &m_row;
+  Type m_type;
+  uint32_t m_offset;
+};
+}  // namespace
+
+constexpr size_t Row_batch::k_result_memory_limit;
+
+Row_batch::Row_batch(const std::vector<Type> &types) : m_types(types) {}
+
+void Row_batch::reset(const std::vector<Type> &types) {
+  clear();
+  m_types = types;
+}
+
+void Row_batch::clear() {
+  m_rows.clear();
+  m_blocks.clear();
+  m_block_next = nullptr;
+  m_block_free = 0;
+  m_memory_used = 0;
+
+  m_spilled_rows = 0;
+  m_spill_file.reset();
+  m_read_index = 0;
+  m_reading = false;
+  m_read_buffer.clear();
+  m_read_buffer.shrink_to_fit();
+}
+
+char *Row_batch::allocate(size_t size) {
+  if (size > k_batch_block_size / 4) {
+    m_blocks.emplace_back(new char[size]);
+    m_memory_used += size;
+    return m_blocks.back().get();
+  }
+
+  if (size > m_block_free) {
+    m_blocks.emplace_back(new char[k_batch_block_size]);
+    m_block_next = m_blocks.back().get();
+    m_block_free = k_batch_block_size;
+    m_memory_used += k_batch_block_size;
+  }
+
+  char *data = m_block_next;
+  m_block_next += size;
+  m_block_free -= size;
+  return data;
+}
+
+void Row_batch::append(const IRow &row) {
+  const uint32_t field_count = static_cast<uint32_t>(m_types.size());
+
+  if (row.num_fields() != field_count)
+    throw std::invalid_argument("row has wrong number of fields");
+
+  // The row is assembled in a reusable buffer, so it can be copied into a
+  // single chunk of the arena once its size is known
+  const size_t bitmap_size = null_bitmap_size(field_count);
+  const size_t header_size =
+      bitmap_size + (field_count + 1) * sizeof(uint32_t);
+  m_scratch.assign(header_size, '\0');
+
+  std::vector<uint32_t> offsets(field_count + 1);
+
+  for (uint32_t i = 0; i < field_count; i++) {
+    offsets[i] = static_cast<uint32_t>(m_scratch.size());
+
+    if (row.get_type(i) != m_types[i])
+      throw FIELD_ERROR1(i, "field type is %s",
+                         to_string(row.get_type(i)).c_str());
+
+    if (m_types[i] == Type::Null || row.is_null(i)) {
+      m_scratch[i / 8] |= static_cast<char>(1 << (i % 8));
+      continue;
+    }
+
+    switch (m_types[i]) {
+      case Type::Null:
+        break;
+
+      case Type::Integer:
+        append_value(&m_scratch, row.get_int(i));
+        break;
+
+      case Type::UInteger:
+        append_value(&m_scratch, row.get_uint(i));
+        break;
+
+      case Type::Float:
+        append_value(&m_scratch, row.get_float(i));
+        break;
+
+      case Type::Double:
+        append_value(&m_scratch, row.get_double(i));
+        break;
+
+      case Type::String:
+      case Type::Bytes: {
+        auto data = row.get_string_data(i);
+        m_scratch.append(data.first, data.second);
+        break;
+      }
+
+      case Type::Decimal:
+      case Type::Bit:
+        m_scratch.append(row.get_as_string(i));
+        break;
+
+      case Type::Date:
+      case Type::DateTime:
+      case Type::Time:
+      case Type::Geometry:
+      case Type::Json:
+      case Type::Enum:
+      case Type::Set:
+        m_scratch.append(row.get_string(i));
+        break;
+    }
+  }
+
+  offsets[field_count] = static_cast<uint32_t>(m_scratch.size());
+  memcpy(&m_scratch[bitmap_size], offsets.data(),
+         offsets.size() * sizeof(uint32_t));
+
+  char *data = allocate(m_scratch.size());
+  memcpy(data, m_scratch.data(), m_scratch.size());
+  m_rows.emplace_back(this, data);
+
+  if (m_memory_limit > 0 && m_memory_used > m_memory_limit) spill();
+}
+
+namespace {
+
+std::runtime_error spill_file_error(const char *operation) {
+  return std::runtime_error(std::string("Failed to ") + operation +
+                            " temporary file used to buffer rows: " +
+                            strerror(errno));
+}
+
+}  // namespace
+
+void Row_batch::spill() {
+  if (!m_spill_file) {
+    m_spill_file.reset(tmpfile());
+
+    if (!m_spill_file) throw spill_file_error("create");
+
+    setvbuf(m_spill_file.get(), nullptr, _IOFBF, k_batch_block_size);
+    fgetpos(m_spill_file.get(), &m_read_position);
+  }
+
+  FILE *file = m_spill_file.get();
+
+  // switching from reading to writing requires a seek
+  if (fseek(file, 0, SEEK_END) != 0) throw spill_file_error("seek in");
+  m_reading = false;
+
+  const size_t offsets = null_bitmap_size(m_types.size()) +
+                         m_types.size() * sizeof(uint32_t);
+
+  // each row is written as its size followed by the packed row, the last
+  // offset of the row holds its size
+  for (const auto &row : m_rows) {
+    uint32_t size;
+    memcpy(&size, row.m_data + offsets, sizeof(size));
+
+    if (fwrite(&size, sizeof(size), 1, file) != 1 ||
+        fwrite(row.m_data, size, 1, file) != 1)
+      throw spill_file_error("write to");
+  }
+
+  m_spilled_rows += m_rows.size();
+
+  m_rows.clear();
+  m_blocks.clear();
+  m_block_next = nullptr;
+  m_block_free = 0;
+  m_memory_used = 0;
+}
+
+const IRow *Row_batch::read_spilled(size_t index) const {
+  FILE *file = m_spill_file.get();
+
+  // the last row read is still in the buffer
+  if (m_read_index > 0 && index == m_read_index - 1) return &m_read_row;
+
+  if (index < m_read_index) {
+    // going back, start from the beginning
+    m_read_index = 0;
+    m_reading = false;
+    ::rewind(file);
+    fgetpos(file, &m_read_position);
+  }
+
+  if (!m_reading) {
+    if (fsetpos(file, &m_read_position) != 0) throw spill_file_error("seek in");
+    m_reading = true;
+  }
+
+  uint32_t size = 0;
+
+  for (; m_read_index <= index; ++m_read_index) {
+    if (fread(&size, sizeof(size), 1, file) != 1)
+      throw spill_file_error("read from");
+
+    if (m_read_index < index) {
+      if (fseek(file, size, SEEK_CUR) != 0) throw spill_file_error("seek in");
+    } else {
+      m_read_buffer.resize(size);
+
+      if (fread(&m_read_buffer[0], size, 1, file) != 1)
+        throw spill_file_error("read from");
+    }
+  }
+
+  fgetpos(file, &m_read_position);
+  m_read_row.m_data = m_read_buffer.data();
+
+  return &m_read_row;
+}
+
+void Row_batch::take(Row_batch *batch) {
+  clear();
+  m_types = std::move(batch->m_types);
+  m_blocks = std::move(batch->m_blocks);
+  m_block_next = batch->m_block_next;
+  m_block_free = batch->m_block_free;
+  m_memory_used = batch->m_memory_used;
+  m_spilled_rows = batch->m_spilled_rows;
+  m_spill_file = std::move(batch->m_spill_file);
+  for (const auto &row : batch->m_rows) m_rows.emplace_back(this, row.m_data);
+
+  if (m_spill_file) {
+    ::rewind(m_spill_file.get());
+    fgetpos(m_spill_file.get(), &m_read_position);
+  }
+
+  batch->clear();
+}
+
+void Row_batch::add_field(Type type, uint32_t offset) {
+  if (offset > m_types.size())
+    throw std::invalid_argument("Attempt to insert column past row size");
+
+  std::vector<Type> types(m_types);
+  types.insert(types.begin() + offset, type);
+
+  // The rows are repacked into a new batch which then takes over the storage
+  Row_batch batch(types);
+  batch.set_memory_limit(m_memory_limit);
+  for (size_t i = 0; i < size(); i++)
+    batch.append(Row_with_null_field(*at(i), type, offset));
+
+  take(&batch);
+}
+
+uint32_t Row_batch::Row::num_fields() const {
+  return static_cast<uint32_t>(m_batch->m_types.size());
+}
+
+Type Row_batch::Row::get_type(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return m_batch->m_types[index];
+}
+
+bool Row_batch::Row::is_null(uint32_t index) const {
+  VALIDATE_INDEX(index);
+  return (m_data[index / 8] & (1 << (index % 8))) != 0;
+}
+
+std::pair<const char *, size_t> Row_batch::Row::get_data(
+    uint32_t index) const {
+  uint32_t offsets[2];
+  memcpy(offsets,
+         m_data + null_bitmap_size(num_fields()) + index * sizeof(uint32_t),
+         sizeof(offsets));
+  return {m_data + offsets[0], offsets[1] - offsets[0]};
+}
+
+template <typename T>
+T Row_batch::Row::get(uint32_t index) const {
+  T value;
+  memcpy(&value, get_data(index).first, sizeof(value));
+  return value;
+}
+
+template <>
+std::string Row_batch::Row::get<std::string>(uint32_t index) const {
+  auto data = get_data(index);
+  return std::string(data.first, data.second);
+}
+
+std::string Row_batch::Row::get_as_string(uint32_t index) const {
+  VALIDATE_INDEX(index);
+
+  if (is_null(index)) return "NULL";
+
+  switch (get_type(index)) {
+    case Type::Null:
+      return "NULL";
+
+    case Type::Integer:
+      return std::to_string(get<int64_t>(index));
+
+    case Type::UInteger:
+      return std::to_string(get<uint64_t>(index));
+
+    case Type::Float:
+      return std::to_string(get<float>(index));
+
+    case Type::Double:
+      return std::to_string(get<double>(index));
+
+    case Type::String:
+    case Type::Bytes:
+    case Type::Decimal:
+    case Type::Date:
+    case Type::DateTime:
+    case Type::Time:
+    case Type::Geometry:
+    case Type::Json:
+    case Type::Enum:
+    case Type::Set:
+    case Type::Bit:
+      return get<std::string>(index);
+  }
+  throw std::invalid_argument("Unknown type in field");
+}
+
+int64_t Row_batch::Row::get_int(uint32_t index) const {
+  Type ftype;
+  std::string dec;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
+                            (ftype == Type::Decimal &&
+                             (dec = get<std::string>(index)).find('.') ==
+                                 std::string::npos)));
+
+  if (ftype == Type::UInteger) {
+    uint64_t u = get<uint64_t>(index);
+    if (u > LLONG_MAX) {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return static_cast<int64_t>(u);
+  } else if (ftype == Type::Decimal) {
+    return std::stoll(dec);
+  }
+  return get<int64_t>(index);
+}
+
+uint64_t Row_batch::Row::get_uint(uint32_t index) const {
+  Type ftype;
+  std::string dec;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Integer || ftype == Type::UInteger ||
+                            (ftype == Type::Decimal &&
+                             (dec = get<std::string>(index)).find('.') ==
+                                 std::string::npos)));
+
+  if (ftype == Type::Integer) {
+    int64_t i = get<int64_t>(index);
+    if (i < 0) {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return static_cast<uint64_t>(i);
+  } else if (ftype == Type::Decimal) {
+    if (!dec.empty() && dec[0] == '-') {
+      throw FIELD_ERROR(index, "field value out of the allowed range");
+    }
+    return std::stoull(dec);
+  }
+  return get<uint64_t>(index);
+}
+
+std::string Row_batch::Row::get_string(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (is_string_type(ftype)));
+  return get<std::string>(index);
+}
+
+std::pair<const char *, size_t> Row_batch::Row::get_string_data(
+    uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::String || ftype == Type::Bytes));
+  return get_data(index);
+}
+
+float Row_batch::Row::get_float(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Float || ftype == Type::Decimal ||
+                            ftype == Type::Double));
+  switch (ftype) {
+    case Type::Decimal:
+      try {
+        return std::stof(get<std::string>(index));
+      } catch (...) {
+        throw FIELD_ERROR(index, "float value out of the allowed range");
+      }
+    case Type::Double:
+      return static_cast<float>(get<double>(index));
+    case Type::Float:
+      return get<float>(index);
+    default:
+      throw std::logic_error("internal error");
+  }
+}
+
+double Row_batch::Row::get_double(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Double || ftype == Type::Float ||
+                            ftype == Type::Decimal));
+  switch (ftype) {
+    case Type::Decimal:
+      try {
+        return std::stod(get<std::string>(index));
+      } catch (std::exception &e) {
+        throw FIELD_ERROR(index, "double value out of the allowed range");
+      }
+    case Type::Float:
+      return static_cast<double>(get<float>(index));
+    case Type::Double:
+      return get<double>(index);
+    default:
+      throw std::logic_error("internal error");
+  }
+}
+
+uint64_t Row_batch::Row::get_bit(uint32_t index) const {
+  Type ftype;
+  GET_VALIDATE_TYPE(index, (ftype == Type::Bit));
+  return shcore::string_to_bits(get<std::string>(index)).first;
+}
 }  // namespace db
 }  // namespace mysqlshdk
@@ -26,6 +26,8 @@
 #ifndef MYSQLSHDK_LIBS_DB_ROW_COPY_H_
 #define MYSQLSHDK_LIBS_DB_ROW_COPY_H_
 
+#include <cstdio>
+#include <deque>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -195,6 +197,142 @@ class SHCORE_PUBLIC Mutable_row : public Mem_row {
   virtual ~Mutable_row();
 };
 
+/**
+ * Container holding copies of rows with the same layout, used to buffer whole
+ * results.
+ *
+ * Instead of allocating every field separately, each row is packed into a
+ * single chunk of memory taken from an arena. The chunk starts with a null
+ * bitmap followed by the offsets of the fields and the field data, numeric
+ * values are stored in their binary form.
+ *
+ * Rows are accessed through IRow instances owned by the batch, which remain
+ * valid until the batch is cleared or its layout is changed.
+ *
+ * If memory limit is set, once the rows held in memory exceed it, they are
+ * moved to a temporary file and the memory is released. Rows which were moved
+ * to the file are read back one at a time, the IRow returned for such row is
+ * only valid until the next call to at(). Reading the rows sequentially is
+ * cheap, going back requires reading the file from its beginning.
+ */
+class SHCORE_PUBLIC Row_batch {
+ public:
+  /**
+   * Memory limit used by the results buffering all their rows.
+   */
+  static constexpr size_t k_result_memory_limit = 256 * 1024 * 1024;
+
+  Row_batch() {}
+  explicit Row_batch(const std::vector<Type> &types);
+
+  Row_batch(const Row_batch &) = delete;
+  Row_batch &operator=(const Row_batch &) = delete;
+
+  /**
+   * Sets the number of bytes the rows can use before they are moved to a
+   * temporary file, 0 (default) means there is no limit. Needs to be set
+   * before rows are added, it is kept when the batch is reset.
+   */
+  void set_memory_limit(size_t limit) { m_memory_limit = limit; }
+  size_t memory_limit() const { return m_memory_limit; }
+
+  /**
+   * Removes all the rows and sets the types of the fields of the rows to be
+   * stored.
+   */
+  void reset(const std::vector<Type> &types);
+  void clear();
+
+  /**
+   * Adds a copy of the given row, its field types need to match the ones of
+   * the batch.
+   */
+  void append(const IRow &row);
+
+  /** Inserts new field at specified offset. Field value is set to null.
+   *
+   * @param type field type.
+   * @param offset offset at which to insert.
+   */
+  void add_field(Type type, uint32_t offset);
+
+  const IRow *at(size_t index) const {
+    return index < m_spilled_rows ? read_spilled(index)
+                                  : &m_rows[index - m_spilled_rows];
+  }
+
+  size_t size() const { return m_spilled_rows + m_rows.size(); }
+  bool empty() const { return size() == 0; }
+
+  /**
+   * @returns number of rows which were moved to the temporary file.
+   */
+  size_t spilled() const { return m_spilled_rows; }
+
+  const std::vector<Type> &types() const { return m_types; }
+
+ private:
+  class Row : public IRow {
+   public:
+    Row(const Row_batch *batch, const char *data)
+        : m_batch(batch), m_data(data) {}
+
+    uint32_t num_fields() const override;
+
+    Type get_type(uint32_t index) const override;
+    bool is_null(uint32_t index) const override;
+    std::string get_as_string(uint32_t index) const override;
+
+    std::string get_string(uint32_t index) const override;
+    int64_t get_int(uint32_t index) const override;
+    uint64_t get_uint(uint32_t index) const override;
+    float get_float(uint32_t index) const override;
+    double get_double(uint32_t index) const override;
+    std::pair<const char *, size_t> get_string_data(
+        uint32_t index) const override;
+    uint64_t get_bit(uint32_t index) const override;
+
+   private:
+    friend class Row_batch;
+
+    template <typename T>
+    T get(uint32_t index) const;
+    std::pair<const char *, size_t> get_data(uint32_t index) const;
+
+    const Row_batch *m_batch;
+    const char *m_data;
+  };
+
+  char *allocate(size_t size);
+
+  void spill();
+
+  const IRow *read_spilled(size_t index) const;
+
+  void take(Row_batch *batch);
+
+  std::vector<Type> m_types;
+  std::deque<Row> m_rows;
+  std::vector<std::unique_ptr<char[]>> m_blocks;
+  char *m_block_next = nullptr;
+  size_t m_block_free = 0;
+  std::string m_scratch;
+
+  size_t m_memory_limit = 0;
+  size_t m_memory_used = 0;
+
+  // rows moved to the temporary file, they precede the rows in m_rows
+  size_t m_spilled_rows = 0;
+  std::unique_ptr<FILE, int (*)(FILE *)> m_spill_file{nullptr, &fclose};
+
+  // state of the sequential reads from the temporary file
+  mutable size_t m_read_index = 0;
+  mutable fpos_t m_read_position;
+  mutable bool m_reading = false;
+  mutable std::string m_read_buffer;
+  mutable Row m_read_row{this, nullptr};
+};
+
 }  // namespace db
 }  // namespace mysqlshdk
 #endif  // MYSQLSHDK_LIBS_DB_ROW_COPY_H_
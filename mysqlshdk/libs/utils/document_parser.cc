@@ -27,6 +27,7 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <time.h>
+#include <cassert>
 #include <limits>
 #ifdef _WIN32
 #include <io.h>
@@ -76,6 +77,29 @@ std::string Json_reader::next() {
   return parser.parse();
 }
 
+bool Json_reader::supports_views() const {
+  return m_source->is_mapped() && !m_options.convert_bson_types &&
+         !m_options.convert_bson_id;
+}
+
+bool Json_reader::next(Document_view *document) {
+  assert(supports_views());
+
+  m_source->skip_whitespaces();
+  if (m_source->eof()) return false;
+
+  const auto data = reinterpret_cast<const char *>(m_source->pos());
+  const auto offset = m_source->offset();
+
+  // Document is only validated, there is nothing to be converted.
+  Json_document_parser parser(m_source, m_options);
+  parser.validate();
+
+  document->data = data;
+  document->size = m_source->offset() - offset;
+  return true;
+}
+
 void Json_document_parser::throw_premature_end() {
   throw invalid_json("Premature end of input stream", m_source->offset());
 }
@@ -122,6 +146,8 @@ std::string Json_document_parser::parse() {
   return document;
 }
 
+void Json_document_parser::validate() { parse(nullptr); }
+
 /**
  * This function carries on the actual parsing of a document by appending new
  * data into the received document.
@@ -131,7 +157,7 @@ std::string Json_document_parser::parse() {
  */
 void Json_document_parser::parse(std::string *document) {
   m_document = document;
-  m_document_start_offset = m_document->size();
+  m_document_start_offset = m_document ? m_document->size() : 0;
   if (m_source->eof()) return;
 
   if (m_source->peek() != (m_as_array ? '[' : '{')) {
@@ -141,7 +167,7 @@ void Json_document_parser::parse(std::string *document) {
   }
 
   // Appends the initial character
-  (*m_document) += m_source->get();
+  get_char(m_document);
 
   get_whitespaces(m_document);
 
@@ -149,7 +175,7 @@ void Json_document_parser::parse(std::string *document) {
 
   // Tests for an empty object/array
   if (m_source->peek() == (m_as_array ? ']' : '}')) {
-    (*m_document) += m_source->get();
+    get_char(m_document);
     complete = true;
   }
 
@@ -157,11 +183,12 @@ void Json_document_parser::parse(std::string *document) {
   while (!complete && !m_source->eof()) {
     if (!m_as_array) {
       // Next data is an attribute which is quoted
-      m_last_attribute_start = m_document->size() + 1;
+      if (m_document) m_last_attribute_start = m_document->size() + 1;
       get_string(m_document);
-      m_last_attribute_end = m_document->size() - 1;
+      if (m_document) m_last_attribute_end = m_document->size() - 1;
 
-      if (m_options.convert_bson_types || m_options.convert_bson_id) {
+      if (m_document &&
+          (m_options.convert_bson_types || m_options.convert_bson_id)) {
         auto type = get_bson_type();
         // If the first field is a mongo special field
         // The original document is translated based on
@@ -181,7 +208,7 @@ void Json_document_parser::parse(std::string *document) {
             "Unexpected character, expected field/value separator ':'",
             m_source->offset());
 
-      (*m_document) += m_source->get();
+      get_char(m_document);
 
       get_whitespaces(m_document);
 
@@ -204,7 +231,7 @@ void Json_document_parser::parse(std::string *document) {
     }
 
     // Consumes the , or the closing character
-    (*m_document) += m_source->get();
+    get_char(m_document);
     get_whitespaces(m_document);
   }
 
@@ -679,10 +706,19 @@ void Json_document_parser::get_string(std::string *target,
 
   get_char(target);
 
-  // Count holds the count of the characters read between the quotes
-  int count = 0;
   bool done = false;
   while (!m_source->eof() && !done) {
+    // Skips the string body up to the next quote or backslash in one go
+    const auto pos = reinterpret_cast<const char *>(m_source->pos());
+    const auto end = reinterpret_cast<const char *>(m_source->end());
+    const auto next = str_find_first_of(pos, end, "\"\\");
+
+    if (next != pos) {
+      if (target) target->append(pos, next);
+      m_source->seek(m_source->pos() + (next - pos));
+      continue;
+    }
+
     switch (m_source->peek()) {
       case '\\':
         get_char(target);
@@ -695,9 +731,9 @@ void Json_document_parser::get_string(std::string *target,
         break;
 
       default:
-        get_char(target);
+        // buffer was refilled
+        break;
     }
-    if (!done) count++;
   }
 
   if (!done) throw_premature_end();
@@ -716,7 +752,7 @@ void Json_document_parser::get_value(std::string *target) {
 
     case '{': {
       std::string context;
-      if (!m_as_array) {
+      if (!m_as_array && m_document) {
         size_t size = m_last_attribute_end - m_last_attribute_start;
         context = m_document->substr(m_last_attribute_start, size);
       }
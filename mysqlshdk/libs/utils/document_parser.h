@@ -74,6 +74,15 @@ struct Document_reader_options {
   bool ignore_type(Bson_type type) const;
 };
 
+/**
+ * Non owning reference to a document stored in a memory mapped
+ * Buffered_input. Valid as long as the input is open.
+ */
+struct Document_view {
+  const char *data = nullptr;
+  size_t size = 0;
+};
+
 /**
  * Loads JSON documents from a given Buffered_input
  */
@@ -101,6 +110,20 @@ class Json_reader : public Document_reader {
               const shcore::Document_reader_options &options)
       : Document_reader(input, options) {}
   std::string next() override;
+
+  /**
+   * Whether documents can be read without copying them, which is possible
+   * when input is memory mapped and documents do not need to be converted.
+   */
+  bool supports_views() const;
+
+  /**
+   * Validates the next document and returns a reference to it.
+   *
+   * @param document Receives the location of the document in the mapped input.
+   * @returns false if there are no more documents.
+   */
+  bool next(Document_view *document);
 };
 
 /**
@@ -153,6 +176,12 @@ class Json_document_parser : public Document_parser {
    */
   std::string parse() override;
 
+  /**
+   * Parses a single JSON document from the Buffered_input without storing it.
+   * No BSON conversions are performed.
+   */
+  void validate();
+
   struct Bson_token {
     Bson_token(char atype, const std::string &astring = "",
                std::string *string_ptr = nullptr, double *number = nullptr,
@@ -23,8 +23,10 @@
 
 #include "mysqlshdk/libs/utils/logger.h"
 
+#include <fcntl.h>
 #include <rapidjson/document.h>
 #include <stdarg.h>
+#include <sys/stat.h>
 #include <time.h>
 
 #ifdef _WIN32
@@ -35,8 +37,12 @@
 #endif  // !_WIN32
 
 #include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
 #include <map>
 #include <utility>
+#include <vector>
 
 #include "mysqlshdk/libs/utils/utils_general.h"
 
@@ -86,9 +92,138 @@ struct Logger_levels_table {
 
 Logger_levels_table g_level_converter;
 
+// maximum number of entries waiting to be written, must be a power of two
+constexpr size_t k_queue_size = 8192;
+
+// how often the writer thread writes the queued entries
+constexpr std::chrono::milliseconds k_write_interval{100};
+
+// writer is woken up earlier if the queue has this many entries
+constexpr size_t k_write_threshold = k_queue_size / 4;
+
+// how long a caller waits for space in a full queue before dropping the entry
+constexpr std::chrono::milliseconds k_max_enqueue_wait{10};
+
+/**
+ * Writes the whole buffer to the file descriptor, async-signal-safe.
+ */
+void write_fd(int fd, const char *data, size_t length) {
+  while (length > 0) {
+#ifdef _WIN32
+    const auto written = ::_write(fd, data, static_cast<unsigned int>(length));
+#else   // !_WIN32
+    const auto written = ::write(fd, data, length);
+#endif  // !_WIN32
+
+    if (written < 0) {
+      if (EINTR == errno) continue;
+      return;
+    }
+
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+}
+
 }  // namespace
 
-std::unique_ptr<Logger> Logger::s_instance;
+/**
+ * Bounded multi-producer single-consumer queue of formatted log entries.
+ *
+ * Each slot holds a sequence number which tells whether it can be written
+ * (equal to the position of the producer) or read (equal to the position of
+ * the consumer plus one), producers claim the positions using CAS, so no
+ * locks are needed to add an entry.
+ */
+class Logger::Log_queue final {
+ public:
+  explicit Log_queue(size_t size) : m_slots(size), m_mask(size - 1) {
+    for (size_t i = 0; i < size; ++i) {
+      m_slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Moves the message to the queue, returns false if the queue is full.
+   */
+  bool push(std::string *message) {
+    auto pos = m_tail.load(std::memory_order_relaxed);
+
+    while (true) {
+      auto &slot = m_slots[pos & m_mask];
+      const auto sequence = slot.sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+
+      if (0 == diff) {
+        if (m_tail.compare_exchange_weak(pos, pos + 1,
+                                         std::memory_order_relaxed)) {
+          slot.message.swap(*message);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = m_tail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Appends the oldest message to the output, returns false if there is none.
+   * Only one thread at a time may call this method.
+   */
+  bool pop(std::string *out) {
+    const auto pos = m_head.load(std::memory_order_relaxed);
+    auto &slot = m_slots[pos & m_mask];
+
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+    out->append(slot.message);
+    slot.message.clear();
+    slot.sequence.store(pos + m_slots.size(), std::memory_order_release);
+    m_head.store(pos + 1, std::memory_order_relaxed);
+
+    return true;
+  }
+
+  /**
+   * Writes the queued messages to the file descriptor without removing them
+   * from the queue. Async-signal-safe, memory is not allocated.
+   */
+  void write_to(int fd) const {
+    auto pos = m_head.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < m_slots.size(); ++i, ++pos) {
+      const auto &slot = m_slots[pos & m_mask];
+
+      if (slot.sequence.load(std::memory_order_acquire) != pos + 1) break;
+
+      write_fd(fd, slot.message.data(), slot.message.size());
+    }
+  }
+
+  size_t size() const {
+    return m_tail.load(std::memory_order_relaxed) -
+           m_head.load(std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return m_slots.size(); }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::string message;
+  };
+
+  std::vector<Slot> m_slots;
+  const size_t m_mask;
+  std::atomic<size_t> m_tail{0};
+  std::atomic<size_t> m_head{0};
+};
+
+Logger *Logger::s_instance = nullptr;
 std::string Logger::s_output_format;
 
 Logger::Log_entry::Log_entry()
@@ -124,7 +259,7 @@ void Logger::set_log_level(LOG_LEVEL log_level) {
 Logger::LOG_LEVEL Logger::get_log_level() { return m_log_level; }
 
 void Logger::assert_logger_initialized() {
-  if (s_instance.get() == nullptr) {
+  if (s_instance == nullptr) {
     static constexpr auto msg_noinit =
         "Logger: Tried to log to an uninitialized logger.\n";
 
@@ -169,7 +304,7 @@ void Logger::log(LOG_LEVEL level, const char *domain, const char *formats,
                  ...) {
   assert_logger_initialized();
 
-  if (s_instance.get() != nullptr && level <= s_instance->m_log_level) {
+  if (s_instance != nullptr && level <= s_instance->m_log_level) {
     va_list args;
     va_start(args, formats);
     const auto msg = format(formats, args);
@@ -183,7 +318,7 @@ void Logger::log(const std::exception &exc, const char *domain,
                  const char *formats, ...) {
   assert_logger_initialized();
 
-  if (s_instance.get() != nullptr) {
+  if (s_instance != nullptr) {
     va_list args;
     va_start(args, formats);
     const auto msg =
@@ -195,11 +330,9 @@ void Logger::log(const std::exception &exc, const char *domain,
 }
 
 void Logger::do_log(const Log_entry &entry) {
-  const auto s = format_message(entry);
-
-  if (s_instance->m_log_file.is_open()) {
-    s_instance->m_log_file.write(s.c_str(), s.length());
-    s_instance->m_log_file.flush();
+  if (s_instance->m_use_log_file) {
+    auto s = format_message(entry);
+    s_instance->enqueue(&s, entry.level);
   }
 
   for (const auto &f : s_instance->m_hook_list) {
@@ -207,9 +340,109 @@ void Logger::do_log(const Log_entry &entry) {
   }
 }
 
+void Logger::enqueue(std::string *message, LOG_LEVEL level) {
+  if (!m_queue->push(message)) {
+    // queue is full, give the writer a chance to catch up
+    m_writer_cv.notify_one();
+
+    const auto deadline = std::chrono::steady_clock::now() + k_max_enqueue_wait;
+    bool pushed = false;
+
+    do {
+      std::this_thread::yield();
+      pushed = m_queue->push(message);
+    } while (!pushed && std::chrono::steady_clock::now() < deadline);
+
+    if (!pushed) {
+      ++m_dropped;
+      return;
+    }
+  }
+
+  if (level <= LOG_ERROR || m_stop_writer) {
+    // errors are written right away, process may be about to terminate, all
+    // entries are written right away once the writer thread is stopped
+    write_queued();
+  } else if (m_queue->size() >= k_write_threshold) {
+    m_writer_cv.notify_one();
+  }
+}
+
+void Logger::write_queued() {
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  std::string batch;
+
+  // limit the batch, so that a busy producer cannot keep the writer here
+  for (size_t i = 0; i < m_queue->capacity() && m_queue->pop(&batch); ++i) {
+  }
+
+  const uint64_t dropped = m_dropped;
+
+  if (dropped != m_dropped_reported) {
+    const auto msg =
+        std::to_string(dropped - m_dropped_reported) +
+        " log entries were dropped, because the log queue was full";
+    batch += format_message({nullptr, msg.c_str(), LOG_WARNING});
+    m_dropped_reported = dropped;
+  }
+
+  const int fd = m_log_fd;
+
+  if (!batch.empty() && fd >= 0) write_fd(fd, batch.c_str(), batch.length());
+}
+
+void Logger::writer() {
+  std::unique_lock<std::mutex> lock(m_writer_mutex);
+
+  while (!m_stop_writer) {
+    // don't wait if producers are faster than the writer
+    if (m_queue->size() < k_write_threshold) {
+      m_writer_cv.wait_for(lock, k_write_interval);
+    }
+
+    lock.unlock();
+    write_queued();
+    lock.lock();
+  }
+}
+
+void Logger::stop_writer() {
+  {
+    std::lock_guard<std::mutex> lock(m_writer_mutex);
+    m_stop_writer = true;
+  }
+
+  m_writer_cv.notify_one();
+  if (m_writer.joinable()) m_writer.join();
+}
+
+void Logger::flush() {
+  if (s_instance) s_instance->write_queued();
+}
+
+void Logger::shutdown() {
+  if (s_instance) {
+    s_instance->stop_writer();
+    s_instance->write_queued();
+  }
+}
+
+void Logger::flush_on_crash() {
+  const auto instance = s_instance;
+  if (instance == nullptr) return;
+
+  const int fd = instance->m_log_fd;
+  if (fd < 0) return;
+
+  const int errno_save = errno;
+  instance->m_queue->write_to(fd);
+  errno = errno_save;
+}
+
 Logger *Logger::singleton() {
-  if (s_instance.get() != nullptr) {
-    return s_instance.get();
+  if (s_instance != nullptr) {
+    return s_instance;
   } else {
     throw std::logic_error("ngcommon::Logger not initialized");
   }
@@ -302,18 +535,11 @@ void Logger::setup_instance(const char *filename, bool use_stderr,
   if (s_instance) {
     if (filename) {
       if (filename != s_instance->m_log_file_name) {
-        if (s_instance->m_log_file.is_open()) s_instance->m_log_file.close();
-        s_instance->m_log_file_name = filename;
-
-        s_instance->m_log_file.open(filename, std::ios_base::app);
-        if (s_instance->m_log_file.fail())
-          throw std::logic_error(
-              std::string("Error in Logger::Logger when opening file '") +
-              filename + "' for writing");
+        s_instance->close_log_file();
+        s_instance->open_log_file(filename);
       }
     } else {
-      if (s_instance->m_log_file.is_open()) s_instance->m_log_file.close();
-      s_instance->m_log_file_name.clear();
+      s_instance->close_log_file();
     }
 
     s_instance->set_log_level(log_level);
@@ -323,29 +549,69 @@ void Logger::setup_instance(const char *filename, bool use_stderr,
       s_instance->attach_log_hook(&Logger::out_to_stderr);
     }
   } else {
-    s_instance.reset(new Logger(filename, use_stderr, log_level));
+    s_instance = new Logger(filename, use_stderr, log_level);
+    // queued entries are written before the static objects are destroyed
+    std::atexit(&Logger::shutdown);
   }
 }
 
 Logger::Logger(const char *filename, bool use_stderr,
                Logger::LOG_LEVEL log_level)
-    : m_log_level{log_level} {
+    : m_log_level{log_level},
+      m_queue{new Log_queue(k_queue_size)} {
   if (filename != nullptr) {
-    m_log_file_name = filename;
-    m_log_file.open(filename, std::ios_base::app);
-    if (m_log_file.fail())
-      throw std::logic_error(
-          std::string("Error in Logger::Logger when opening file '") +
-          filename + "' for writing");
+    open_log_file(filename);
   }
 
   if (use_stderr) {
     attach_log_hook(&Logger::out_to_stderr);
   }
+
+  m_writer = std::thread(&Logger::writer, this);
 }
 
 Logger::~Logger() {
-  if (m_log_file.is_open()) m_log_file.close();
+  stop_writer();
+  close_log_file();
+}
+
+void Logger::open_log_file(const char *filename) {
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  m_log_file_name = filename;
+
+  // a plain file descriptor, so that it can be written from a signal handler
+#ifdef _WIN32
+  const int fd =
+      ::_open(filename, _O_WRONLY | _O_CREAT | _O_APPEND, _S_IREAD | _S_IWRITE);
+#else   // !_WIN32
+  const int fd = ::open(filename, O_WRONLY | O_CREAT | O_APPEND, 0666);
+#endif  // !_WIN32
+
+  if (fd < 0)
+    throw std::logic_error(
+        std::string("Error in Logger::Logger when opening file '") + filename +
+        "' for writing");
+
+  m_log_fd = fd;
+  m_use_log_file = true;
+}
+
+void Logger::close_log_file() {
+  // entries logged so far go to the current file
+  write_queued();
+
+  std::lock_guard<std::mutex> lock(m_write_mutex);
+
+  m_use_log_file = false;
+
+  const int fd = m_log_fd.exchange(-1);
+#ifdef _WIN32
+  if (fd >= 0) ::_close(fd);
+#else   // !_WIN32
+  if (fd >= 0) ::close(fd);
+#endif  // !_WIN32
+  m_log_file_name.clear();
 }
 
 Logger::LOG_LEVEL Logger::get_level_by_name(const std::string &level_name) {
@@ -24,12 +24,17 @@
 #ifndef MYSQLSHDK_LIBS_UTILS_LOGGER_H_
 #define MYSQLSHDK_LIBS_UTILS_LOGGER_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdarg>
+#include <cstdint>
 #include <fstream>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 #ifdef _MSC_VER
 #include <sal.h>
@@ -44,6 +49,15 @@ namespace ngcommon {
 #define LOG_DOMAIN DOMAIN_DEFAULT
 #endif
 
+/**
+ * Log entries are formatted on the thread which logs them and put in a bounded
+ * queue, a background thread writes them to the log file in batches. Hooks
+ * are still called synchronously. If the queue is full, the caller waits
+ * briefly for the writer to catch up, then the entry is dropped and the number
+ * of dropped entries is written to the log. Errors are written to the file
+ * before the call returns, the remaining entries are written when the process
+ * exits (see shutdown()) or crashes (see flush_on_crash()).
+ */
 class SHCORE_PUBLIC Logger final {
  public:
   enum LOG_LEVEL {
@@ -103,6 +117,30 @@ class SHCORE_PUBLIC Logger final {
 
   static Logger *singleton();
 
+  /**
+   * Writes all the queued entries to the log file.
+   *
+   * Not async-signal-safe, must not be called from a signal handler.
+   */
+  static void flush();
+
+  /**
+   * Stops the writer thread and writes all the queued entries, entries logged
+   * afterwards are written synchronously. Called at exit, before the static
+   * objects used by the writer are destroyed.
+   */
+  static void shutdown();
+
+  /**
+   * Writes the queued entries to the log file from a handler of a signal
+   * which terminates the process.
+   *
+   * Async-signal-safe: does not allocate memory nor take locks, the entries
+   * are only read from the queue and written using write(2). Entries which
+   * the writer thread is writing at the same time may be written twice.
+   */
+  static void flush_on_crash();
+
   // Creates singleton instance with proper parameters
   static void setup_instance(const char *filename, bool use_stderr = false,
                              LOG_LEVEL level = LOG_INFO);
@@ -123,7 +161,15 @@ class SHCORE_PUBLIC Logger final {
 
   bool use_stderr() const;
 
+  /**
+   * Number of entries which were not written to the log file because the
+   * queue was full.
+   */
+  uint64_t dropped_entries() const { return m_dropped; }
+
  private:
+  class Log_queue;
+
   Logger(const char *filename, bool use_stderr = false,
          LOG_LEVEL log_level = LOG_INFO);
 
@@ -147,13 +193,39 @@ class SHCORE_PUBLIC Logger final {
 
   static void do_log(const Log_entry &entry);
 
-  static std::unique_ptr<Logger> s_instance;
+  void open_log_file(const char *filename);
+
+  void close_log_file();
+
+  void enqueue(std::string *message, LOG_LEVEL level);
+
+  void write_queued();
+
+  void writer();
+
+  void stop_writer();
+
+  // never destroyed, so the writer thread is not joined by a static destructor
+  static Logger *s_instance;
   static std::string s_output_format;
 
   LOG_LEVEL m_log_level;
-  std::ofstream m_log_file;
+  // atomic, so that it can be read by the signal handler
+  std::atomic<int> m_log_fd{-1};
   std::string m_log_file_name;
   std::list<Log_hook> m_hook_list;
+
+  std::unique_ptr<Log_queue> m_queue;
+  std::atomic<bool> m_use_log_file{false};
+  // guards the log file and removal of entries from the queue
+  std::mutex m_write_mutex;
+  std::atomic<uint64_t> m_dropped{0};
+  uint64_t m_dropped_reported = 0;
+
+  std::mutex m_writer_mutex;
+  std::condition_variable m_writer_cv;
+  std::atomic<bool> m_stop_writer{false};
+  std::thread m_writer;
 };
 
 #define log_internal_error(...)                                           \
@@ -22,22 +22,264 @@
  */
 
 #include "mysqlshdk/libs/utils/profiling.h"
-#include <cassert>
+#include <algorithm>
+#include <cinttypes>
+#include <map>
+#include <memory>
+#include <mutex>
 
 namespace mysqlshdk {
 namespace utils {
 
-Profile_timer *g_active_timer = nullptr;
+namespace {
 
-Profile_timer *Profile_timer::activate() {
-  assert(g_active_timer == nullptr);
+using Clock = std::chrono::high_resolution_clock;
 
-  return g_active_timer = new utils::Profile_timer();
+struct Thread_timer {
+  // guards the timer, which is read by the reports while the thread records
+  std::mutex mutex;
+  Profile_timer timer;
+  uint64_t id = 0;
+  // set when the thread exits, timer is not used by anyone else after that
+  std::atomic<bool> finished{false};
+};
+
+struct Profile_data {
+  std::mutex mutex;
+  Clock::time_point started = Clock::now();
+  uint64_t next_thread_id = 1;
+  // timers of the threads which finished are kept until the data is reset
+  std::vector<std::unique_ptr<Thread_timer>> threads;
+};
+
+Profile_data &profile_data() {
+  static Profile_data data;
+  return data;
+}
+
+class Thread_registration {
+ public:
+  Thread_registration() = default;
+  Thread_registration(const Thread_registration &) = delete;
+  Thread_registration &operator=(const Thread_registration &) = delete;
+
+  ~Thread_registration() {
+    if (m_timer) m_timer->finished = true;
+  }
+
+  Thread_timer *timer() {
+    if (!m_timer) {
+      auto &data = profile_data();
+      std::lock_guard<std::mutex> lock(data.mutex);
+      data.threads.emplace_back(new Thread_timer());
+      m_timer = data.threads.back().get();
+      m_timer->id = data.next_thread_id++;
+    }
+
+    return m_timer;
+  }
+
+ private:
+  Thread_timer *m_timer = nullptr;
+};
+
+thread_local Thread_registration t_registration;
+
+struct Stage_node {
+  explicit Stage_node(const std::string &n) : name(n) {}
+
+  Stage_node *child(const std::string &note) {
+    for (const auto &c : children) {
+      if (c->name == note) return c.get();
+    }
+
+    children.emplace_back(new Stage_node(note));
+    return children.back().get();
+  }
+
+  std::string name;
+  uint64_t calls = 0;
+  Clock::duration total = Clock::duration::zero();
+  // in the order of the first call
+  std::vector<std::unique_ptr<Stage_node>> children;
+};
+
+Clock::time_point stage_end_time(const Profile_timer::Trace_point &tp,
+                                 Clock::time_point now) {
+  return tp.end < tp.start ? now : tp.end;
+}
+
+/**
+ * Calls f(thread_id, timer) for each thread, while its timer is locked.
+ */
+template <typename F>
+void for_each_thread(F f) {
+  auto &data = profile_data();
+  std::lock_guard<std::mutex> lock(data.mutex);
+
+  for (const auto &thread : data.threads) {
+    std::lock_guard<std::mutex> timer_lock(thread->mutex);
+    f(thread->id, thread->timer);
+  }
+}
+
+double milliseconds(Clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count() /
+         1000000.0;
+}
+
+void add_node_lines(const Stage_node &node, int depth,
+                    std::vector<std::pair<std::string, const Stage_node *>>
+                        *lines) {
+  for (const auto &c : node.children) {
+    lines->emplace_back(std::string(2 * depth, ' ') + c->name, c.get());
+    add_node_lines(*c, depth + 1, lines);
+  }
+}
+
+std::string json_string(const char *s) {
+  std::string result = "\"";
+
+  for (; *s; ++s) {
+    const auto c = static_cast<unsigned char>(*s);
+
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += *s;
+    } else if (c < 0x20) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      result += buffer;
+    } else {
+      result += *s;
+    }
+  }
+
+  return result + "\"";
+}
+
+}  // namespace
+
+std::atomic<bool> Profiler::s_running{false};
+
+void Profiler::start() {
+  reset();
+  s_running = true;
+}
+
+void Profiler::stop() { s_running = false; }
+
+void Profiler::reset() {
+  auto &data = profile_data();
+  std::lock_guard<std::mutex> lock(data.mutex);
+
+  data.threads.erase(
+      std::remove_if(data.threads.begin(), data.threads.end(),
+                     [](const std::unique_ptr<Thread_timer> &thread) {
+                       return thread->finished.load();
+                     }),
+      data.threads.end());
+
+  for (const auto &thread : data.threads) {
+    std::lock_guard<std::mutex> timer_lock(thread->mutex);
+    thread->timer.clear();
+  }
+
+  data.started = Clock::now();
 }
 
-void Profile_timer::deactivate() {
-  delete g_active_timer;
-  g_active_timer = nullptr;
+void Profiler::stage_begin(const char *note) {
+  const auto thread = t_registration.timer();
+  std::lock_guard<std::mutex> lock(thread->mutex);
+  thread->timer.stage_begin(note);
+}
+
+void Profiler::stage_end() {
+  const auto thread = t_registration.timer();
+  std::lock_guard<std::mutex> lock(thread->mutex);
+  thread->timer.stage_end();
+}
+
+std::string Profiler::stage_tree() {
+  const auto now = Clock::now();
+  Stage_node root("");
+
+  for_each_thread([&root, now](uint64_t, const Profile_timer &timer) {
+    // nodes of the stages which enclose the current one
+    std::vector<Stage_node *> path;
+
+    for (const auto &tp : timer.trace_points()) {
+      path.resize(std::min(path.size(), static_cast<size_t>(tp.depth)));
+      const auto node = (path.empty() ? &root : path.back())->child(tp.note);
+
+      ++node->calls;
+      node->total += stage_end_time(tp, now) - tp.start;
+      path.push_back(node);
+    }
+  });
+
+  std::vector<std::pair<std::string, const Stage_node *>> lines;
+  add_node_lines(root, 0, &lines);
+
+  if (lines.empty()) return "";
+
+  size_t width = 5;
+  for (const auto &line : lines) width = std::max(width, line.first.length());
+
+  char buffer[128];
+  snprintf(buffer, sizeof(buffer), "%-*s %14s %14s %14s\n",
+           static_cast<int>(width), "Stage", "Calls", "Total (ms)",
+           "Average (ms)");
+  std::string result = buffer;
+
+  for (const auto &line : lines) {
+    const auto node = line.second;
+    const double total = milliseconds(node->total);
+
+    snprintf(buffer, sizeof(buffer), " %14" PRIu64 " %14.3f %14.3f\n",
+             node->calls, total, total / node->calls);
+    result += line.first + std::string(width - line.first.length(), ' ') +
+              buffer;
+  }
+
+  return result;
+}
+
+std::string Profiler::chrome_trace() {
+  const auto now = Clock::now();
+  Clock::time_point started;
+  std::string events;
+
+  {
+    auto &data = profile_data();
+    std::lock_guard<std::mutex> lock(data.mutex);
+    started = data.started;
+  }
+
+  for_each_thread([&events, now, started](uint64_t id,
+                                          const Profile_timer &timer) {
+    for (const auto &tp : timer.trace_points()) {
+      using std::chrono::duration_cast;
+      using std::chrono::microseconds;
+      const auto end = stage_end_time(tp, now);
+      char buffer[128];
+
+      snprintf(buffer, sizeof(buffer),
+               ",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu64
+               ",\"ts\":%lld,\"dur\":%lld}",
+               id,
+               static_cast<long long>(
+                   duration_cast<microseconds>(tp.start - started).count()),
+               static_cast<long long>(
+                   duration_cast<microseconds>(end - tp.start).count()));
+
+      if (!events.empty()) events += ",\n";
+      events += "{\"name\":" + json_string(tp.note) + buffer;
+    }
+  });
+
+  return "{\"traceEvents\":[\n" + events +
+         "\n],\n\"displayTimeUnit\":\"ms\"}\n";
 }
 
 }  // namespace utils
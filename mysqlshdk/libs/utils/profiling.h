@@ -24,7 +24,9 @@
 #ifndef MYSQLSHDK_LIBS_UTILS_PROFILING_H_
 #define MYSQLSHDK_LIBS_UTILS_PROFILING_H_
 
+#include <atomic>
 #include <chrono>
+#include <cstdio>
 #include <string>
 #include <utility>
 #include <vector>
@@ -50,6 +52,9 @@ class Profile_timer {
   }
 
   inline void stage_end() {
+    // stage may have been started before the timer was cleared
+    if (_nesting_levels.empty()) return;
+
     size_t stage = _nesting_levels.back();
     _nesting_levels.pop_back();
     --_depth;
@@ -73,8 +78,11 @@ class Profile_timer {
     return total_nanoseconds_ellapsed() / 1000000000.0;
   }
 
-  static Profile_timer *activate();
-  static void deactivate();
+  void clear() {
+    _trace_points.clear();
+    _nesting_levels.clear();
+    _depth = 0;
+  }
 
  public:
   struct Trace_point {
@@ -97,16 +105,83 @@ class Profile_timer {
   int _depth = 0;
 };
 
-extern Profile_timer *g_active_timer;
+/**
+ * Collects the stages recorded by all the threads of the process while it's
+ * running.
+ *
+ * Each thread records its stages into its own Profile_timer, so stages can be
+ * nested within a thread and threads do not contend with each other. Stages
+ * are recorded using mysqlshdk::stage_begin()/stage_end() or the
+ * Profile_stage guard, which do nothing if the profiler is not running.
+ */
+class Profiler {
+ public:
+  /**
+   * Discards all the stages recorded so far and starts recording new ones.
+   */
+  static void start();
+
+  /**
+   * Stops recording, the stages recorded so far are kept.
+   */
+  static void stop();
+
+  static bool running() { return s_running.load(std::memory_order_relaxed); }
+
+  /**
+   * Discards all the stages recorded so far.
+   */
+  static void reset();
+
+  static void stage_begin(const char *note);
+  static void stage_end();
+
+  /**
+   * Stages of all the threads aggregated by their path, one line per path,
+   * with the number of calls, total and average time. Stages which were not
+   * finished yet are measured up to now.
+   */
+  static std::string stage_tree();
+
+  /**
+   * All the stages in the Trace Event Format, which can be loaded by the
+   * chrome://tracing tool. Each thread is reported with its own ID.
+   */
+  static std::string chrome_trace();
+
+ private:
+  static std::atomic<bool> s_running;
+};
+
+/**
+ * Records a stage from construction to destruction, if the profiler is
+ * running when it's created.
+ */
+class Profile_stage {
+ public:
+  explicit Profile_stage(const char *note) : m_recorded(Profiler::running()) {
+    if (m_recorded) Profiler::stage_begin(note);
+  }
+
+  Profile_stage(const Profile_stage &) = delete;
+  Profile_stage &operator=(const Profile_stage &) = delete;
+
+  ~Profile_stage() {
+    if (m_recorded) Profiler::stage_end();
+  }
+
+ private:
+  bool m_recorded;
+};
 
 }  // namespace utils
 
 inline void stage_begin(const char *note) {
-  if (utils::g_active_timer) utils::g_active_timer->stage_begin(note);
+  if (utils::Profiler::running()) utils::Profiler::stage_begin(note);
 }
 
 inline void stage_end() {
-  if (utils::g_active_timer) utils::g_active_timer->stage_end();
+  if (utils::Profiler::running()) utils::Profiler::stage_end();
 }
 
 }  // namespace mysqlshdk
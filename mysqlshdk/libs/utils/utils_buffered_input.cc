@@ -29,15 +29,17 @@
 #ifdef _WIN32
 #include <io.h>
 #else
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
+#include <algorithm>
 #include <deque>
 #include <string>
 
 namespace shcore {
 
-void Buffered_input::open(const std::string &filepath_) {
+void Buffered_input::open(const std::string &filepath_, bool use_mmap) {
   close();
 #ifdef _WIN32
   m_fd = ::_open(filepath_.c_str(), O_RDONLY);
@@ -49,9 +51,67 @@ void Buffered_input::open(const std::string &filepath_) {
     throw std::runtime_error(filepath_ + ": " + errno_to_string(err) +
                              " (error code " + std::to_string(err) + ")");
   }
+
+#ifndef _WIN32
+  struct stat st;
+  if (use_mmap && ::fstat(m_fd, &st) == 0 && S_ISREG(st.st_mode) &&
+      st.st_size > 0) {
+    void *mapping =
+        ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+
+    if (mapping != MAP_FAILED) {
+      ::madvise(mapping, st.st_size, MADV_SEQUENTIAL);
+      m_mapping = static_cast<byte *>(mapping);
+      m_mapping_size = st.st_size;
+      m_pos = m_mapping;
+      m_end = m_mapping + m_mapping_size;
+    }
+  }
+#else
+  (void)use_mmap;
+#endif
+}
+
+void Buffered_input::set_range(size_t begin, size_t end) {
+  m_eof = false;
+  m_bytes_processed = begin;
+
+  if (m_mapping) {
+    m_pos = m_mapping + std::min(begin, m_mapping_size);
+    m_end = m_mapping + std::min(end, m_mapping_size);
+    return;
+  }
+
+#ifdef _WIN32
+  auto pos = ::_lseeki64(m_fd, begin, SEEK_SET);
+#else
+  auto pos = ::lseek(m_fd, begin, SEEK_SET);
+#endif
+  if (pos < 0) {
+    int err = errno;
+    throw std::runtime_error("Unable to seek to offset " +
+                             std::to_string(begin) + ": " +
+                             errno_to_string(err) + " (error code " +
+                             std::to_string(err) + ")");
+  }
+
+  m_pos = m_buffer;
+  m_end = m_buffer;
+  m_read_offset = begin;
+  m_read_limit = end;
 }
 
 void Buffered_input::close() {
+#ifndef _WIN32
+  if (m_mapping) {
+    ::munmap(m_mapping, m_mapping_size);
+  }
+#endif
+  m_mapping = nullptr;
+  m_mapping_size = 0;
+  m_pos = m_buffer;
+  m_end = m_buffer;
+
   if (m_fd > 0) {
 #ifdef _WIN32
     ::_close(m_fd);
@@ -90,16 +150,30 @@ void Buffered_input::fill_buffer() {
   }
 
   m_pos = m_buffer;
+
+  if (m_mapping) {
+    // whole mapped range was consumed
+    m_end = m_buffer;
+    m_eof = true;
+    *m_pos = '\0';
+    return;
+  }
+
+  const size_t remaining =
+      m_read_offset < m_read_limit ? m_read_limit - m_read_offset : 0;
+  const size_t to_read = remaining < BUFFER_SIZE ? remaining : BUFFER_SIZE;
 #ifdef _WIN32
-  int bytes = ::_read(m_fd, m_buffer, BUFFER_SIZE);
+  int bytes = to_read > 0 ? ::_read(m_fd, m_buffer, to_read) : 0;
 #else
-  ssize_t bytes = ::read(m_fd, m_buffer, BUFFER_SIZE);
+  ssize_t bytes = to_read > 0 ? ::read(m_fd, m_buffer, to_read) : 0;
 #endif
 
   if (bytes < 0) {
     bytes = 0;
   }
 
+  m_read_offset += bytes;
+
   m_end = m_buffer + bytes;
 
   if (m_pos == m_end) {
@@ -25,6 +25,7 @@
 #define MYSQLSHDK_LIBS_UTILS_UTILS_BUFFERED_INPUT_H_
 
 #include <string.h>
+#include <limits>
 #include <string>
 
 #include "mysqlshdk/libs/utils/utils_general.h"
@@ -33,6 +34,10 @@ namespace shcore {
 
 /**
  * Forward read only buffered input.
+ *
+ * Input file can optionally be memory mapped, in which case pos() and end()
+ * point directly into the mapping and no data is copied to the internal
+ * buffer.
  */
 class Buffered_input {
   using byte = unsigned char;
@@ -49,7 +54,25 @@ class Buffered_input {
 
   ~Buffered_input() { close(); }
 
-  void open(const std::string &filepath_);
+  /**
+   * Opens the given file.
+   *
+   * @param filepath_ Path to the file.
+   * @param use_mmap Map the whole file into memory. If the file cannot be
+   *        mapped (i.e. it is a pipe), buffered reads are used instead.
+   */
+  void open(const std::string &filepath_, bool use_mmap = false);
+
+  bool is_mapped() const { return m_mapping != nullptr; }
+
+  /**
+   * Restricts reading to the given byte range of the opened file. Offsets
+   * reported by offset() remain relative to the beginning of the file.
+   *
+   * @param begin Offset of the first byte to be read.
+   * @param end Offset one past the last byte to be read.
+   */
+  void set_range(size_t begin, size_t end);
 
   bool eof() { return m_eof; }
 
@@ -60,7 +83,11 @@ class Buffered_input {
     return *m_pos;
   }
 
-  void seek(byte *pos) { m_pos = pos > m_end ? m_end : pos; }
+  void seek(byte *pos) {
+    byte *target = pos > m_end ? m_end : pos;
+    m_bytes_processed += target - m_pos;
+    m_pos = target;
+  }
 
   byte get() {
     byte c = peek();
@@ -93,6 +120,10 @@ class Buffered_input {
   byte *m_pos = m_buffer;
   byte *m_end = m_buffer;
   size_t m_bytes_processed = 0;
+  size_t m_read_offset = 0;
+  size_t m_read_limit = std::numeric_limits<size_t>::max();
+  byte *m_mapping = nullptr;
+  size_t m_mapping_size = 0;
 };
 
 }  // namespace shcore
@@ -26,6 +26,7 @@
 
 #include <rapidjson/document.h>
 #include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 #include <string>
 
@@ -73,17 +74,9 @@ class My_pretty_writer : public rapidjson::PrettyWriter<T> {
 
 class SHCORE_PUBLIC Writer_base {
  protected:
-  class SStream {
-   public:
-    using Ch = std::string::value_type;
+  using Buffer = rapidjson::StringBuffer;
 
-    void Put(Ch c) { data += c; }
-    void Flush() {}
-
-    std::string data;
-  };
-
-  SStream _data;
+  Buffer _data;
 
  public:
   virtual ~Writer_base() {}
@@ -104,7 +97,15 @@ class SHCORE_PUBLIC Writer_base {
   virtual void append_document(const rapidjson::Document &document) = 0;
 
  public:
-  std::string str() { return _data.data; }
+  std::string str() const { return {_data.GetString(), _data.GetSize()}; }
+
+  size_t size() const { return _data.GetSize(); }
+
+  std::string flush() {
+    std::string data = str();
+    _data.Clear();
+    return data;
+  }
 };
 
 class SHCORE_PUBLIC Raw_writer : public Writer_base {
@@ -135,7 +136,7 @@ class SHCORE_PUBLIC Raw_writer : public Writer_base {
   };
 
  private:
-  My_writer<SStream> _writer;
+  My_writer<Buffer> _writer;
 };
 
 class SHCORE_PUBLIC Pretty_writer : public Writer_base {
@@ -167,7 +168,7 @@ class SHCORE_PUBLIC Pretty_writer : public Writer_base {
   };
 
  private:
-  My_pretty_writer<SStream> _writer;
+  My_pretty_writer<Buffer> _writer;
 };
 
 struct Value;
@@ -227,6 +228,17 @@ class SHCORE_PUBLIC JSON_dumper {
 
   std::string str() { return _writer->str(); }
 
+  /**
+   * @returns size of the JSON text generated so far.
+   */
+  size_t size() const { return _writer->size(); }
+
+  /**
+   * Returns the JSON text generated so far and clears the buffer, so that big
+   * documents can be written out in parts, as they are being generated.
+   */
+  std::string flush() { return _writer->flush(); }
+
  private:
   int _deep_level;
 
@@ -22,6 +22,7 @@
  */
 
 #include "mysqlshdk/libs/utils/utils_mysql_parsing.h"
+#include <algorithm>
 #include <iterator>
 #include <tuple>
 #include <utility>
@@ -94,6 +95,32 @@ bool Sql_splitter::set_delimiter(const std::string &delim) {
   return true;
 }
 
+#ifndef MYSQLSHDK_SQL_SPLITTER_SCALAR
+template <const char skip_table[255], const char quote>
+inline char *span_string(char *p, const char *end) {
+  // p must be inside the quoted string (after the opening quote)
+  static constexpr char k_specials[] = {quote, '\\', '\0'};
+  for (;;) {
+    // Skip the string body, 16 bytes at a time where SSE2 is available, up
+    // to the next closing quote or escape
+    p = const_cast<char *>(shcore::str_find_first_of(p, end, k_specials));
+    if (p >= end) return nullptr;
+
+    if (*p == '\\') {
+      // the escaped char may be in the next block
+      p += 2;
+      if (p >= end) return nullptr;
+      continue;
+    }
+    // continue if there's another quote following the quote
+    if (p + 1 < end && *(p + 1) == quote) {
+      p += 2;
+      continue;
+    }
+    return p + 1;
+  }
+}
+#else
 template <const char skip_table[255], const char quote>
 inline char *span_string(char *p, const char *end) {
   // p must be inside the single quote string (after the ')
@@ -126,6 +153,7 @@ inline char *span_string(char *p, const char *end) {
     return p + 1;
   }
 }
+#endif  // MYSQLSHDK_SQL_SPLITTER_SCALAR
 
 template <const char quote>
 inline char *span_quoted_identifier(char *p, char *end) {
@@ -609,12 +637,15 @@ bool iterate_sql_stream(
         buffer.resize(buffer.size() - shrinkage);
       }
 
+      // the unfinished statement is scanned again from its beginning, grow
+      // the reads with it so large statements are not scanned once per chunk
       size_t osize = buffer.size();
-      buffer.resize(osize + chunk_size);
-      stream->read(&buffer[osize], chunk_size);
+      size_t read_size = std::max(chunk_size, osize);
+      buffer.resize(osize + read_size);
+      stream->read(&buffer[osize], read_size);
       buffer.resize(osize + stream->gcount());
 
-      if (static_cast<size_t>(stream->gcount()) < chunk_size) {
+      if (static_cast<size_t>(stream->gcount()) < read_size) {
         splitter.feed(&buffer[0], buffer.size());
       } else {
         splitter.feed_chunk(&buffer[0], buffer.size());
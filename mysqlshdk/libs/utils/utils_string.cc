@@ -24,10 +24,20 @@
 #include "utils/utils_string.h"
 #include <algorithm>
 #include <bitset>
+#include <cassert>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAVE_SSE2_SCAN 1
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 namespace shcore {
 
 std::string str_strip(const std::string &s, const std::string &chars) {
@@ -291,4 +301,236 @@ std::pair<std::string::size_type, std::string::size_type> get_quote_span(
   if (close_quote_pos == str.size()) close_quote_pos = std::string::npos;
   return std::make_pair(open_quote_pos, close_quote_pos);
 }
+
+#ifdef HAVE_SSE2_SCAN
+namespace {
+
+inline int count_trailing_zeros(int mask) {
+#ifdef _MSC_VER
+  unsigned long index = 0;
+  _BitScanForward(&index, mask);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(mask);
+#endif
+}
+
+}  // namespace
+#endif  // HAVE_SSE2_SCAN
+
+const char *str_find_first_of(const char *begin, const char *end,
+                              const char *chars) {
+  const size_t count = strlen(chars);
+  assert(count > 0 && count <= 8);
+
+#ifdef HAVE_SSE2_SCAN
+  __m128i needles[8];
+
+  for (size_t i = 0; i < count; ++i) {
+    needles[i] = _mm_set1_epi8(chars[i]);
+  }
+
+  while (end - begin >= 16) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+    __m128i matches = _mm_cmpeq_epi8(block, needles[0]);
+
+    for (size_t i = 1; i < count; ++i) {
+      matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, needles[i]));
+    }
+
+    const int mask = _mm_movemask_epi8(matches);
+
+    if (mask != 0) return begin + count_trailing_zeros(mask);
+
+    begin += 16;
+  }
+#endif  // HAVE_SSE2_SCAN
+
+  bool is_needle[256] = {false};
+
+  for (size_t i = 0; i < count; ++i) {
+    is_needle[static_cast<unsigned char>(chars[i])] = true;
+  }
+
+  for (; begin < end; ++begin) {
+    if (is_needle[static_cast<unsigned char>(*begin)]) return begin;
+  }
+
+  return end;
+}
+
+namespace {
+
+bool parse_digits(const char *begin, const char *end, uint64_t *out) {
+  if (begin == end) return false;
+
+  uint64_t value = 0;
+
+  for (; begin < end; ++begin) {
+    const unsigned digit = static_cast<unsigned char>(*begin) - '0';
+
+    if (digit > 9) return false;
+
+    // value * 10 + digit would overflow
+    if (value > (UINT64_MAX - digit) / 10) return false;
+
+    value = value * 10 + digit;
+  }
+
+  *out = value;
+  return true;
+}
+
+struct Decimal_number {
+  bool negative = false;
+  uint64_t mantissa = 0;
+  int exponent = 0;
+};
+
+/**
+ * Splits a number into an integer mantissa and a power of 10. Fails if the
+ * mantissa has more than 19 digits.
+ */
+bool parse_decimal(const char *p, const char *end, Decimal_number *out) {
+  if (p < end && (*p == '-' || *p == '+')) out->negative = *p++ == '-';
+
+  int digits = 0;
+  int fraction_digits = 0;
+  bool in_fraction = false;
+  bool has_digits = false;
+
+  for (; p < end; ++p) {
+    if (*p == '.') {
+      if (in_fraction) return false;
+      in_fraction = true;
+      continue;
+    }
+
+    const unsigned digit = static_cast<unsigned char>(*p) - '0';
+
+    if (digit > 9) break;
+
+    has_digits = true;
+
+    // leading zeros do not count
+    if (out->mantissa != 0 || digit != 0) {
+      if (++digits > 19) return false;
+    }
+
+    out->mantissa = out->mantissa * 10 + digit;
+
+    if (in_fraction) ++fraction_digits;
+  }
+
+  // at least one digit is required
+  if (!has_digits) return false;
+
+  int exponent = 0;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    ++p;
+
+    bool negative = false;
+
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+    uint64_t value = 0;
+
+    if (!parse_digits(p, end, &value) || value > 9999) return false;
+
+    exponent = negative ? -static_cast<int>(value) : static_cast<int>(value);
+    p = end;
+  }
+
+  if (p != end) return false;
+
+  out->exponent = exponent - fraction_digits;
+
+  return true;
+}
+
+}  // namespace
+
+bool str_to_int64(const char *begin, const char *end, int64_t *out) {
+  const bool negative = begin < end && *begin == '-';
+
+  if (begin < end && (*begin == '-' || *begin == '+')) ++begin;
+
+  uint64_t value = 0;
+
+  if (!parse_digits(begin, end, &value)) return false;
+
+  if (negative) {
+    if (value > static_cast<uint64_t>(INT64_MAX) + 1) return false;
+    *out = static_cast<int64_t>(0 - value);
+  } else {
+    if (value > static_cast<uint64_t>(INT64_MAX)) return false;
+    *out = static_cast<int64_t>(value);
+  }
+
+  return true;
+}
+
+bool str_to_uint64(const char *begin, const char *end, uint64_t *out) {
+  if (begin < end && *begin == '+') ++begin;
+
+  return parse_digits(begin, end, out);
+}
+
+bool str_to_double(const char *begin, const char *end, double *out) {
+  // powers of 10 which are exactly representable as a double
+  static constexpr double k_powers[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  Decimal_number number;
+
+  if (!parse_decimal(begin, end, &number)) return false;
+
+  // both mantissa and the power of 10 need to be exact, then the result of a
+  // single multiplication or division is correctly rounded
+  if (number.mantissa > (1ULL << 53) || number.exponent < -22 ||
+      number.exponent > 22) {
+    return false;
+  }
+
+  double value = static_cast<double>(number.mantissa);
+
+  if (number.exponent < 0) {
+    value /= k_powers[-number.exponent];
+  } else {
+    value *= k_powers[number.exponent];
+  }
+
+  *out = number.negative ? -value : value;
+  return true;
+}
+
+bool str_to_float(const char *begin, const char *end, float *out) {
+  // powers of 10 which are exactly representable as a float
+  static constexpr float k_powers[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f,
+                                       1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+
+  Decimal_number number;
+
+  if (!parse_decimal(begin, end, &number)) return false;
+
+  if (number.mantissa > (1ULL << 24) || number.exponent < -10 ||
+      number.exponent > 10) {
+    return false;
+  }
+
+  float value = static_cast<float>(number.mantissa);
+
+  if (number.exponent < 0) {
+    value /= k_powers[-number.exponent];
+  } else {
+    value *= k_powers[number.exponent];
+  }
+
+  *out = number.negative ? -value : value;
+  return true;
+}
+
 }  // namespace shcore
@@ -331,6 +331,52 @@ std::vector<std::string> str_break_into_lines(const std::string &line,
 std::pair<std::string::size_type, std::string::size_type> get_quote_span(
     const char quote_char, const std::string &str);
 
+/**
+ * Finds the first occurrence of any of the given characters in the
+ * [begin, end) range. Input is scanned 16 bytes at a time when SSE2 is
+ * available, which makes it suitable for skipping over long string bodies.
+ *
+ * @param begin beginning of the range.
+ * @param end end of the range.
+ * @param chars null terminated set of at most 8 characters to look for.
+ * @return pointer to the first matching character or end if none was found.
+ */
+const char *str_find_first_of(const char *begin, const char *end,
+                              const char *chars);
+
+/**
+ * Locale independent conversion of the [begin, end) range holding a decimal
+ * integer, with an optional sign, to a number. Whole range has to be a valid
+ * number.
+ *
+ * @param begin beginning of the range.
+ * @param end end of the range.
+ * @param out the converted value.
+ * @return false if the range is not a valid number or the number does not fit
+ *         into the target type.
+ */
+bool SHCORE_PUBLIC str_to_int64(const char *begin, const char *end,
+                                int64_t *out);
+bool SHCORE_PUBLIC str_to_uint64(const char *begin, const char *end,
+                                 uint64_t *out);
+
+/**
+ * Locale independent conversion of the [begin, end) range holding a number in
+ * the decimal or scientific notation. Only the numbers which can be converted
+ * exactly without extended precision arithmetic are handled, which includes
+ * all the values with up to 15 significant digits and a small exponent.
+ *
+ * @param begin beginning of the range.
+ * @param end end of the range.
+ * @param out the converted value.
+ * @return false if the range is not a valid number or it cannot be converted
+ *         exactly, caller should use strtod() in such case.
+ */
+bool SHCORE_PUBLIC str_to_double(const char *begin, const char *end,
+                                 double *out);
+bool SHCORE_PUBLIC str_to_float(const char *begin, const char *end,
+                                float *out);
+
 }  // namespace shcore
 
 #endif  // MYSQLSHDK_LIBS_UTILS_UTILS_STRING_H_
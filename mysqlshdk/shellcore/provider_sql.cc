@@ -27,9 +27,12 @@
 #include <iterator>
 #include <set>
 
-#include "modules/devapi/base_resultset.h"  // TODO(alfredo) remove when ISession
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/mysqlx/session.h"
+#include "mysqlshdk/libs/utils/logger.h"
 #include "mysqlshdk/libs/utils/utils_sqlstring.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/shell_init.h"
 
 namespace shcore {
 namespace completer {
@@ -37,7 +40,15 @@ namespace completer {
 namespace {
 
 extern std::vector<std::string> k_sorted_keywords;
+
+void sort_names(std::vector<std::string> *names) {
+  std::sort(names->begin(), names->end(),
+            [](const std::string &a, const std::string &b) -> bool {
+              return shcore::str_casecmp(a, b) < 0;
+            });
+  names->erase(std::unique(names->begin(), names->end()), names->end());
 }
+}  // namespace
 
 void add_matches_ci(const std::vector<std::string> &options,
                     Completion_list *out_list, const std::string &prefix,
@@ -60,6 +71,15 @@ void add_matches_ci(const std::vector<std::string> &options,
   }
 }
 
+Provider_sql::~Provider_sql() {
+  cancelled_ = true;
+  cancel_refresh();
+
+  std::lock_guard<std::mutex> lock(name_cache_->mutex);
+  if (name_cache_->session) name_cache_->session->close();
+  name_cache_->session.reset();
+}
+
 Completion_list Provider_sql::complete_schema(const std::string &prefix) {
   Completion_list list;
   add_matches_ci(schema_names_, &list, prefix);
@@ -120,43 +140,221 @@ Completion_list Provider_sql::complete(const std::string &text,
   // add DB objects
   add_matches_ci(schema_names_, &options, prefix, back_quote);
 
-  if (dot_pos != std::string::npos) {
-    add_matches_ci(object_dot_names_, &options, prefix, back_quote);
+  if (const auto objects = object_names()) {
+    if (dot_pos != std::string::npos) {
+      add_matches_ci(objects->dot_names, &options, prefix, back_quote);
+    }
+    add_matches_ci(objects->names, &options, prefix, back_quote);
   }
-  add_matches_ci(object_names_, &options, prefix, back_quote);
   return options;
 }
 
-void Provider_sql::interrupt_rehash() { cancelled_ = true; }
+void Provider_sql::interrupt_rehash() {
+  cancelled_ = true;
+  if (refresh_) refresh_->cancelled = true;
+}
+
+void Provider_sql::wait_name_cache() {
+  if (refresh_thread_.joinable()) refresh_thread_.join();
+}
+
+std::shared_ptr<const Provider_sql::Object_names> Provider_sql::object_names()
+    const {
+  std::lock_guard<std::mutex> lock(name_cache_->mutex);
+  return name_cache_->names;
+}
 
 void Provider_sql::refresh_schema_cache(
     std::shared_ptr<mysqlsh::ShellBaseSession> session) {
-  schema_names_.clear();
-  schema_names_.reserve(100);
-
-  auto res = session->raw_execute_sql("show schemas");
-  auto row = res->call("fetchOne", shcore::Argument_list());
-  while (row && !cancelled_) {
-    std::string column =
-        row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-    schema_names_.push_back(column);
-    row = res->call("fetchOne", shcore::Argument_list());
+  std::vector<std::string> schema_names;
+  schema_names.reserve(100);
+
+  auto res = session->get_core_session()->query("show schemas");
+  while (auto row = res->fetch_one()) {
+    if (cancelled_) break;
+    schema_names.push_back(row->get_string(0));
   }
-  std::sort(schema_names_.begin(), schema_names_.end(),
-            [](const std::string &a, const std::string &b) -> bool {
-              return shcore::str_casecmp(a, b) < 0;
-            });
+  sort_names(&schema_names);
+
+  schema_names_ = std::move(schema_names);
+}
+
+std::shared_ptr<Provider_sql::Object_names> Provider_sql::fetch_object_names(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session,
+    const std::string &schema, const std::vector<std::string> &table_names,
+    const std::atomic<bool> &cancelled) {
+  std::string query =
+      "SELECT TABLE_NAME, COLUMN_NAME FROM information_schema.COLUMNS "
+      "WHERE TABLE_SCHEMA = ?";
+
+  if (!table_names.empty()) {
+    query += " AND TABLE_NAME IN (";
+    for (size_t i = 0; i < table_names.size(); ++i)
+      query += i == 0 ? "?" : ", ?";
+    query += ")";
+  }
+
+  shcore::sqlstring sql(query.c_str(), 0);
+  sql << schema;
+  for (const auto &table : table_names) sql << table;
+
+  auto names = std::make_shared<Object_names>();
+  std::string last_table;
+
+  // all the columns of the schema are streamed by a single query, the rows
+  // of a table are consecutive
+  auto res = session->query(sql.str());
+  while (auto row = res->fetch_one()) {
+    if (cancelled) return nullptr;
+
+    std::string table = row->get_string(0);
+    std::string column = row->get_string(1);
+
+    if (table != last_table) {
+      names->names.push_back(table);
+      last_table = table;
+    }
+
+    // FIXME add quoting
+    names->dot_names.push_back(table + "." + column);
+    names->names.push_back(std::move(column));
+  }
+
+  sort_names(&names->names);
+  sort_names(&names->dot_names);
+
+  return names;
+}
+
+std::shared_ptr<mysqlshdk::db::ISession> Provider_sql::open_session(
+    bool classic, const mysqlshdk::db::Connection_options &options) {
+  std::shared_ptr<mysqlshdk::db::ISession> session;
+
+  if (classic)
+    session = mysqlshdk::db::mysql::Session::create();
+  else
+    session = mysqlshdk::db::mysqlx::Session::create();
+
+  session->connect(options);
+  return session;
+}
+
+void Provider_sql::fetch_names(const std::shared_ptr<Name_cache> &cache,
+                               const std::shared_ptr<Refresh> &refresh,
+                               const std::string &schema,
+                               const std::vector<std::string> &table_names) {
+  const bool classic = refresh->classic;
+  const auto &options = refresh->options;
+  std::shared_ptr<mysqlshdk::db::ISession> session;
+
+  {
+    // the idle session is taken, so it's not used by two threads at once
+    std::lock_guard<std::mutex> lock(cache->mutex);
+    session.swap(cache->session);
+
+    if (session && (!session->is_open() || cache->classic != classic ||
+                    !(cache->options == options))) {
+      session->close();
+      session.reset();
+    }
+  }
+
+  // the idle session may have been closed by the server, in that case the
+  // names are fetched again using a new one
+  bool reused = session != nullptr;
+
+  for (;;) {
+    try {
+      if (!session) session = open_session(classic, options);
+
+      // either the query is killed or the cancellation is noticed here
+      refresh->connection_id = session->get_connection_id();
+
+      std::shared_ptr<Object_names> names;
+      if (!refresh->cancelled) {
+        names = fetch_object_names(session, schema, table_names,
+                                   refresh->cancelled);
+      }
+
+      refresh->connection_id = 0;
+
+      std::lock_guard<std::mutex> lock(cache->mutex);
+
+      if (!refresh->cancelled) {
+        cache->names = names;
+
+        if (!cache->session) {
+          cache->session = session;
+          cache->classic = classic;
+          cache->options = options;
+          session.reset();
+        }
+      }
+    } catch (const std::exception &e) {
+      refresh->connection_id = 0;
+
+      if (reused && !refresh->cancelled) {
+        session->close();
+        session.reset();
+        reused = false;
+        continue;
+      }
+
+      if (!refresh->cancelled) {
+        log_warning("Error during auto-completion cache update: %s", e.what());
+      }
+    }
+
+    break;
+  }
+
+  // a cancelled query may have been killed, the session is not reused
+  if (session) session->close();
+}
+
+void Provider_sql::cancel_refresh() {
+  if (!refresh_) return;
+
+  {
+    std::lock_guard<std::mutex> lock(name_cache_->mutex);
+    refresh_->cancelled = true;
+  }
+
+  const uint64_t connection_id = refresh_->connection_id;
+
+  // the query is killed from a short-lived session, the global session is
+  // not used, as that would replace its warnings and last statement info
+  if (connection_id != 0) {
+    try {
+      const auto session = open_session(refresh_->classic, refresh_->options);
+      session->execute("KILL QUERY " + std::to_string(connection_id));
+      session->close();
+    } catch (const std::exception &e) {
+      log_info("Could not kill the auto-completion cache update: %s",
+               e.what());
+    }
+  }
+
+  if (refresh_thread_.joinable()) refresh_thread_.join();
+  refresh_.reset();
 }
 
 void Provider_sql::refresh_name_cache(
     std::shared_ptr<mysqlsh::ShellBaseSession> session,
     const std::string &current_schema,
     const std::vector<std::string> *table_names, bool rehash_all) {
+  const auto core_session = session->get_core_session();
+
+  // a refresh which is still running is not needed anymore
+  cancel_refresh();
   cancelled_ = false;
+
   default_schema_ = current_schema;
 
-  object_names_.clear();
-  object_dot_names_.clear();
+  {
+    std::lock_guard<std::mutex> lock(name_cache_->mutex);
+    name_cache_->names.reset();
+  }
 
   // cache schema names if not done yet
   if (schema_names_.empty() || rehash_all) {
@@ -164,52 +362,23 @@ void Provider_sql::refresh_name_cache(
   }
 
   if (!current_schema.empty() && !cancelled_) {
-    // fetch table names, if one was not provided
-    std::vector<std::string> schema_tables;
-    if (table_names == nullptr) {
-      table_names = &schema_tables;
-
-      auto res = session->raw_execute_sql(
-          shcore::sqlstring("show tables from !", 0) << current_schema);
-      auto row = res->call("fetchOne", shcore::Argument_list());
-      while (row && !cancelled_) {
-        std::string table =
-            row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-        object_names_.push_back(table);
-        schema_tables.push_back(table);
-        row = res->call("fetchOne", shcore::Argument_list());
-      }
-    }
+    std::vector<std::string> tables;
+    if (table_names) tables = *table_names;
 
-    // fetch column names for each table
-    for (const std::string &t : *table_names) {
-      if (cancelled_) break;
-      std::vector<std::string> column_names;
-      auto res = session->raw_execute_sql(
-          shcore::sqlstring("show columns from !.!", 0) << current_schema << t);
-      auto row = res->call("fetchOne", shcore::Argument_list());
-      while (row && !cancelled_) {
-        std::string column =
-            row.as_object<mysqlsh::Row>()->get_member(0).get_string();
-        // FIXME add quoting
-        object_names_.push_back(column);
-        object_dot_names_.push_back(t + "." + column);
-        row = res->call("fetchOne", shcore::Argument_list());
-      }
-    }
-    std::sort(object_names_.begin(), object_names_.end(),
-              [](const std::string &a, const std::string &b) -> bool {
-                return shcore::str_casecmp(a, b) < 0;
-              });
-    auto last = std::unique(object_names_.begin(), object_names_.end());
-    object_names_.erase(last, object_names_.end());
-
-    std::sort(object_dot_names_.begin(), object_dot_names_.end(),
-              [](const std::string &a, const std::string &b) -> bool {
-                return shcore::str_casecmp(a, b) < 0;
-              });
-    last = std::unique(object_dot_names_.begin(), object_dot_names_.end());
-    object_dot_names_.erase(last, object_dot_names_.end());
+    // names are fetched using a separate session, so the global session can
+    // be used while the query runs
+    const auto cache = name_cache_;
+    const auto refresh = std::make_shared<Refresh>();
+    refresh->classic =
+        std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(
+            core_session) != nullptr;
+    refresh->options = core_session->get_connection_options();
+    refresh_ = refresh;
+    refresh_thread_ = std::thread([cache, refresh, current_schema, tables]() {
+      mysqlsh::thread_init();
+      fetch_names(cache, refresh, current_schema, tables);
+      mysqlsh::thread_end();
+    });
   }
 }
 
@@ -24,8 +24,11 @@
 #ifndef MYSQLSHDK_SHELLCORE_PROVIDER_SQL_H_
 #define MYSQLSHDK_SHELLCORE_PROVIDER_SQL_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "mysqlshdk/libs/db/session.h"
@@ -37,16 +40,24 @@ namespace completer {
 
 class Provider_sql : public Provider {
  public:
+  ~Provider_sql() override;
+
   Completion_list complete(const std::string &text,
                            size_t *compl_offset) override;
 
   virtual void refresh_schema_cache(
       std::shared_ptr<mysqlsh::ShellBaseSession> session);
 
-  // void refresh_name_cache(std::shared_ptr<mysqlshdk::db::ISession> session,
-  //                         const std::string &current_schema,
-  //                         const std::vector<std::string> *table_names,
-  //                         bool rehash_all);
+  /**
+   * Starts fetching the table and column names of the given schema.
+   *
+   * The names are read with a single query, using a separate session in a
+   * background thread, so the caller is not blocked. The session is kept open
+   * and reused by the next refresh. A refresh which is still running is
+   * cancelled, its query is killed using a short-lived session and its thread
+   * is joined. Until the names are available, only keywords and schema names
+   * are completed.
+   */
   virtual void refresh_name_cache(
       std::shared_ptr<mysqlsh::ShellBaseSession> session,
       const std::string &current_schema,
@@ -54,14 +65,65 @@ class Provider_sql : public Provider {
 
   void interrupt_rehash();
 
+  /**
+   * Waits until the names being fetched in the background are available.
+   */
+  void wait_name_cache();
+
   Completion_list complete_schema(const std::string &prefix);
 
  private:
+  // names sorted case insensitively, searched using binary search
+  struct Object_names {
+    std::vector<std::string> names;
+    std::vector<std::string> dot_names;
+  };
+
+  static std::shared_ptr<Object_names> fetch_object_names(
+      const std::shared_ptr<mysqlshdk::db::ISession> &session,
+      const std::string &schema, const std::vector<std::string> &table_names,
+      const std::atomic<bool> &cancelled);
+
+  // shared with the background thread
+  struct Name_cache {
+    std::mutex mutex;
+    // replaced by the background thread once all names are fetched
+    std::shared_ptr<const Object_names> names;
+    // idle session used to fetch the names and the options it was opened with
+    std::shared_ptr<mysqlshdk::db::ISession> session;
+    bool classic = false;
+    mysqlshdk::db::Connection_options options;
+  };
+
+  struct Refresh {
+    std::atomic<bool> cancelled{false};
+    // ID of the connection which fetches the names, 0 if it's not running
+    std::atomic<uint64_t> connection_id{0};
+    // used to open the session which kills the query
+    bool classic = false;
+    mysqlshdk::db::Connection_options options;
+  };
+
+  static std::shared_ptr<mysqlshdk::db::ISession> open_session(
+      bool classic, const mysqlshdk::db::Connection_options &options);
+
+  static void fetch_names(const std::shared_ptr<Name_cache> &cache,
+                          const std::shared_ptr<Refresh> &refresh,
+                          const std::string &schema,
+                          const std::vector<std::string> &table_names);
+
+  void cancel_refresh();
+
+  std::shared_ptr<const Object_names> object_names() const;
+
   std::string default_schema_;
   std::vector<std::string> schema_names_;
-  std::vector<std::string> object_names_;
-  std::vector<std::string> object_dot_names_;
-  bool cancelled_;
+
+  std::shared_ptr<Name_cache> name_cache_ = std::make_shared<Name_cache>();
+
+  std::thread refresh_thread_;
+  std::shared_ptr<Refresh> refresh_;
+  std::atomic<bool> cancelled_{false};
 };
 
 }  // namespace completer
@@ -23,6 +23,7 @@
 
 #include "mysqlshdk/shellcore/shell_console.h"
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <utility>
@@ -85,6 +86,11 @@ class Shell_pager : public IPager {
     const auto &options = current_shell_options()->get();
 
     if (options.interactive && !options.pager.empty()) {
+      // anything printed so far has to be written before the pager output
+      if (m_original_delegate.flush) {
+        m_original_delegate.flush(m_original_delegate.user_data);
+      }
+
       m_pager = popen(options.pager.c_str(), "w");
 
       if (!m_pager) {
@@ -116,6 +122,8 @@ class Shell_pager : public IPager {
       if (m_delegate->print_diag) {
         m_delegate->print_diag = print_diag;
       }
+
+      m_delegate->flush = flush;
     }
   }
 
@@ -145,13 +153,27 @@ class Shell_pager : public IPager {
  private:
   static void print(void *user_data, const char *text) {
     const auto self = static_cast<Shell_pager *>(user_data);
-    fprintf(self->m_pager, "%s", text);
+    fputs(text, self->m_pager);
+
+    // stream is buffered, make sure that the pager does not wait for too long
+    const auto now = std::chrono::steady_clock::now();
+
+    if (now - self->m_last_flush >= std::chrono::milliseconds(100)) {
+      fflush(self->m_pager);
+      self->m_last_flush = now;
+    }
+  }
+
+  static void flush(void *user_data) {
+    const auto self = static_cast<Shell_pager *>(user_data);
     fflush(self->m_pager);
+    self->m_last_flush = std::chrono::steady_clock::now();
   }
 
   static shcore::Prompt_result prompt(void *user_data, const char *prompt,
                                       std::string *ret_input) {
     const auto self = static_cast<Shell_pager *>(user_data);
+    flush(self);
     return self->m_original_delegate.prompt(self->m_original_delegate.user_data,
                                             prompt, ret_input);
   }
@@ -159,18 +181,21 @@ class Shell_pager : public IPager {
   static shcore::Prompt_result password(void *user_data, const char *prompt,
                                         std::string *ret_password) {
     const auto self = static_cast<Shell_pager *>(user_data);
+    flush(self);
     return self->m_original_delegate.password(
         self->m_original_delegate.user_data, prompt, ret_password);
   }
 
   static void print_error(void *user_data, const char *text) {
     const auto self = static_cast<Shell_pager *>(user_data);
+    flush(self);
     self->m_original_delegate.print_error(self->m_original_delegate.user_data,
                                           text);
   }
 
   static void print_diag(void *user_data, const char *text) {
     const auto self = static_cast<Shell_pager *>(user_data);
+    flush(self);
     self->m_original_delegate.print_diag(self->m_original_delegate.user_data,
                                          text);
   }
@@ -180,6 +205,8 @@ class Shell_pager : public IPager {
   Delegate m_original_delegate;
 
   FILE *m_pager = nullptr;
+
+  std::chrono::steady_clock::time_point m_last_flush;
 };
 
 Shell_console::Shell_console(shcore::Interpreter_delegate *deleg)
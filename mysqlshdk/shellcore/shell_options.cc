@@ -30,6 +30,7 @@
 #include <limits>
 
 #include "mysqlshdk/libs/db/uri_common.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/shellcore/credential_manager.h"
 #include "shellcore/ishell_core.h"
 #include "shellcore/shell_notifications.h"
@@ -347,6 +348,16 @@ Shell_options::Shell_options(int argc, char **argv,
     (&storage.force, false, SHCORE_BATCH_CONTINUE_ON_ERROR, cmdline("--force"),
         "To use in SQL batch mode, forces processing to "
         "continue if an error is found.", shcore::opts::Read_only<bool>())
+    (&storage.batch_statements, 1, SHCORE_BATCH_STATEMENTS,
+        "Maximum number of consecutive DML statements sent to the server in a "
+        "single round trip when executing an SQL script in batch mode.",
+        shcore::opts::Range<int>(1, std::numeric_limits<int>::max()))
+    (&storage.batch_threads, 1, SHCORE_BATCH_THREADS,
+        "Number of sessions used to insert rows into different tables in "
+        "parallel when executing an SQL script in batch mode. Rows are "
+        "inserted in parallel only while foreign_key_checks is disabled, and "
+        "never into tables with foreign keys or triggers.",
+        shcore::opts::Range<int>(1, std::numeric_limits<int>::max()))
     (reinterpret_cast<int*>(&storage.log_level),
         ngcommon::Logger::LOG_INFO, "logLevel", cmdline("--log-level=value"),
         ngcommon::Logger::get_level_range_info(),
@@ -403,7 +414,10 @@ Shell_options::Shell_options(int argc, char **argv,
         "by default.")
     (&storage.default_compress, false, SHCORE_DEFAULT_COMPRESS,
         "Enable compression in client/server protocol by default "
-        "in global shell sessions.");
+        "in global shell sessions.")
+    (&storage.profile, false, SHCORE_PROFILE, cmdline("--profile"),
+        "Record the time spent in the stages of the shell operations, use "
+        "shell.profile() to print them.");
 
   add_startup_options()
     (cmdline("--name-cache"),
@@ -527,6 +541,14 @@ void Shell_options::set(const std::string &option, const shcore::Value &value) {
 }
 
 void Shell_options::notify(const std::string &option) {
+  if (option == SHCORE_PROFILE &&
+      storage.profile != mysqlshdk::utils::Profiler::running()) {
+    if (storage.profile)
+      mysqlshdk::utils::Profiler::start();
+    else
+      mysqlshdk::utils::Profiler::stop();
+  }
+
   shcore::Value::Map_type_ref info = shcore::Value::new_map().as_map();
   (*info)["option"] = shcore::Value(option);
   (*info)["value"] = get(option);
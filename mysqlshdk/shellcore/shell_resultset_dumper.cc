@@ -32,7 +32,9 @@
 #include "mysqlshdk/include/shellcore/base_shell.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/libs/db/column.h"
+#include "mysqlshdk/libs/db/row_copy.h"
 #include "mysqlshdk/libs/utils/dtoa.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_json.h"
 #include "shellcore/interrupt_handler.h"
@@ -41,6 +43,17 @@
 
 #define MAX_DISPLAY_LENGTH 1024
 
+// Number of rows used to calculate the column widths in table format before
+// the rows start being printed, results bigger than this are streamed
+#define TABLE_SAMPLE_ROWS 1000
+
+// Upper limit for the column width taken from the column metadata when a
+// table is being streamed
+#define MAX_METADATA_DISPLAY_LENGTH 64
+
+// Amount of JSON output which is collected before it's printed
+#define JSON_OUTPUT_CHUNK_SIZE (64 * 1024)
+
 namespace mysqlsh {
 
 /* Calculates the required buffer size and display size considering:
@@ -223,6 +236,7 @@ class Field_formatter {
         m_max_display_length(0),
         m_max_buffer_length(0),
         m_max_mb_holes(0),
+        m_frozen(false),
         m_format(format),
         m_type(column.get_type()),
         m_is_numeric(column.is_numeric()) {
@@ -273,6 +287,7 @@ class Field_formatter {
     m_max_display_length = other.m_max_display_length;
     m_max_buffer_length = other.m_max_buffer_length;
     m_max_mb_holes = other.m_max_mb_holes;
+    m_frozen = other.m_frozen;
 
     // Length cache for each data to be printed with this formatter
     m_display_lengths = std::move(other.m_display_lengths);
@@ -294,9 +309,11 @@ class Field_formatter {
     if (row->is_null(index)) {
       dlength = blength = 4;
     } else if (m_is_numeric) {
-      auto str = get_number_string(row, index);
-      dlength = blength = str.length();
-    } else if (m_type == mysqlshdk::db::Type::Bytes) {
+      char buffer[k_number_buffer_size];
+      std::string tmp;
+      dlength = blength = get_number_data(row, index, buffer, &tmp).second;
+    } else if (m_type == mysqlshdk::db::Type::Bytes ||
+               m_type == mysqlshdk::db::Type::String) {
       auto data = row->get_string_data(index);
       auto fsizes = get_utf8_sizes(data.first, data.second, m_flags);
       dlength = std::get<0>(fsizes);
@@ -308,44 +325,85 @@ class Field_formatter {
       blength = std::get<1>(fsizes);
     }
 
+    m_display_lengths.push_back(dlength);
+    m_buffer_lengths.push_back(blength);
+
+    // Once the column width is fixed the lengths are only needed to print
+    // the data
+    if (m_frozen) return;
+
     m_max_mb_holes = std::max<size_t>(m_max_mb_holes, blength - dlength);
 
     m_max_display_length = std::max<size_t>(m_max_display_length, dlength);
 
     m_max_buffer_length = std::max<size_t>(m_max_buffer_length, blength);
+  }
 
-    m_display_lengths.push_back(dlength);
-    m_buffer_lengths.push_back(blength);
+  /**
+   * Fixes the column width so it is no longer updated by process(), used when
+   * the rows are printed before the whole result is known.
+   *
+   * The width is extended using the column metadata for the types with a well
+   * known display length, data which does not fit is printed unformatted.
+   */
+  void freeze(const mysqlshdk::db::Column &column) {
+    assert(m_format == ResultFormat::TABLE);
 
-    m_max_mb_holes = std::max<size_t>(m_max_mb_holes, blength - dlength);
+    switch (m_type) {
+      case mysqlshdk::db::Type::Integer:
+      case mysqlshdk::db::Type::UInteger:
+      case mysqlshdk::db::Type::Float:
+      case mysqlshdk::db::Type::Double:
+      case mysqlshdk::db::Type::Decimal:
+      case mysqlshdk::db::Type::Date:
+      case mysqlshdk::db::Type::Time:
+      case mysqlshdk::db::Type::DateTime: {
+        size_t length = std::min<size_t>(column.get_length(),
+                                         MAX_METADATA_DISPLAY_LENGTH);
+        m_max_display_length = std::max(m_max_display_length, length);
+        m_max_buffer_length = std::max(m_max_buffer_length, length);
+        break;
+      }
+      default:
+        break;
+    }
+
+    m_frozen = true;
   }
 
   ~Field_formatter() {}
 
-  std::string get_number_string(const mysqlshdk::db::IRow *row, size_t index) {
-    std::string tmp;
+  static constexpr size_t k_number_buffer_size = 32;
+
+  /**
+   * Formats a numeric field, integer and floating point values are written to
+   * the given buffer of k_number_buffer_size bytes, other types are copied to
+   * tmp.
+   */
+  std::pair<const char *, size_t> get_number_data(
+      const mysqlshdk::db::IRow *row, size_t index, char *buffer,
+      std::string *tmp) {
+    size_t len = 0;
     if (m_type == mysqlshdk::db::Type::Float) {
       auto value = row->get_float(index);
-      char buffer[32];
-      size_t len;
-      len = my_gcvt(value, MY_GCVT_ARG_FLOAT, sizeof(buffer) - 1, buffer, NULL);
-      tmp.assign(buffer, len);
+      len = my_gcvt(value, MY_GCVT_ARG_FLOAT, k_number_buffer_size - 1, buffer,
+                    NULL);
     } else if (m_type == mysqlshdk::db::Type::Integer) {
-      return std::to_string(row->get_int(index));
+      len = snprintf(buffer, k_number_buffer_size, "%" PRId64,
+                     row->get_int(index));
     } else if (m_type == mysqlshdk::db::Type::UInteger) {
-      return std::to_string(row->get_uint(index));
+      len = snprintf(buffer, k_number_buffer_size, "%" PRIu64,
+                     row->get_uint(index));
     } else if (m_type == mysqlshdk::db::Type::Double) {
       auto value = row->get_double(index);
-      char buffer[32];
-      size_t len;
-      len =
-          my_gcvt(value, MY_GCVT_ARG_DOUBLE, sizeof(buffer) - 1, buffer, NULL);
-      tmp.assign(buffer, len);
+      len = my_gcvt(value, MY_GCVT_ARG_DOUBLE, k_number_buffer_size - 1,
+                    buffer, NULL);
     } else {
-      return row->get_as_string(index);
+      *tmp = row->get_as_string(index);
+      return {tmp->data(), tmp->length()};
     }
 
-    return tmp;
+    return {buffer, len};
   }
 
   bool put(const mysqlshdk::db::IRow *row, size_t index) {
@@ -354,18 +412,25 @@ class Field_formatter {
     if (row->is_null(index)) {
       append("NULL", 4);
     } else if (m_is_numeric) {
-      std::string tmp = get_number_string(row, index);
+      char buffer[k_number_buffer_size];
+      std::string tmp;
+      auto data = get_number_data(row, index, buffer, &tmp);
 
-      if (m_zerofill > tmp.length()) {
-        tmp = std::string(m_zerofill - tmp.length(), '0').append(tmp);
+      if (m_zerofill > data.second) {
+        tmp = std::string(m_zerofill - data.second, '0')
+                  .append(data.first, data.second);
+        data = {tmp.data(), tmp.length()};
 
-        // Updates the display length with the new size
+        // Updates the cached lengths with the new size, digits take a single
+        // byte each
         if (m_format == ResultFormat::TABLE) {
           m_display_lengths[0] = tmp.length();
+          m_buffer_lengths[0] = tmp.length();
         }
       }
-      append(tmp.data(), tmp.length());
-    } else if (m_type == mysqlshdk::db::Type::Bytes) {
+      return append(data.first, data.second);
+    } else if (m_type == mysqlshdk::db::Type::Bytes ||
+               m_type == mysqlshdk::db::Type::String) {
       auto data = row->get_string_data(index);
       return append(data.first, data.second);
     } else if (m_type == mysqlshdk::db::Type::Bit) {
@@ -394,6 +459,7 @@ class Field_formatter {
   size_t m_max_display_length;
   size_t m_max_buffer_length;
   size_t m_max_mb_holes;
+  bool m_frozen;
 
   // Length cache for each data to be printed with this formatter
   std::deque<size_t> m_display_lengths;
@@ -439,6 +505,12 @@ class Field_formatter {
 
     if (buffer_size > m_allocated) return false;
 
+    // On a frozen column the data may not fit into the column width
+    if (m_format == ResultFormat::TABLE &&
+        (display_size > m_max_display_length ||
+         buffer_size > display_size + m_max_mb_holes))
+      return false;
+
     size_t next_index = 0;
     if (m_format == ResultFormat::TABLE) {
       if (m_align_right && m_max_display_length > display_size) {
@@ -499,6 +571,7 @@ Resultset_dumper::Resultset_dumper(mysqlshdk::db::IResult *target,
 
 void Resultset_dumper::dump(const std::string &item_label, bool is_query,
                             bool is_doc_result) {
+  mysqlshdk::utils::Profile_stage stage("Print result");
   std::string output;
   shcore::Interrupt_handler intr([this]() {
     _cancelled = true;
@@ -511,9 +584,16 @@ void Resultset_dumper::dump(const std::string &item_label, bool is_query,
     do {
       size_t count = 0;
       if (_rset->has_resultset()) {
-        // Data requires to be buffered on table format because it will be
-        // traversec once for proper formatting and once for printing it
-        if (_buffer_data || _format == "table") _rset->buffer();
+        // Table format does not require the data to be buffered, the column
+        // widths are calculated using a window of rows which is printed
+        // before the rest of the result is fetched
+        if (_buffer_data) {
+          mysqlshdk::utils::Profile_stage fetch_stage("Fetch rows");
+          _rset->buffer();
+        }
+
+        // rows which are not buffered are fetched while they are formatted
+        mysqlshdk::utils::Profile_stage format_stage("Format rows");
 
         if (is_doc_result)
           count = dump_documents();
@@ -567,8 +647,17 @@ void Resultset_dumper::dump(const std::string &item_label, bool is_query,
   if (_buffer_data) _rset->rewind();
 }
 
+void Resultset_dumper::flush_json(shcore::JSON_dumper *dumper, bool all) {
+  // rows are written out in chunks, so memory usage does not depend on the
+  // number of rows
+  if (dumper->size() > 0 && (all || dumper->size() >= JSON_OUTPUT_CHUNK_SIZE)) {
+    mysqlsh::current_console()->raw_print(dumper->flush(),
+                                          mysqlsh::Output_stream::STDOUT, false);
+  }
+}
+
 size_t Resultset_dumper::dump_documents() {
-  auto metadata = _rset->get_metadata();
+  const auto &metadata = _rset->get_metadata();
   auto row = _rset->fetch_one();
   size_t row_count = 0;
 
@@ -578,27 +667,29 @@ size_t Resultset_dumper::dump_documents() {
   // specified
   shcore::JSON_dumper dumper(_format != "json/raw");
 
+  auto console = mysqlsh::current_console();
+
   dumper.start_array();
 
   while (row) {
     dumper.append_json(row->get_string(0));
 
+    flush_json(&dumper, false);
+
     row_count++;
     row = _rset->fetch_one();
   }
 
   dumper.end_array();
 
-  auto console = mysqlsh::current_console();
-
-  console->raw_print(dumper.str(), mysqlsh::Output_stream::STDOUT, false);
+  flush_json(&dumper, true);
   console->raw_print("\n", mysqlsh::Output_stream::STDOUT, false);
 
   return row_count;
 }
 
 size_t Resultset_dumper::dump_tabbed() {
-  auto metadata = _rset->get_metadata();
+  const auto &metadata = _rset->get_metadata();
   auto row = _rset->fetch_one();
   size_t row_index = 0;
 
@@ -613,7 +704,7 @@ size_t Resultset_dumper::dump_tabbed() {
 
   // Prints the initial separator line and the column headers
   for (index = 0; index < field_count; index++) {
-    auto column = metadata[index];
+    const auto &column = metadata[index];
 
     fmt.emplace_back(ResultFormat::TABBED, column);
     console->print(column.get_column_label().c_str());
@@ -623,11 +714,10 @@ size_t Resultset_dumper::dump_tabbed() {
   // Now prints the records
   while (row && !_cancelled) {
     for (size_t field_index = 0; field_index < field_count; field_index++) {
-      auto column = metadata[field_index];
       if (fmt[field_index].put(row, field_index)) {
         console->print(fmt[field_index].c_str());
       } else {
-        mysqlshdk::db::is_string_type(column.get_type());
+        assert(mysqlshdk::db::is_string_type(metadata[field_index].get_type()));
         console->print(row->get_string(field_index));
       }
       console->print(field_index < (field_count - 1) ? "\t" : "\n");
@@ -641,7 +731,7 @@ size_t Resultset_dumper::dump_tabbed() {
 }
 
 size_t Resultset_dumper::dump_vertical() {
-  auto metadata = _rset->get_metadata();
+  const auto &metadata = _rset->get_metadata();
 
   std::string star_separator(27, '*');
 
@@ -654,6 +744,14 @@ size_t Resultset_dumper::dump_vertical() {
     max_col_len = std::max(max_col_len, column.get_column_label().length());
     fmt.emplace_back(ResultFormat::VERTICAL, column);
   }
+
+  // labels are the same for all the rows
+  std::vector<std::string> labels;
+  for (const auto &column : metadata) {
+    labels.emplace_back(
+        std::string(max_col_len - column.get_column_label().size(), ' ') +
+        column.get_column_label() + ": ");
+  }
   auto console = mysqlsh::current_console();
 
   auto row = _rset->fetch_one();
@@ -666,16 +764,11 @@ size_t Resultset_dumper::dump_vertical() {
     console->print(row_header);
 
     for (size_t col_index = 0; col_index < metadata.size(); col_index++) {
-      auto column = metadata[col_index];
-
-      std::string padding(max_col_len - column.get_column_label().size(), ' ');
-      std::string label = padding + column.get_column_label() + ": ";
-
-      console->print(label);
+      console->print(labels[col_index]);
       if (fmt[col_index].put(row, col_index)) {
         console->print(fmt[col_index].c_str());
       } else {
-        assert(mysqlshdk::db::is_string_type(column.get_type()));
+        assert(mysqlshdk::db::is_string_type(metadata[col_index].get_type()));
         console->print(row->get_string(col_index));
       }
       console->raw_print("\n", mysqlsh::Output_stream::STDOUT, false);
@@ -702,7 +795,7 @@ size_t Resultset_dumper::dump_json(const std::string &item_label,
 
   size_t row_count = 0;
   if (_rset->has_resultset()) {
-    auto metadata = _rset->get_metadata();
+    const auto &metadata = _rset->get_metadata();
     auto row = _rset->fetch_one();
     while (row) {
       if (is_doc_result) {
@@ -711,7 +804,7 @@ size_t Resultset_dumper::dump_json(const std::string &item_label,
         dumper.start_object();
 
         for (size_t col_index = 0; col_index < metadata.size(); col_index++) {
-          auto column = metadata[col_index];
+          const auto &column = metadata[col_index];
 
           dumper.append_string(column.get_column_label());
           auto type = column.get_type();
@@ -720,7 +813,8 @@ size_t Resultset_dumper::dump_json(const std::string &item_label,
           } else if (mysqlshdk::db::is_string_type(type)) {
             if (type == mysqlshdk::db::Type::Json) {
               dumper.append_json(row->get_string(col_index));
-            } else if (type == mysqlshdk::db::Type::Bytes) {
+            } else if (type == mysqlshdk::db::Type::Bytes ||
+                       type == mysqlshdk::db::Type::String) {
               auto data = row->get_string_data(col_index);
               dumper.append_string(data.first, data.second);
             } else {
@@ -743,6 +837,9 @@ size_t Resultset_dumper::dump_json(const std::string &item_label,
         }
         dumper.end_object();
       }
+
+      flush_json(&dumper, false);
+
       row_count++;
       row = _rset->fetch_one();
     }
@@ -797,18 +894,68 @@ size_t Resultset_dumper::dump_json(const std::string &item_label,
 
   dumper.end_object();
 
+  flush_json(&dumper, true);
+  mysqlsh::current_console()->raw_print("\n", mysqlsh::Output_stream::STDOUT,
+                                        false);
+
+  return row_count;
+}
+
+namespace {
+std::string table_separator(const std::vector<Field_formatter> &fmt) {
+  std::string separator("+");
+  for (const auto &field : fmt) {
+    std::string field_separator(field.get_max_display_length() + 2, '-');
+    field_separator.append("+");
+    separator.append(field_separator);
+  }
+  separator.append("\n");
+
+  return separator;
+}
+
+void print_table_header(const std::vector<mysqlshdk::db::Column> &metadata,
+                        const std::vector<Field_formatter> &fmt,
+                        const std::string &separator) {
+  size_t field_count = metadata.size();
+
+  // Prints the initial separator line and the column headers
   auto console = mysqlsh::current_console();
+  console->print(separator);
+  console->print("| ");
+  for (size_t index = 0; index < field_count; index++) {
+    std::string format = "%-";
+    format.append(std::to_string(fmt[index].get_max_display_length()));
+    format.append((index == field_count - 1) ? "s |\n" : "s | ");
+    console->print(shcore::str_format(
+        format.c_str(), metadata[index].get_column_label().c_str()));
+  }
+  console->print(separator);
+}
 
-  console->raw_print(dumper.str(), mysqlsh::Output_stream::STDOUT, false);
-  console->raw_print("\n", mysqlsh::Output_stream::STDOUT, false);
+void print_table_row(const mysqlshdk::db::IRow *row,
+                     std::vector<Field_formatter> *fmt) {
+  size_t field_count = fmt->size();
+  auto console = mysqlsh::current_console();
 
-  return row_count;
+  console->print("| ");
+
+  for (size_t field_index = 0; field_index < field_count; field_index++) {
+    if ((*fmt)[field_index].put(row, field_index)) {
+      console->print((*fmt)[field_index].c_str());
+    } else {
+      // Data does not fit into the formatter, it is printed as is
+      console->print(row->get_as_string(field_index));
+    }
+    if (field_index < field_count - 1) console->print(" | ");
+  }
+  console->print(" |\n");
 }
+}  // namespace
 
 size_t Resultset_dumper::dump_table() {
-  auto metadata = _rset->get_metadata();
+  const auto &metadata = _rset->get_metadata();
 
-  std::vector<std::string> columns;
   std::vector<Field_formatter> fmt;
 
   size_t field_count = metadata.size();
@@ -817,12 +964,11 @@ size_t Resultset_dumper::dump_table() {
   // Updates the max_length array with the maximum length between column name,
   // min column length and column max length
   for (size_t field_index = 0; field_index < field_count; field_index++) {
-    auto column = metadata[field_index];
-
-    columns.push_back(column.get_column_label());
-    fmt.emplace_back(ResultFormat::TABLE, column);
+    fmt.emplace_back(ResultFormat::TABLE, metadata[field_index]);
   }
 
+  if (!_buffer_data) return stream_table(&fmt);
+
   std::vector<const mysqlshdk::db::IRow *> records;
   auto row = _rset->fetch_one();
   while (row && !_cancelled) {
@@ -837,55 +983,78 @@ size_t Resultset_dumper::dump_table() {
 
   if (_cancelled || records.empty()) return 0;
 
-  //-----------
+  std::string separator = table_separator(fmt);
+  print_table_header(metadata, fmt, separator);
 
-  size_t index = 0;
+  // Now prints the records
+  row = _rset->fetch_one();
+  while (row && !_cancelled) {
+    print_table_row(row, &fmt);
+    row = _rset->fetch_one();
+  }
 
-  std::string separator("+");
-  for (index = 0; index < field_count; index++) {
-    std::string field_separator(fmt[index].get_max_display_length() + 2, '-');
-    field_separator.append("+");
-    separator.append(field_separator);
+  _rset->rewind();
+
+  mysqlsh::current_console()->print(separator);
+
+  return records.size();
+}
+
+/**
+ * Prints the result in table format without holding it in memory.
+ *
+ * The column widths are calculated using the first TABLE_SAMPLE_ROWS rows,
+ * so the output is identical to the buffered one for results which fit in
+ * that window. On bigger results the widths are completed with the column
+ * metadata and the rest of the rows are printed as they are fetched.
+ */
+size_t Resultset_dumper::stream_table(std::vector<Field_formatter> *fmt) {
+  const auto &metadata = _rset->get_metadata();
+  size_t field_count = metadata.size();
+
+  // Rows returned by fetch_one() are only valid until the next fetch, so the
+  // sample needs its own copy of the data
+  std::vector<mysqlshdk::db::Row_copy> sample;
+  auto row = _rset->fetch_one();
+  while (row && !_cancelled && sample.size() < TABLE_SAMPLE_ROWS) {
+    sample.emplace_back(*row);
+    for (size_t field_index = 0; field_index < field_count; field_index++) {
+      (*fmt)[field_index].process(row, field_index);
+    }
+    row = _rset->fetch_one();
   }
-  separator.append("\n");
 
-  // Prints the initial separator line and the column headers
-  auto console = mysqlsh::current_console();
-  console->print(separator);
-  console->print("| ");
-  for (index = 0; index < field_count; index++) {
-    std::string format = "%-";
-    format.append(std::to_string(fmt[index].get_max_display_length()));
-    format.append((index == field_count - 1) ? "s |\n" : "s | ");
-    auto column = metadata[index];
-    console->print(
-        shcore::str_format(format.c_str(), column.get_column_label().c_str()));
+  if (_cancelled || sample.empty()) return 0;
+
+  if (row) {
+    for (size_t field_index = 0; field_index < field_count; field_index++) {
+      (*fmt)[field_index].freeze(metadata[field_index]);
+    }
   }
-  console->print(separator);
 
-  // Now prints the records
-  row = _rset->fetch_one();
-  while (row && !_cancelled) {
-    console->print("| ");
+  std::string separator = table_separator(*fmt);
+  print_table_header(metadata, *fmt, separator);
 
+  size_t row_count = 0;
+  for (const auto &record : sample) {
+    if (_cancelled) break;
+    print_table_row(&record, fmt);
+    row_count++;
+  }
+  sample.clear();
+
+  while (row && !_cancelled) {
     for (size_t field_index = 0; field_index < field_count; field_index++) {
-      if (fmt[field_index].put(row, field_index)) {
-        console->print(fmt[field_index].c_str());
-      } else {
-        assert(mysqlshdk::db::is_string_type(metadata[field_index].get_type()));
-        console->print(row->get_as_string(field_index));
-      }
-      if (field_index < field_count - 1) console->print(" | ");
+      (*fmt)[field_index].process(row, field_index);
     }
-    console->print(" |\n");
+    print_table_row(row, fmt);
+    row_count++;
     row = _rset->fetch_one();
   }
 
-  _rset->rewind();
+  mysqlsh::current_console()->print(separator);
 
-  console->print(separator.c_str());
-
-  return records.size();
+  return row_count;
 }
 
 std::string Resultset_dumper::get_affected_stats(
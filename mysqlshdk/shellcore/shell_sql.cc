@@ -29,7 +29,9 @@
 #include "modules/mod_mysql_session.h"
 #include "mysqlshdk/include/shellcore/console.h"
 #include "mysqlshdk/include/shellcore/utils_help.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
 #include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/shellcore/sql_parallel_loader.h"
 #include "shellcore/base_session.h"
 #include "shellcore/interrupt_handler.h"
 #include "shellcore/shell_options.h"
@@ -59,6 +61,51 @@ namespace shcore {
 // How many bytes at a time to process when executing large SQL scripts
 static constexpr auto k_sql_chunk_size = 64 * 1024;
 
+// Maximum size of the statements sent together when batching is enabled, kept
+// well below the default max_allowed_packet of the server
+static constexpr size_t k_sql_batch_size = 1024 * 1024;
+
+namespace {
+/**
+ * Returns true if the statement is a DML statement which can be sent to the
+ * server together with other statements of the same kind.
+ */
+bool is_batchable(const char *sql, size_t len, const std::string &delimiter) {
+  // the server splits the statements of a batch on ';', which is also the only
+  // delimiter that does not require special output handling
+  if (delimiter != ";") return false;
+
+  const char *p = sql;
+  const char *end = sql + len;
+
+  // skip the whitespace and comments before the statement
+  while (p < end) {
+    if (isspace(static_cast<unsigned char>(*p))) {
+      ++p;
+    } else if (*p == '#' || (end - p > 2 && p[0] == '-' && p[1] == '-' &&
+                             isspace(static_cast<unsigned char>(p[2])))) {
+      while (p < end && *p != '\n') ++p;
+    } else if (end - p > 1 && p[0] == '/' && p[1] == '*') {
+      // conditional comments may hide anything, so they are not skipped
+      if (end - p > 2 && p[2] == '!') return false;
+      p += 2;
+      while (p < end && !(p[0] == '*' && p + 1 < end && p[1] == '/')) ++p;
+      if (p == end) return false;
+      p += 2;
+    } else {
+      break;
+    }
+  }
+
+  const char *word = p;
+  while (p < end && isalpha(static_cast<unsigned char>(*p))) ++p;
+
+  std::string keyword = shcore::str_upper(std::string(word, p - word));
+  return keyword == "INSERT" || keyword == "UPDATE" || keyword == "DELETE" ||
+         keyword == "REPLACE";
+}
+}  // namespace
+
 Shell_sql::Shell_sql(IShell_core *owner)
     : Shell_language(owner),
       m_splitter(
@@ -101,6 +148,8 @@ bool Shell_sql::process_sql(const char *query_str, size_t query_len,
                             std::shared_ptr<mysqlshdk::db::ISession> session) {
   bool ret_val = false;
   if (session) {
+    mysqlshdk::utils::Profile_stage stage("SQL statement");
+
     try {
       std::shared_ptr<mysqlshdk::db::IResult> result;
       Sql_result_info info;
@@ -145,6 +194,72 @@ bool Shell_sql::process_sql(const char *query_str, size_t query_len,
   return ret_val;
 }
 
+bool Shell_sql::flush_batch(
+    std::shared_ptr<mysqlshdk::db::mysql::Session> session,
+    bool stop_on_error) {
+  mysqlshdk::utils::Profile_stage stage("SQL batch");
+  bool ret_val = true;
+  size_t next = 0;
+
+  while (next < m_batch_statements.size()) {
+    std::vector<std::shared_ptr<mysqlshdk::db::IResult>> results;
+    std::unique_ptr<shcore::Exception> error;
+
+    try {
+      // Install kill query as ^C handler
+      uint64_t conn_id = session->get_connection_id();
+      const auto &conn_opts = session->get_connection_options();
+      Interrupts::push_handler([this, conn_id, conn_opts]() {
+        kill_query(conn_id, conn_opts);
+        return true;
+      });
+
+      const size_t offset = m_batch_statements[next].offset;
+      session->execute_batch(&m_batch[offset], m_batch.size() - offset,
+                             &results);
+      Interrupts::pop_handler();
+    } catch (mysqlshdk::db::Error &e) {
+      Interrupts::pop_handler();
+      error.reset(new shcore::Exception(
+          shcore::Exception::mysql_error_with_code_and_state(
+              e.what(), e.code(), e.sqlstate())));
+    } catch (...) {
+      Interrupts::pop_handler();
+      m_batch.clear();
+      m_batch_statements.clear();
+      throw;
+    }
+
+    // Results are reported in the same way as if the statements were
+    // executed one by one
+    for (const auto &result : results) {
+      const auto &stmt = m_batch_statements[next++];
+      Sql_result_info info;
+      info.ellapsed_seconds = result->get_execution_time();
+      _result_processor(result, info);
+      _last_handled.append(&m_batch[stmt.offset], stmt.length)
+          .append(stmt.delimiter);
+    }
+
+    if (error) {
+      const auto &stmt = m_batch_statements[next++];
+      if (stmt.line_num > 0) error->set_file_context("", stmt.line_num);
+      print_exception(*error);
+      _last_handled.append(&m_batch[stmt.offset], stmt.length)
+          .append(stmt.delimiter);
+      ret_val = false;
+
+      // the statements after the failed one were not executed by the server
+      if (stop_on_error) break;
+    }
+  }
+
+  m_batch.clear();
+  m_batch_statements.clear();
+
+  return ret_val;
+}
+
 bool Shell_sql::handle_input_stream(std::istream *istream) {
   std::shared_ptr<mysqlshdk::db::ISession> session;
   {
@@ -155,19 +270,105 @@ bool Shell_sql::handle_input_stream(std::istream *istream) {
       session = s->get_core_session();
   }
 
+  const auto &options = mysqlsh::current_shell_options()->get();
+  const bool force = options.force;
+  const size_t batch_statements = options.batch_statements;
+
+  // Consecutive DML statements are sent together only on classic sessions
+  std::shared_ptr<mysqlshdk::db::mysql::Session> batch_session;
+  if (batch_statements > 1)
+    batch_session =
+        std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(session);
+
+  std::unique_ptr<Sql_parallel_loader> loader;
+  if (options.batch_threads > 1 && session) {
+    try {
+      loader.reset(new Sql_parallel_loader(
+          session, options.batch_threads, !force,
+          [this](const shcore::Exception &e) { print_exception(e); }));
+    } catch (mysqlshdk::db::Error &e) {
+      print_exception(shcore::Exception::mysql_error_with_code_and_state(
+          e.what(), e.code(), e.sqlstate()));
+      _result_processor(nullptr, {});
+      return false;
+    }
+  }
+
+  // ^C aborts the statements executed by the loader as well
+  Interrupt_handler interrupt_loader(
+      [&loader]() {
+        loader->interrupt();
+        return true;
+      },
+      !loader);
+
+  const auto finish = [this, &loader, batch_session, force]() {
+    bool ret_val = true;
+    if (!m_batch_statements.empty() && !flush_batch(batch_session, !force))
+      ret_val = false;
+    if (loader && !loader->wait()) ret_val = false;
+    return ret_val || force;
+  };
+
   if (!mysqlshdk::utils::iterate_sql_stream(
           istream, k_sql_chunk_size,
-          [this, session](const char *s, size_t len, const std::string &delim,
-                          size_t lnum) {
-            if (len > 0 && !process_sql(s, len, delim, lnum, session)) {
-              if (!mysqlsh::current_shell_options()->get().force) return false;
+          [this, session, batch_session, batch_statements, force, &loader](
+              const char *s, size_t len, const std::string &delim,
+              size_t lnum) {
+            if (len == 0) return true;
+
+            // inserts into different tables are executed in parallel, after
+            // the statements which precede them
+            if (loader && delim == ";" && loader->accepts(s, len)) {
+              if (!m_batch_statements.empty() &&
+                  !flush_batch(batch_session, !force) && !force)
+                return false;
+
+              loader->execute(s, len, lnum);
+              _last_handled.append(s, len).append(delim);
+              return loader->ok() || force;
+            }
+
+            if (loader && !loader->wait() && !force) return false;
+
+            if (batch_session && len < k_sql_batch_size &&
+                is_batchable(s, len, delim)) {
+              if (m_batch.size() + len >= k_sql_batch_size &&
+                  !flush_batch(batch_session, !force) && !force)
+                return false;
+
+              m_batch_statements.push_back(
+                  {m_batch.size(), len, delim, lnum});
+              m_batch.append(s, len).append(";\n");
+
+              if (m_batch_statements.size() >= batch_statements &&
+                  !flush_batch(batch_session, !force) && !force)
+                return false;
+
+              return true;
+            }
+
+            // statements which are not batched need to be executed after the
+            // ones already waiting
+            if (!m_batch_statements.empty() &&
+                !flush_batch(batch_session, !force) && !force)
+              return false;
+
+            if (!process_sql(s, len, delim, lnum, session)) {
+              if (!force) return false;
+            } else if (loader) {
+              loader->executed(s, len, delim);
             }
             return true;
           },
           [](const std::string &err) {
             mysqlsh::current_console()->print_error(err);
           },
-          false)) {
+          false) ||
+      !finish()) {
+    m_batch.clear();
+    m_batch_statements.clear();
+
     // signal error during input processing
     _result_processor(nullptr, {});
     return false;
@@ -0,0 +1,771 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include "mysqlshdk/shellcore/sql_parallel_loader.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/db/mysqlx/session.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "shellcore/shell_init.h"
+
+namespace shcore {
+
+namespace {
+
+// Maximum size of the statements waiting to be executed by a single worker
+constexpr size_t k_max_queued_bytes = 16 * 1024 * 1024;
+
+// Functions whose result depends on the session executing them
+const char *k_session_functions[] = {"LAST_INSERT_ID", "ROW_COUNT",
+                                     "FOUND_ROWS",     "CONNECTION_ID",
+                                     "RAND",           "UUID",
+                                     "UUID_SHORT",     "SELECT"};
+
+inline bool is_space(char c) {
+  return std::isspace(static_cast<unsigned char>(c));
+}
+
+inline bool is_word_char(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$' ||
+         c == '@';
+}
+
+/**
+ * Skips whitespace and comments. Contents of conditional comments are handled
+ * as regular statement text.
+ */
+const char *skip_blanks(const char *p, const char *end) {
+  while (p < end) {
+    if (is_space(*p)) {
+      ++p;
+    } else if (*p == '#' ||
+               (end - p > 2 && p[0] == '-' && p[1] == '-' && is_space(p[2]))) {
+      while (p < end && *p != '\n') ++p;
+    } else if (end - p > 1 && p[0] == '/' && p[1] == '*') {
+      if (end - p > 2 && p[2] == '!') {
+        p += 3;
+        while (p < end && std::isdigit(static_cast<unsigned char>(*p))) ++p;
+      } else {
+        p += 2;
+        while (p < end && !(p[0] == '*' && p + 1 < end && p[1] == '/')) ++p;
+        p = std::min(p + 2, end);
+      }
+    } else if (end - p > 1 && p[0] == '*' && p[1] == '/') {
+      // end of a conditional comment
+      p += 2;
+    } else {
+      break;
+    }
+  }
+  return p;
+}
+
+struct Token {
+  enum class Kind { END, WORD, IDENTIFIER, STRING, SYMBOL };
+
+  Kind kind = Kind::END;
+  // WORD, SYMBOL: text of the token, IDENTIFIER, STRING: unquoted contents
+  std::string text;
+
+  bool is(Kind k) const { return kind == k; }
+
+  bool is_word(const char *word) const {
+    return kind == Kind::WORD && str_caseeq(text, word);
+  }
+
+  bool is_symbol(const char *symbol) const {
+    return kind == Kind::SYMBOL && text == symbol;
+  }
+
+  // user (@var) or system (@@var) variable
+  bool is_variable() const { return kind == Kind::WORD && text[0] == '@'; }
+
+  bool is_name() const {
+    return kind == Kind::IDENTIFIER || (kind == Kind::WORD && text[0] != '@');
+  }
+};
+
+/**
+ * Reads the next token of a statement.
+ *
+ * @param p position in the statement, advanced past the token
+ * @param end end of the statement
+ * @param keep_strings if false, contents of string literals are not copied
+ */
+Token next_token(const char **p, const char *end, bool keep_strings = true) {
+  Token token;
+  const char *s = skip_blanks(*p, end);
+
+  if (s == end) {
+    *p = s;
+    return token;
+  }
+
+  if (*s == '`' || *s == '\'' || *s == '"') {
+    const char quote = *s;
+    token.kind = quote == '`' ? Token::Kind::IDENTIFIER : Token::Kind::STRING;
+    const bool keep = keep_strings || quote == '`';
+
+    for (++s; s < end; ++s) {
+      if (*s == quote) {
+        if (s + 1 < end && s[1] == quote) {
+          ++s;
+        } else {
+          ++s;
+          break;
+        }
+      } else if (*s == '\\' && quote != '`' && s + 1 < end) {
+        ++s;
+      }
+      if (keep) token.text.push_back(*s);
+    }
+  } else if (is_word_char(*s)) {
+    token.kind = Token::Kind::WORD;
+    while (s < end && is_word_char(*s)) token.text.push_back(*s++);
+  } else {
+    token.kind = Token::Kind::SYMBOL;
+    if (*s == ':' && s + 1 < end && s[1] == '=') token.text.push_back(*s++);
+    token.text.push_back(*s++);
+  }
+
+  *p = s;
+  return token;
+}
+
+bool is_session_function(const Token &token) {
+  for (const auto f : k_session_functions) {
+    if (token.is_word(f)) return true;
+  }
+  return false;
+}
+
+/**
+ * Reads a possibly qualified table name, returns the unqualified name.
+ */
+std::string next_table(const char **p, const char *end) {
+  Token token = next_token(p, end);
+  if (!token.is_name()) return "";
+
+  std::string name = token.text;
+  const char *s = *p;
+
+  if (next_token(&s, end).is_symbol(".")) {
+    token = next_token(&s, end);
+    if (!token.is_name()) return "";
+    name = token.text;
+    *p = s;
+  }
+
+  // identifiers differing only in case or schema are treated as the same
+  // table, which sacrifices some parallelism but is always safe
+  return str_lower(name);
+}
+
+/**
+ * Handles the assignments of a SET statement.
+ */
+void classify_set(const char **p, const char *end, detail::Statement *stmt) {
+  Token token = next_token(p, end);
+
+  if (token.is_word("PASSWORD") || token.is_word("ROLE") ||
+      token.is_word("DEFAULT") || token.is_word("RESOURCE"))
+    return;
+
+  // the last scope given applies to the following assignments
+  bool global = false;
+  bool explicit_scope = false;
+
+  while (!token.is(Token::Kind::END)) {
+    if (token.is_word("GLOBAL") || token.is_word("PERSIST") ||
+        token.is_word("PERSIST_ONLY")) {
+      global = true;
+      explicit_scope = true;
+      token = next_token(p, end);
+    } else if (token.is_word("SESSION") || token.is_word("LOCAL")) {
+      global = false;
+      explicit_scope = true;
+      token = next_token(p, end);
+    }
+
+    if (token.is_word("TRANSACTION")) {
+      // without a scope, it only affects the next transaction
+      if (explicit_scope && !global) stmt->session_state = true;
+      return;
+    }
+
+    std::string variable;
+    bool session = !global;
+
+    if (token.is_word("NAMES") || token.is_word("CHARSET")) {
+      variable = token.text;
+    } else if (token.is_word("CHARACTER")) {
+      variable = token.text;
+      next_token(p, end);
+    } else if (token.is_variable() && token.text[1] == '@') {
+      variable = token.text.substr(2);
+      session = true;
+      const char *s = *p;
+      if (next_token(&s, end).is_symbol(".")) {
+        session = str_caseeq(variable, "SESSION") ||
+                  str_caseeq(variable, "LOCAL");
+        variable = next_token(&s, end).text;
+        *p = s;
+      }
+    } else if (token.is_variable()) {
+      // user variables belong to the session
+      session = true;
+      variable = token.text;
+      if (variable.length() == 1) variable += next_token(p, end).text;
+    } else if (token.is_name()) {
+      variable = token.text;
+      const char *s = *p;
+      // component variables
+      if (next_token(&s, end).is_symbol(".")) {
+        variable = next_token(&s, end).text;
+        *p = s;
+      }
+    } else {
+      return;
+    }
+
+    if (session) stmt->session_state = true;
+
+    // the value, up to the next assignment
+    std::vector<Token> value;
+    int depth = 0;
+    bool first = true;
+
+    while (true) {
+      token = next_token(p, end);
+      if (token.is(Token::Kind::END)) break;
+      if (depth == 0 && token.is_symbol(",")) break;
+      if (first && (token.is_symbol("=") || token.is_symbol(":="))) {
+        first = false;
+        continue;
+      }
+      first = false;
+
+      if (token.is_symbol("("))
+        ++depth;
+      else if (token.is_symbol(")"))
+        --depth;
+      else if (session && is_session_function(token))
+        stmt->diverges = true;
+
+      value.push_back(token);
+    }
+
+    if (session && str_caseeq(variable, "AUTOCOMMIT")) {
+      stmt->sets_autocommit = true;
+      stmt->autocommit =
+          value.size() == 1 &&
+          (value[0].text == "1" || str_caseeq(value[0].text, "ON") ||
+           str_caseeq(value[0].text, "TRUE"));
+    }
+
+    if (token.is(Token::Kind::END)) break;
+    token = next_token(p, end);
+  }
+}
+
+/**
+ * Checks the part of an INSERT/REPLACE statement following the VALUES keyword,
+ * returns true if it does not depend on the state of the session.
+ */
+bool is_independent(const char *p, const char *end) {
+  while (true) {
+    const Token token = next_token(&p, end, false);
+
+    if (token.is(Token::Kind::END)) return true;
+
+    if (token.is_variable() || is_session_function(token))
+      return false;
+  }
+}
+
+/**
+ * Checks if a statement which is not SET may assign user variables.
+ */
+bool assigns_variables(const char *p, const char *end) {
+  Token previous;
+
+  while (true) {
+    Token token = next_token(&p, end, false);
+
+    if (token.is(Token::Kind::END)) return false;
+
+    // SELECT ... INTO @var, @var := expr
+    if (previous.is_word("INTO") && token.is_variable())
+      return true;
+
+    if (previous.is_variable() && token.is_symbol(":="))
+      return true;
+
+    previous = std::move(token);
+  }
+}
+
+/**
+ * Returns a factory of sessions using the same protocol as the given one.
+ */
+Sql_parallel_loader::Session_factory same_type_factory(
+    const std::shared_ptr<mysqlshdk::db::ISession> &session) {
+  using mysqlshdk::db::ISession;
+
+  if (std::dynamic_pointer_cast<mysqlshdk::db::mysql::Session>(session)) {
+    return []() -> std::shared_ptr<ISession> {
+      return mysqlshdk::db::mysql::Session::create();
+    };
+  }
+
+  return []() -> std::shared_ptr<ISession> {
+    return mysqlshdk::db::mysqlx::Session::create();
+  };
+}
+
+}  // namespace
+
+namespace detail {
+
+Statement classify(const char *sql, size_t len) {
+  const char *p = sql;
+  const char *end = sql + len;
+  const Token keyword = next_token(&p, end);
+  Statement stmt;
+
+  if (keyword.is_word("INSERT") || keyword.is_word("REPLACE")) {
+    const char *s = p;
+    Token token = next_token(&s, end);
+
+    while (token.is_word("LOW_PRIORITY") || token.is_word("DELAYED") ||
+           token.is_word("HIGH_PRIORITY") || token.is_word("IGNORE") ||
+           token.is_word("INTO")) {
+      p = s;
+      token = next_token(&s, end);
+    }
+
+    const std::string table = next_table(&p, end);
+    if (table.empty()) return stmt;
+
+    // column list
+    s = p;
+    Token next = next_token(&s, end);
+    if (next.is_symbol("(")) {
+      do {
+        next = next_token(&s, end);
+      } while (!next.is(Token::Kind::END) && !next.is_symbol(")"));
+      if (next.is(Token::Kind::END)) return stmt;
+      next = next_token(&s, end);
+    }
+
+    // INSERT ... SELECT and INSERT ... SET may read other tables
+    if (!next.is_word("VALUES") && !next.is_word("VALUE")) return stmt;
+
+    if (is_independent(s, end)) {
+      stmt.type = Statement_type::INSERT;
+      stmt.tables.push_back(table);
+    }
+  } else if (keyword.is_word("USE")) {
+    stmt.type = Statement_type::USE;
+  } else if (keyword.is_word("SET")) {
+    stmt.type = Statement_type::SET;
+    classify_set(&p, end, &stmt);
+  } else if (keyword.is_word("LOCK") || keyword.is_word("BEGIN")) {
+    stmt.type = Statement_type::SERIAL_BEGIN;
+  } else if (keyword.is_word("UNLOCK") || keyword.is_word("COMMIT")) {
+    stmt.type = Statement_type::SERIAL_END;
+  } else if (keyword.is_word("START")) {
+    if (next_token(&p, end).is_word("TRANSACTION"))
+      stmt.type = Statement_type::SERIAL_BEGIN;
+  } else if (keyword.is_word("ROLLBACK")) {
+    // ROLLBACK TO SAVEPOINT keeps the transaction open
+    if (!next_token(&p, end).is_word("TO"))
+      stmt.type = Statement_type::SERIAL_END;
+  } else if (keyword.is_word("XA")) {
+    const Token action = next_token(&p, end);
+    if (action.is_word("START") || action.is_word("BEGIN"))
+      stmt.type = Statement_type::SERIAL_BEGIN;
+    else if (action.is_word("COMMIT") || action.is_word("ROLLBACK"))
+      stmt.type = Statement_type::SERIAL_END;
+  } else if (keyword.is_word("CREATE")) {
+    if (next_token(&p, end).is_word("TEMPORARY") &&
+        next_token(&p, end).is_word("TABLE")) {
+      const char *s = p;
+      if (next_token(&s, end).is_word("IF")) {
+        next_token(&s, end);  // NOT
+        next_token(&s, end);  // EXISTS
+        p = s;
+      }
+
+      const std::string table = next_table(&p, end);
+      if (!table.empty()) {
+        stmt.type = Statement_type::CREATE_TEMPORARY_TABLE;
+        stmt.tables.push_back(table);
+      }
+    }
+  } else if (keyword.is_word("DROP")) {
+    Token token = next_token(&p, end);
+    if (token.is_word("TEMPORARY")) token = next_token(&p, end);
+
+    if (token.is_word("TABLE") || token.is_word("TABLES")) {
+      stmt.type = Statement_type::DROP_TABLE;
+
+      const char *s = p;
+      if (next_token(&s, end).is_word("IF")) {
+        next_token(&s, end);  // EXISTS
+        p = s;
+      }
+
+      do {
+        const std::string table = next_table(&p, end);
+        if (!table.empty()) stmt.tables.push_back(table);
+      } while (next_token(&p, end).is_symbol(","));
+    }
+  } else if (keyword.is_word("CALL") || keyword.is_word("EXECUTE")) {
+    // procedures and prepared statements may change anything
+    stmt.diverges = true;
+  }
+
+  if (stmt.type != Statement_type::SET && stmt.type != Statement_type::INSERT &&
+      !stmt.diverges)
+    stmt.diverges = assigns_variables(sql, end);
+
+  return stmt;
+}
+
+}  // namespace detail
+
+Sql_parallel_loader::Sql_parallel_loader(
+    std::shared_ptr<mysqlshdk::db::ISession> session, size_t threads,
+    bool stop_on_error, const Error_handler &on_error)
+    : Sql_parallel_loader(session, threads, stop_on_error, on_error,
+                          same_type_factory(session)) {}
+
+Sql_parallel_loader::Sql_parallel_loader(
+    std::shared_ptr<mysqlshdk::db::ISession> session, size_t threads,
+    bool stop_on_error, const Error_handler &on_error,
+    const Session_factory &create_session)
+    : m_session(session),
+      m_stop_on_error(stop_on_error),
+      m_on_error(on_error),
+      m_create_session(create_session),
+      m_failed(false),
+      m_stop(false),
+      m_interrupted(false) {
+  sync_schema();
+  sync_foreign_key_checks();
+
+  for (size_t i = 0; i < threads; ++i) {
+    std::unique_ptr<Worker> worker(new Worker());
+
+    worker->session = m_create_session();
+    worker->session->connect(session->get_connection_options());
+    worker->connection_id = worker->session->get_connection_id();
+    m_workers.emplace_back(std::move(worker));
+  }
+
+  for (const auto &w : m_workers) {
+    Worker *worker = w.get();
+    worker->thread = std::thread([this, worker]() {
+      mysqlsh::thread_init();
+      run(worker);
+      mysqlsh::thread_end();
+    });
+  }
+}
+
+Sql_parallel_loader::~Sql_parallel_loader() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_finish = true;
+
+    for (const auto &worker : m_workers) worker->work_ready.notify_one();
+  }
+
+  for (const auto &worker : m_workers) {
+    if (worker->thread.joinable()) worker->thread.join();
+  }
+}
+
+bool Sql_parallel_loader::accepts(const char *sql, size_t len) {
+  if (m_serial || m_disabled || m_diverged || m_foreign_key_checks)
+    return false;
+
+  const auto stmt = detail::classify(sql, len);
+
+  // temporary tables exist only in the main session
+  return stmt.type == detail::Statement_type::INSERT &&
+         m_temporary_tables.find(stmt.tables[0]) == m_temporary_tables.end() &&
+         !has_dependencies(stmt.tables[0]);
+}
+
+void Sql_parallel_loader::execute(const char *sql, size_t len,
+                                  size_t line_num) {
+  const std::string table = detail::classify(sql, len).tables[0];
+
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Worker *&worker = m_tables[table];
+
+    // tables not seen since the last barrier go to the least loaded worker
+    if (!worker) {
+      worker = std::min_element(m_workers.begin(), m_workers.end(),
+                                [](const std::unique_ptr<Worker> &a,
+                                   const std::unique_ptr<Worker> &b) {
+                                  return a->queued_bytes < b->queued_bytes;
+                                })
+                   ->get();
+    }
+
+    // don't read the script too far ahead of the workers
+    m_task_done.wait(lock, [this, worker]() {
+      return m_stop || worker->queued_bytes < k_max_queued_bytes;
+    });
+
+    if (!m_stop) {
+      worker->queue.push_back(
+          {std::string(sql, len), line_num, m_session_state.size()});
+      worker->queued_bytes += len;
+      worker->work_ready.notify_one();
+    }
+  }
+
+  report_errors();
+}
+
+bool Sql_parallel_loader::wait() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_task_done.wait(lock, [this]() {
+      for (const auto &worker : m_workers) {
+        if (worker->busy || !worker->queue.empty()) return false;
+      }
+      return true;
+    });
+  }
+
+  m_tables.clear();
+  report_errors();
+
+  return ok();
+}
+
+void Sql_parallel_loader::executed(const char *sql, size_t len,
+                                   const std::string &delimiter) {
+  // the session state must not change while the workers are replaying it
+  wait();
+
+  // foreign keys and triggers may have been created or dropped
+  m_dependencies.clear();
+
+  // shell commands may change the default schema
+  if (delimiter.empty()) {
+    sync_schema();
+    return;
+  }
+
+  const auto stmt = detail::classify(sql, len);
+
+  if (stmt.diverges) m_diverged = true;
+
+  switch (stmt.type) {
+    case detail::Statement_type::USE:
+      sync_schema();
+      break;
+
+    case detail::Statement_type::SET:
+      if (stmt.session_state && !stmt.diverges)
+        m_session_state.emplace_back(sql, len);
+      if (stmt.sets_autocommit) m_disabled = !stmt.autocommit;
+      if (stmt.session_state) sync_foreign_key_checks();
+      break;
+
+    case detail::Statement_type::SERIAL_BEGIN:
+      m_serial = true;
+      break;
+
+    case detail::Statement_type::SERIAL_END:
+      m_serial = false;
+      break;
+
+    case detail::Statement_type::CREATE_TEMPORARY_TABLE:
+      m_temporary_tables.insert(stmt.tables.begin(), stmt.tables.end());
+      break;
+
+    case detail::Statement_type::DROP_TABLE:
+      for (const auto &table : stmt.tables) m_temporary_tables.erase(table);
+      break;
+
+    case detail::Statement_type::INSERT:
+    case detail::Statement_type::OTHER:
+      break;
+  }
+}
+
+void Sql_parallel_loader::interrupt() {
+  // the mutex is not used here, as it may be held by the interrupted thread
+  m_interrupted = true;
+  m_failed = true;
+  m_stop = true;
+
+  try {
+    const auto session = m_create_session();
+    session->connect(m_session->get_connection_options());
+
+    for (const auto &worker : m_workers) {
+      if (worker->busy)
+        session->executef("KILL QUERY ?", worker->connection_id);
+    }
+
+    session->close();
+  } catch (const std::exception &e) {
+    log_warning("Error aborting the queued statements: %s", e.what());
+  }
+}
+
+void Sql_parallel_loader::run(Worker *worker) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true) {
+    worker->work_ready.wait(
+        lock, [this, worker]() { return m_finish || !worker->queue.empty(); });
+
+    if (worker->queue.empty()) break;
+
+    Task task = std::move(worker->queue.front());
+    worker->queue.pop_front();
+    worker->busy = true;
+    lock.unlock();
+
+    if (!m_stop) {
+      try {
+        while (worker->session_state < task.session_state)
+          worker->session->execute(m_session_state[worker->session_state++]);
+
+        worker->session->executes(task.sql.data(), task.sql.size());
+      } catch (const mysqlshdk::db::Error &e) {
+        auto exc = shcore::Exception::mysql_error_with_code_and_state(
+            e.what(), e.code(), e.sqlstate());
+        if (task.line_num > 0) exc.set_file_context("", task.line_num);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_errors.emplace_back(task.line_num, exc);
+        m_failed = true;
+        if (m_stop_on_error) m_stop = true;
+      } catch (const std::exception &e) {
+        auto exc = shcore::Exception::runtime_error(e.what());
+        if (task.line_num > 0) exc.set_file_context("", task.line_num);
+
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_errors.emplace_back(task.line_num, exc);
+        m_failed = true;
+        if (m_stop_on_error) m_stop = true;
+      }
+    }
+
+    lock.lock();
+    worker->queued_bytes -= task.sql.size();
+    worker->busy = false;
+    m_task_done.notify_all();
+  }
+
+  lock.unlock();
+  worker->session->close();
+}
+
+bool Sql_parallel_loader::report_errors() {
+  std::vector<std::pair<size_t, shcore::Exception>> errors;
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::swap(errors, m_errors);
+  }
+
+  // errors are reported in the order of the script
+  std::stable_sort(errors.begin(), errors.end(),
+                   [](const std::pair<size_t, shcore::Exception> &a,
+                      const std::pair<size_t, shcore::Exception> &b) {
+                     return a.first < b.first;
+                   });
+
+  for (const auto &error : errors) m_on_error(error.second);
+
+  if (m_interrupted.exchange(false)) {
+    m_on_error(shcore::Exception::runtime_error(
+        "Execution of the queued statements was interrupted"));
+    return false;
+  }
+
+  return errors.empty();
+}
+
+void Sql_parallel_loader::sync_schema() {
+  auto result = m_session->query("SELECT DATABASE()");
+  auto row = result->fetch_one();
+  const std::string schema =
+      row && !row->is_null(0) ? row->get_string(0) : std::string();
+
+  if (schema != m_schema) {
+    m_schema = schema;
+
+    if (!schema.empty())
+      m_session_state.emplace_back("USE " + quote_identifier(schema));
+  }
+}
+
+void Sql_parallel_loader::sync_foreign_key_checks() {
+  auto result = m_session->query("SELECT @@SESSION.foreign_key_checks");
+  auto row = result->fetch_one();
+  m_foreign_key_checks = !row || row->is_null(0) || row->get_int(0) != 0;
+}
+
+bool Sql_parallel_loader::has_dependencies(const std::string &table) {
+  auto it = m_dependencies.find(table);
+
+  if (it == m_dependencies.end()) {
+    // table names are not qualified, so tables with this name in any schema
+    // are checked, which is always safe
+    auto result = m_session->queryf(
+        "SELECT (SELECT COUNT(*) FROM "
+        "information_schema.referential_constraints WHERE "
+        "LOWER(table_name) = ? OR LOWER(referenced_table_name) = ?) + "
+        "(SELECT COUNT(*) FROM information_schema.triggers WHERE "
+        "LOWER(event_object_table) = ?)",
+        table, table, table);
+    auto row = result->fetch_one();
+    it = m_dependencies
+             .emplace(table, !row || row->is_null(0) || row->get_int(0) > 0)
+             .first;
+  }
+
+  return it->second;
+}
+
+}  // namespace shcore
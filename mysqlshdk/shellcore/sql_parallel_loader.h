@@ -0,0 +1,256 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#ifndef MYSQLSHDK_SHELLCORE_SQL_PARALLEL_LOADER_H_
+#define MYSQLSHDK_SHELLCORE_SQL_PARALLEL_LOADER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/db/session.h"
+#include "scripting/types.h"
+
+namespace shcore {
+
+namespace detail {
+
+enum class Statement_type {
+  INSERT,
+  USE,
+  SET,
+  SERIAL_BEGIN,
+  SERIAL_END,
+  CREATE_TEMPORARY_TABLE,
+  DROP_TABLE,
+  OTHER
+};
+
+/**
+ * Describes how a statement affects the execution of the following ones.
+ */
+struct Statement {
+  Statement_type type = Statement_type::OTHER;
+  // INSERT: the target table, CREATE TEMPORARY TABLE and DROP TABLE: the
+  // affected tables, names are unqualified and in lower case
+  std::vector<std::string> tables;
+  // SET: at least one of the assigned variables belongs to the session
+  bool session_state = false;
+  // SET: autocommit is assigned, values which are not literals are reported
+  // as OFF
+  bool sets_autocommit = false;
+  bool autocommit = false;
+  // the statement may change the state of the session in a way which cannot
+  // be replayed on another session (i.e. SELECT ... INTO @var, CALL)
+  bool diverges = false;
+};
+
+/**
+ * Classifies a statement, INSERT/REPLACE statements are reported as INSERT
+ * only if they use the VALUES clause and do not refer to the state of the
+ * session (variables, LAST_INSERT_ID() and similar functions, subqueries).
+ */
+Statement classify(const char *sql, size_t len);
+
+}  // namespace detail
+
+/**
+ * Executes the statements of an SQL script using a pool of sessions.
+ *
+ * Statements inserting data into a table (INSERT/REPLACE ... VALUES) are
+ * queued to the session which handles that table, so rows of the same table
+ * are still inserted in the order they appear in the script, while rows of
+ * different tables are inserted in parallel.
+ *
+ * Any other statement acts as a barrier: the caller has to wait() until all
+ * the queued statements are executed, execute the statement on the main
+ * session and then report it through executed(). Statements which change the
+ * session state (SET, USE) are replayed on the sessions of the pool, while
+ * explicit transactions, table locks and disabled autocommit make all the
+ * statements run on the main session until they are finished. Inserts into
+ * temporary tables created by the main session are executed there as well.
+ * Once a statement changes the session state in a way which cannot be
+ * replayed, the pool is no longer used.
+ *
+ * Rows of different tables may depend on each other, so the pool is not used
+ * while foreign_key_checks is enabled, and inserts into tables which have
+ * foreign keys (referencing them or other tables) or triggers are executed on
+ * the main session.
+ *
+ * All the methods have to be called from the same thread.
+ */
+class Sql_parallel_loader final {
+ public:
+  using Error_handler = std::function<void(const shcore::Exception &)>;
+  using Session_factory =
+      std::function<std::shared_ptr<mysqlshdk::db::ISession>()>;
+
+  /**
+   * Opens the sessions of the pool, using the same connection options as the
+   * given session.
+   *
+   * @param session main session, used to execute barriers
+   * @param threads number of sessions used to execute the queued statements
+   * @param stop_on_error if true, queued statements are discarded once an
+   *        error occurs
+   * @param on_error called from the thread using the loader to report the
+   *        errors of the queued statements
+   */
+  Sql_parallel_loader(std::shared_ptr<mysqlshdk::db::ISession> session,
+                      size_t threads, bool stop_on_error,
+                      const Error_handler &on_error);
+
+  /**
+   * Opens the sessions of the pool using the given factory, sessions are
+   * connected using the same connection options as the main session.
+   */
+  Sql_parallel_loader(std::shared_ptr<mysqlshdk::db::ISession> session,
+                      size_t threads, bool stop_on_error,
+                      const Error_handler &on_error,
+                      const Session_factory &create_session);
+
+  Sql_parallel_loader(const Sql_parallel_loader &) = delete;
+  Sql_parallel_loader(Sql_parallel_loader &&) = delete;
+  Sql_parallel_loader &operator=(const Sql_parallel_loader &) = delete;
+  Sql_parallel_loader &operator=(Sql_parallel_loader &&) = delete;
+
+  /**
+   * Discards the statements which were not executed yet and closes the pool.
+   */
+  ~Sql_parallel_loader();
+
+  /**
+   * @returns true if the statement can be executed by the pool, otherwise
+   *          caller has to wait() and execute it on the main session.
+   */
+  bool accepts(const char *sql, size_t len);
+
+  /**
+   * Queues a statement which is accepted by the pool for execution.
+   */
+  void execute(const char *sql, size_t len, size_t line_num);
+
+  /**
+   * Waits until all the queued statements are executed.
+   *
+   * @returns false if any of the statements failed.
+   */
+  bool wait();
+
+  /**
+   * Informs the loader that a statement was executed on the main session.
+   *
+   * @param sql the statement
+   * @param len length of the statement
+   * @param delimiter delimiter of the statement, empty for shell commands
+   */
+  void executed(const char *sql, size_t len, const std::string &delimiter);
+
+  /**
+   * @returns true if none of the queued statements failed so far.
+   */
+  bool ok() const { return !m_failed; }
+
+  /**
+   * Kills the statements being executed by the pool and discards the queued
+   * ones. Meant to be called from an interrupt handler.
+   */
+  void interrupt();
+
+ private:
+  struct Task {
+    std::string sql;
+    size_t line_num;
+    size_t session_state;
+  };
+
+  struct Worker {
+    std::shared_ptr<mysqlshdk::db::ISession> session;
+    std::deque<Task> queue;
+    size_t queued_bytes = 0;
+    std::atomic<bool> busy{false};
+    uint64_t connection_id = 0;
+    size_t session_state = 0;
+    std::condition_variable work_ready;
+    std::thread thread;
+  };
+
+  void run(Worker *worker);
+
+  bool report_errors();
+
+  void sync_schema();
+
+  void sync_foreign_key_checks();
+
+  bool has_dependencies(const std::string &table);
+
+  std::shared_ptr<mysqlshdk::db::ISession> m_session;
+  bool m_stop_on_error;
+  Error_handler m_on_error;
+  Session_factory m_create_session;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+
+  // table -> worker, reset on every barrier
+  std::map<std::string, Worker *> m_tables;
+
+  // statements changing the session state, which are replayed by the workers
+  // before executing the statements queued after them
+  std::vector<std::string> m_session_state;
+  std::string m_schema;
+
+  // a transaction or table locks are active on the main session
+  bool m_serial = false;
+  // autocommit was disabled, all statements are executed on the main session
+  bool m_disabled = false;
+  // session state cannot be replayed, all statements are executed on the main
+  // session
+  bool m_diverged = false;
+  // temporary tables created by the main session
+  std::set<std::string> m_temporary_tables;
+  // foreign_key_checks is enabled on the main session
+  bool m_foreign_key_checks = true;
+  // table -> whether it has foreign keys or triggers, reset on every barrier
+  std::map<std::string, bool> m_dependencies;
+
+  std::mutex m_mutex;
+  std::condition_variable m_task_done;
+  std::vector<std::pair<size_t, shcore::Exception>> m_errors;
+  std::atomic<bool> m_failed;
+  std::atomic<bool> m_stop;
+  std::atomic<bool> m_interrupted;
+  bool m_finish = false;
+};
+
+}  // namespace shcore
+
+#endif  // MYSQLSHDK_SHELLCORE_SQL_PARALLEL_LOADER_H_
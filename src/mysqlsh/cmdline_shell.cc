@@ -24,9 +24,11 @@
 #include "mysqlsh/cmdline_shell.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdio>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <utility>
 #include <vector>
@@ -64,6 +66,12 @@ namespace mysqlsh {
 
 namespace {
 
+// size of the buffer used when stdout is not a terminal
+constexpr size_t k_output_buffer_size = 64 * 1024;
+
+// buffered output is written out at least this often
+constexpr std::chrono::milliseconds k_output_flush_interval{100};
+
 Command_line_shell *g_instance = nullptr;
 
 void auto_complete(const char *text, int *start_index,
@@ -110,9 +118,9 @@ static int utf8_bytes_length(unsigned char c) {
   return lengths[c];
 }
 
-void write_to_console(int fd, const char *text) {
+void write_to_console(int fd, const char *text, size_t length) {
   const char *p = text;
-  size_t bytes_left = strlen(text);
+  size_t bytes_left = length;
   while (bytes_left > 0) {
     int flush_bytes = BUFSIZ < bytes_left ? BUFSIZ : bytes_left;
     const char *flush_end = p + flush_bytes;
@@ -120,13 +128,15 @@ void write_to_console(int fd, const char *text) {
     // Windows Console requires all bytes of utf-8 encoded character printed at
     // once, therefore we don't cut utf-8 multi-byte character in the middle.
     // To be safe we use this behaviour on all platforms.
-    while (utf8_bytes_length(static_cast<unsigned char>(*flush_end)) == 0 &&
-           (p != flush_end)) {
-      --flush_end;
-    }
+    if (static_cast<size_t>(flush_bytes) < bytes_left) {
+      while (utf8_bytes_length(static_cast<unsigned char>(*flush_end)) == 0 &&
+             (p != flush_end)) {
+        --flush_end;
+      }
 
-    if (p != flush_end) {
-      flush_bytes = std::distance(p, flush_end);
+      if (p != flush_end) {
+        flush_bytes = std::distance(p, flush_end);
+      }
     }
 
     const int written = write(fd, p, flush_bytes);
@@ -165,6 +175,10 @@ void write_to_console(int fd, const char *text) {
     p += bytes_written;
   }
 }
+
+void write_to_console(int fd, const char *text) {
+  write_to_console(fd, text, strlen(text));
+}
 }  // namespace
 
 REGISTER_HELP(CMD_HISTORY_BRIEF, "View and edit command line history.");
@@ -247,9 +261,19 @@ Command_line_shell::Command_line_shell(
     std::unique_ptr<shcore::Interpreter_delegate> delegate)
     : mysqlsh::Mysql_shell(cmdline_options, delegate.get()),
       _delegate(std::move(delegate)),
+      m_output_flush_interval(k_output_flush_interval),
       m_default_pager(options().pager) {
   _output_printed = false;
 
+  // terminal output is written right away, otherwise it's buffered, so that
+  // the output is not written piece by piece
+  if (!isatty(fileno(stdout))) {
+    m_output_buffer.reset(new char[k_output_buffer_size]);
+    m_last_flush = std::chrono::steady_clock::now();
+    m_output_flusher =
+        std::thread(&Command_line_shell::flush_output_periodically, this);
+  }
+
   g_instance = this;
 
   observe_notification("SN_STATEMENT_EXECUTED");
@@ -311,9 +335,21 @@ Command_line_shell::Command_line_shell(std::shared_ptr<Shell_options> options)
                                  &Command_line_shell::deleg_prompt,
                                  &Command_line_shell::deleg_password,
                                  &Command_line_shell::deleg_print_error,
-                                 &Command_line_shell::deleg_print_diag})) {}
+                                 &Command_line_shell::deleg_print_diag,
+                                 &Command_line_shell::deleg_flush})) {}
 
 Command_line_shell::~Command_line_shell() {
+  if (m_output_flusher.joinable()) {
+    {
+      std::lock_guard<std::mutex> lock(m_output_mutex);
+      m_stop_output_flusher = true;
+    }
+    m_output_pending.notify_one();
+    m_output_flusher.join();
+  }
+
+  flush_output();
+
   // global pager needs to be destroyed as it uses the delegate
   current_console()->disable_global_pager();
 }
@@ -489,7 +525,7 @@ void Command_line_shell::deleg_disable_print(void *cdata, const char *text) {
 void Command_line_shell::deleg_print(void *cdata, const char *text) {
   Command_line_shell *self = reinterpret_cast<Command_line_shell *>(cdata);
   if (text && *text) {
-    write_to_console(fileno(stdout), text);
+    self->print_to_stdout(text);
     self->_output_printed = true;
   }
 }
@@ -497,7 +533,8 @@ void Command_line_shell::deleg_print(void *cdata, const char *text) {
 void Command_line_shell::deleg_print_error(void *cdata, const char *text) {
   Command_line_shell *self = reinterpret_cast<Command_line_shell *>(cdata);
   if (text && *text) {
-    write_to_console(fileno(stdout), text);
+    self->print_to_stdout(text);
+    self->flush_output();
     self->_output_printed = true;
   }
 }
@@ -505,11 +542,86 @@ void Command_line_shell::deleg_print_error(void *cdata, const char *text) {
 void Command_line_shell::deleg_print_diag(void *cdata, const char *text) {
   Command_line_shell *self = reinterpret_cast<Command_line_shell *>(cdata);
   if (text && *text) {
+    self->flush_output();
     write_to_console(fileno(stderr), text);
     self->_output_printed = true;
   }
 }
 
+void Command_line_shell::deleg_flush(void *cdata) {
+  reinterpret_cast<Command_line_shell *>(cdata)->flush_output();
+}
+
+void Command_line_shell::print_to_stdout(const char *text) {
+  if (!m_output_buffer) {
+    write_to_console(fileno(stdout), text);
+    return;
+  }
+
+  const size_t length = strlen(text);
+  std::lock_guard<std::mutex> lock(m_output_mutex);
+  const bool was_empty = m_output_size == 0;
+
+  if (m_output_size + length > k_output_buffer_size) write_output();
+
+  if (length >= k_output_buffer_size) {
+    write_to_console(fileno(stdout), text, length);
+  } else {
+    memcpy(m_output_buffer.get() + m_output_size, text, length);
+    m_output_size += length;
+  }
+
+  const auto now = std::chrono::steady_clock::now();
+
+  if (now - m_last_flush >= m_output_flush_interval)
+    write_output();
+  else if (was_empty && m_output_size > 0)
+    m_output_pending.notify_one();
+}
+
+void Command_line_shell::flush_output() {
+  if (!m_output_buffer) return;
+
+  std::lock_guard<std::mutex> lock(m_output_mutex);
+  write_output();
+}
+
+void Command_line_shell::write_output() {
+  m_last_flush = std::chrono::steady_clock::now();
+
+  const size_t size = m_output_size;
+  m_output_size = 0;
+
+  if (size > 0) write_to_console(fileno(stdout), m_output_buffer.get(), size);
+}
+
+void Command_line_shell::flush_output_periodically() {
+  // the output printed before a long running operation (i.e. a query) is
+  // written out without waiting for the next print
+  std::unique_lock<std::mutex> lock(m_output_mutex);
+
+  while (!m_stop_output_flusher) {
+    if (m_output_size == 0) {
+      m_output_pending.wait(lock);
+    } else if (std::chrono::steady_clock::now() - m_last_flush >=
+               m_output_flush_interval) {
+      write_output();
+    } else {
+      m_output_pending.wait_until(lock,
+                                  m_last_flush + m_output_flush_interval);
+    }
+  }
+}
+
+void Command_line_shell::set_output_flush_interval(
+    std::chrono::milliseconds interval) {
+  {
+    std::lock_guard<std::mutex> lock(m_output_mutex);
+    m_output_flush_interval = interval;
+  }
+  m_output_pending.notify_one();
+}
+
 std::string Command_line_shell::query_variable(
     const std::string &var,
     mysqlsh::Prompt_manager::Dynamic_variable_type type) {
@@ -600,6 +712,7 @@ shcore::Prompt_result Command_line_shell::deleg_prompt(void *cdata,
                                                        const char *prompt,
                                                        std::string *ret) {
   Command_line_shell *self = reinterpret_cast<Command_line_shell *>(cdata);
+  self->flush_output();
   self->_interrupted = false;
   char *tmp = Command_line_shell::readline(prompt);
   if (tmp && strcmp(tmp, CTRL_C_STR) == 0) self->_interrupted = true;
@@ -620,6 +733,7 @@ shcore::Prompt_result Command_line_shell::deleg_password(void *cdata,
                                                          const char *prompt,
                                                          std::string *ret) {
   Command_line_shell *self = reinterpret_cast<Command_line_shell *>(cdata);
+  self->flush_output();
   self->_interrupted = false;
   shcore::Interrupt_handler inth([self]() {
     self->handle_interrupt();
@@ -706,7 +820,9 @@ void Command_line_shell::command_loop() {
               "\n", mysqlsh::Output_stream::STDOUT, false);
           _output_printed = false;
         }
-        char *tmp = Command_line_shell::readline(prompt().c_str());
+        const auto prompt_text = prompt();
+        flush_output();
+        char *tmp = Command_line_shell::readline(prompt_text.c_str());
         if (tmp && strcmp(tmp, CTRL_C_STR) != 0) {
           cmd = tmp;
           free(tmp);
@@ -726,6 +842,7 @@ void Command_line_shell::command_loop() {
         if (options().full_interactive)
           mysqlsh::current_console()->raw_print(
               prompt(), mysqlsh::Output_stream::STDOUT, false);
+        flush_output();
         if (!std::getline(std::cin, cmd)) {
           if (_interrupted || !std::cin.eof()) {
             _interrupted = false;
@@ -743,6 +860,7 @@ void Command_line_shell::command_loop() {
     detect_session_change();
   }
 
+  flush_output();
   std::cout << "Bye!\n";
 }
 
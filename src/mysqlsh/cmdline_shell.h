@@ -24,8 +24,12 @@
 #ifndef _CMDLINE_SHELL_
 #define _CMDLINE_SHELL_
 
+#include <chrono>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "shellcore/base_shell.h"
@@ -65,6 +69,14 @@ class Command_line_shell : public Mysql_shell,
   void quiet_print();
   void restore_print();
 
+  /**
+   * Writes out the output which is buffered when stdout is not a terminal.
+   *
+   * This is also called when printing errors and before the user is prompted,
+   * and by a background thread once the flush interval expires.
+   */
+  void flush_output();
+
  private:
   void handle_interrupt();
   bool _interrupted = false;
@@ -94,6 +106,7 @@ class Command_line_shell : public Mysql_shell,
   static void deleg_disable_print(void *self, const char *text);
   static void deleg_print_error(void *self, const char *text);
   static void deleg_print_diag(void *self, const char *text);
+  static void deleg_flush(void *self);
   static shcore::Prompt_result deleg_prompt(void *self, const char *text,
                                             std::string *ret);
   static shcore::Prompt_result deleg_password(void *self, const char *text,
@@ -105,12 +118,26 @@ class Command_line_shell : public Mysql_shell,
   std::string get_current_session_uri() const;
   void detect_session_change();
 
+  void print_to_stdout(const char *text);
+  void write_output();
+  void flush_output_periodically();
+  void set_output_flush_interval(std::chrono::milliseconds interval);
+
   std::unique_ptr<shcore::Interpreter_delegate> _delegate;
 
   shcore::Interpreter_delegate _backup_delegate;
   std::stringstream _full_output;
   Prompt_manager _prompt;
   bool _output_printed;
+  std::unique_ptr<char[]> m_output_buffer;
+  size_t m_output_size = 0;
+  std::chrono::steady_clock::time_point m_last_flush;
+  std::chrono::milliseconds m_output_flush_interval;
+  // guards the output buffer, which is also flushed by m_output_flusher
+  std::mutex m_output_mutex;
+  std::condition_variable m_output_pending;
+  bool m_stop_output_flusher = false;
+  std::thread m_output_flusher;
   const std::string m_default_pager;
   std::string m_current_session_uri;
 
@@ -118,6 +145,7 @@ class Command_line_shell : public Mysql_shell,
   FRIEND_TEST(Cmdline_shell, query_variable_classic);
   FRIEND_TEST(Cmdline_shell, query_variable_x);
   FRIEND_TEST(Cmdline_shell, help);
+  FRIEND_TEST(Cmdline_shell, buffered_output);
   FRIEND_TEST(Cmdline_shell, prompt);
   FRIEND_TEST(Shell_history, check_password_history_linenoise);
   FRIEND_TEST(Shell_history, history_linenoise);
@@ -28,6 +28,8 @@
 #include "mysqlshdk/libs/innodbcluster/cluster.h"
 #include "mysqlshdk/libs/textui/textui.h"
 #include "mysqlshdk/libs/utils/document_parser.h"
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/profiling.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/libs/utils/utils_path.h"
@@ -129,9 +131,29 @@ static void handle_ctrlc_signal(int sig) {
   errno = errno_save;
 }
 
+/**
+Handler of the signals which terminate the process because of a crash.
+
+@description
+Writes out the queued log entries, then lets the default action of the signal
+terminate the process. Only async-signal-safe functions are called.
+
+@param [IN]               Signal number
+*/
+
+static void handle_fatal_signal(int sig) {
+  ngcommon::Logger::flush_on_crash();
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
 static void install_signal_handler() {
   // install signal handler
   signal(SIGINT, handle_ctrlc_signal);
+  // write out the log before crashing
+  for (const auto sig : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT}) {
+    signal(sig, handle_fatal_signal);
+  }
   // allow system calls to be interrupted
   siginterrupt(SIGINT, 1);
   // Ignore broken pipe signal
@@ -579,6 +601,9 @@ static std::shared_ptr<mysqlsh::Shell_options> process_args(int *argc,
 
   detect_interactive(shell_options.get(), &stdin_is_tty, &stdout_is_tty);
 
+  // started before the shell is created, to include the initial connection
+  if (options.profile) mysqlshdk::utils::Profiler::start();
+
   // If not a tty, then autocompletion can't be used, so we disable
   // name cache for autocompletion... but keep it for db object from DevAPI
   if (!options.db_name_cache_set &&
@@ -845,15 +870,24 @@ int main(int argc, char **argv) {
 #ifdef _WIN32
       ret_val = 130;
 #else
+      if (shell) shell->flush_output();
+      ngcommon::Logger::flush();
       signal(SIGINT, SIG_DFL);
       kill(getpid(), SIGINT);
 #endif
     }
+
+    // scripts executed in batch mode are not able to print the stages after
+    // they are finished
+    if (options.profile && !options.interactive) {
+      std::cerr << mysqlshdk::utils::Profiler::stage_tree();
+    }
   } catch (const std::exception &e) {
     std::cerr << e.what() << std::endl;
     ret_val = 1;
   }
 
 end:
+  ngcommon::Logger::flush();
   return ret_val;
 }
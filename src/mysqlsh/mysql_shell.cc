@@ -1177,8 +1177,9 @@ void Mysql_shell::refresh_completion(bool force) {
     if (session && _provider_sql && !current_schema.empty()) {
       // Only refresh the full DB name cache if we're in SQL mode
       if (_shell->interactive_mode() == shcore::IShell_core::Mode::SQL) {
+        // names are fetched in the background, the prompt is not blocked
         println("Fetching table and column names from `" + current_schema +
-                "` for auto-completion... Press ^C to stop.");
+                "` for auto-completion...");
         try {
           _provider_sql->refresh_name_cache(session, current_schema,
                                             nullptr,  // &table_names,
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+// Microbenchmarks of the core data paths of the shell, which run without
+// a server: SQL splitting, JSON parsing, shcore::Value conversions, URI
+// parsing, SQL string escaping, copies of rows and formatting of results.
+//
+// Usage: mysqlsh_benchmarks [--list] [--filter=<text>] [--repetitions=<n>]
+//                           [--min-time=<ms>] [--output=<file>]
+//                           [--compare=<file>] [--sql-script=<file>]
+//                           [--json-file=<file>]
+//
+// Each benchmark is sampled several times, the best time of an operation is
+// used to compute the throughput. Results can be written as JSON with
+// --output and compared with the results of another build with --compare.
+
+#include "unittest/benchmarks/benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/logger.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_json.h"
+#include "scripting/types.h"
+#include "shellcore/interrupt_handler.h"
+
+namespace mysqlsh {
+namespace benchmarks {
+
+namespace {
+
+volatile uint64_t g_sink = 0;
+
+struct Run_options {
+  bool list = false;
+  std::string filter;
+  int repetitions = 5;
+  int min_time_ms = 200;
+  std::string output;
+  std::string compare;
+};
+
+struct Result {
+  std::string name;
+  uint64_t runs = 0;
+  uint64_t bytes = 0;
+  uint64_t items = 0;
+  // nanoseconds per run, sorted
+  std::vector<double> samples;
+
+  double best() const { return samples.front(); }
+  double median() const { return samples[samples.size() / 2]; }
+  double worst() const { return samples.back(); }
+
+  double mb_per_second() const {
+    return bytes / (best() / 1e9) / (1024 * 1024);
+  }
+
+  double items_per_second() const { return items / (best() / 1e9); }
+};
+
+void usage() {
+  printf(
+      "Usage: mysqlsh_benchmarks [options]\n"
+      "  --list               Lists the benchmarks.\n"
+      "  --filter=<text>      Runs the benchmarks whose names contain the "
+      "text.\n"
+      "  --repetitions=<n>    Number of samples of each benchmark, 5 by "
+      "default.\n"
+      "  --min-time=<ms>      Minimum duration of a sample, 200 by default.\n"
+      "  --output=<file>      Writes the results to the file, as JSON.\n"
+      "  --compare=<file>     Compares the results with the ones written by\n"
+      "                       another run.\n"
+      "  --sql-script=<file>  SQL script used by the SQL splitter "
+      "benchmarks.\n"
+      "  --json-file=<file>   JSON documents used by the JSON parser "
+      "benchmarks.\n");
+}
+
+bool parse_option(const char *arg, const char *name, std::string *value) {
+  const size_t length = strlen(name);
+
+  if (strncmp(arg, name, length) == 0 && arg[length] == '=') {
+    *value = arg + length + 1;
+    return true;
+  }
+
+  return false;
+}
+
+bool parse_args(int argc, char **argv, Run_options *run_options,
+                Options *options) {
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    std::string value;
+
+    if (strcmp(arg, "--list") == 0) {
+      run_options->list = true;
+    } else if (parse_option(arg, "--filter", &value)) {
+      run_options->filter = value;
+    } else if (parse_option(arg, "--repetitions", &value)) {
+      run_options->repetitions = std::max(atoi(value.c_str()), 1);
+    } else if (parse_option(arg, "--min-time", &value)) {
+      run_options->min_time_ms = std::max(atoi(value.c_str()), 1);
+    } else if (parse_option(arg, "--output", &value)) {
+      run_options->output = value;
+    } else if (parse_option(arg, "--compare", &value)) {
+      run_options->compare = value;
+    } else if (parse_option(arg, "--sql-script", &value)) {
+      options->sql_script = value;
+    } else if (parse_option(arg, "--json-file", &value)) {
+      options->json_file = value;
+    } else {
+      usage();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+Result measure(const std::string &name, Benchmark *benchmark,
+               const Run_options &run_options) {
+  using clock = std::chrono::steady_clock;
+  const std::chrono::milliseconds min_time(run_options.min_time_ms);
+
+  Result result;
+  result.name = name;
+  result.bytes = benchmark->bytes();
+  result.items = benchmark->items();
+
+  // warm up caches and allocators
+  benchmark->run();
+
+  for (int i = 0; i < run_options.repetitions; ++i) {
+    uint64_t runs = 0;
+    const auto start = clock::now();
+    clock::duration elapsed;
+
+    do {
+      benchmark->run();
+      ++runs;
+      elapsed = clock::now() - start;
+    } while (elapsed < min_time);
+
+    result.runs += runs;
+    result.samples.push_back(
+        std::chrono::duration<double, std::nano>(elapsed).count() / runs);
+  }
+
+  std::sort(result.samples.begin(), result.samples.end());
+
+  return result;
+}
+
+/**
+ * Reads the best time per item of each benchmark from results written by
+ * another run.
+ */
+std::map<std::string, double> load_baseline(const std::string &path) {
+  std::string contents;
+
+  if (!shcore::load_text_file(path, contents)) {
+    throw std::runtime_error("Could not read " + path);
+  }
+
+  const auto benchmarks =
+      shcore::Value::parse(contents).as_map()->get_array("benchmarks");
+  std::map<std::string, double> baseline;
+
+  for (const auto &benchmark : *benchmarks) {
+    const auto map = benchmark.as_map();
+    baseline[map->get_string("name")] =
+        map->at("bestNs").as_double() /
+        std::max<double>(map->at("itemsPerRun").as_double(), 1);
+  }
+
+  return baseline;
+}
+
+void print_header(bool compare) {
+  printf("%-32s %14s %14s %10s %14s%s\n", "Benchmark", "Best (ns)",
+         "Median (ns)", "MB/s", "Items/s", compare ? "     Change" : "");
+}
+
+void print_result(const Result &result,
+                  const std::map<std::string, double> *baseline) {
+  printf("%-32s %14.0f %14.0f ", result.name.c_str(), result.best(),
+         result.median());
+
+  if (result.bytes > 0) {
+    printf("%10.1f ", result.mb_per_second());
+  } else {
+    printf("%10s ", "-");
+  }
+
+  printf("%14.0f", result.items_per_second());
+
+  if (baseline) {
+    const auto previous = baseline->find(result.name);
+
+    if (previous == baseline->end() || previous->second <= 0) {
+      printf(" %10s", "-");
+    } else {
+      // time per item is compared, so inputs of different sizes can be used,
+      // positive change means that the benchmark is slower now
+      printf(" %+9.1f%%",
+             (result.best() / std::max<uint64_t>(result.items, 1) /
+                  previous->second -
+              1) *
+                 100);
+    }
+  }
+
+  printf("\n");
+  fflush(stdout);
+}
+
+std::string to_json(const std::vector<Result> &results,
+                    const Run_options &run_options) {
+  shcore::JSON_dumper dumper(true);
+
+  dumper.start_object();
+  dumper.append_string("version", shcore::get_long_version());
+  dumper.append_int("repetitions", run_options.repetitions);
+  dumper.append_int("minTimeMs", run_options.min_time_ms);
+
+  dumper.append_string("benchmarks");
+  dumper.start_array();
+
+  for (const auto &result : results) {
+    dumper.start_object();
+    dumper.append_string("name", result.name);
+    dumper.append_uint64("runs", result.runs);
+    dumper.append_uint64("bytesPerRun", result.bytes);
+    dumper.append_uint64("itemsPerRun", result.items);
+    dumper.append_float("bestNs", result.best());
+    dumper.append_float("medianNs", result.median());
+    dumper.append_float("worstNs", result.worst());
+    dumper.append_float("mbPerSecond", result.mb_per_second());
+    dumper.append_float("itemsPerSecond", result.items_per_second());
+    dumper.end_object();
+  }
+
+  dumper.end_array();
+  dumper.end_object();
+
+  return dumper.str() + "\n";
+}
+
+}  // namespace
+
+std::map<std::string, Benchmark_factory> &registry() {
+  static std::map<std::string, Benchmark_factory> benchmarks;
+  return benchmarks;
+}
+
+void consume(uint64_t value) { g_sink = g_sink + value; }
+
+}  // namespace benchmarks
+}  // namespace mysqlsh
+
+int main(int argc, char **argv) {
+  using mysqlsh::benchmarks::registry;
+
+  mysqlsh::benchmarks::Run_options run_options;
+  mysqlsh::benchmarks::Options options;
+
+  if (!mysqlsh::benchmarks::parse_args(argc, argv, &run_options, &options)) {
+    return 1;
+  }
+
+  if (run_options.list) {
+    for (const auto &benchmark : registry()) {
+      printf("%s\n", benchmark.first.c_str());
+    }
+
+    return 0;
+  }
+
+  // formatting of results registers interrupt handlers and logs the output
+  shcore::Interrupts::init(nullptr);
+  ngcommon::Logger::setup_instance(nullptr, false,
+                                   ngcommon::Logger::LOG_WARNING);
+
+  std::map<std::string, double> baseline;
+
+  try {
+    if (!run_options.compare.empty()) {
+      baseline = mysqlsh::benchmarks::load_baseline(run_options.compare);
+    }
+  } catch (const std::exception &e) {
+    fprintf(stderr, "Invalid baseline: %s\n", e.what());
+    return 1;
+  }
+
+  std::vector<mysqlsh::benchmarks::Result> results;
+  int failures = 0;
+
+  mysqlsh::benchmarks::print_header(!run_options.compare.empty());
+
+  for (const auto &entry : registry()) {
+    if (entry.first.find(run_options.filter) == std::string::npos) continue;
+
+    const auto benchmark = entry.second();
+
+    try {
+      benchmark->setup(options);
+      results.emplace_back(mysqlsh::benchmarks::measure(
+          entry.first, benchmark.get(), run_options));
+      benchmark->teardown();
+    } catch (const std::exception &e) {
+      fprintf(stderr, "%s failed: %s\n", entry.first.c_str(), e.what());
+      benchmark->teardown();
+      ++failures;
+      continue;
+    }
+
+    mysqlsh::benchmarks::print_result(
+        results.back(), run_options.compare.empty() ? nullptr : &baseline);
+  }
+
+  if (!run_options.output.empty() &&
+      !shcore::create_file(run_options.output,
+                           mysqlsh::benchmarks::to_json(results,
+                                                        run_options))) {
+    fprintf(stderr, "Could not write %s\n", run_options.output.c_str());
+    return 1;
+  }
+
+  return failures == 0 ? 0 : 1;
+}
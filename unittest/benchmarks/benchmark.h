@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#ifndef UNITTEST_BENCHMARKS_BENCHMARK_H_
+#define UNITTEST_BENCHMARKS_BENCHMARK_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace mysqlsh {
+namespace benchmarks {
+
+/**
+ * Command line options which may be used by the benchmarks to process
+ * captured inputs instead of generating synthetic ones.
+ */
+struct Options {
+  // SQL script processed by the SQL splitter benchmarks
+  std::string sql_script;
+  // file with JSON documents processed by the JSON parser benchmarks
+  std::string json_file;
+};
+
+/**
+ * Base class of the benchmarks.
+ *
+ * The input is prepared once by setup(), then run() is called repeatedly
+ * until the requested time passes. Each call to run() has to do the same
+ * amount of work, described by the number of bytes and items it processes.
+ * Inputs are generated using a fixed seed, so results of different builds
+ * can be compared.
+ */
+class Benchmark {
+ public:
+  Benchmark() = default;
+  Benchmark(const Benchmark &) = delete;
+  Benchmark &operator=(const Benchmark &) = delete;
+  virtual ~Benchmark() = default;
+
+  virtual void setup(const Options &options) = 0;
+
+  virtual void run() = 0;
+
+  virtual void teardown() {}
+
+  /**
+   * Number of bytes processed by a single call to run(), 0 if not applicable.
+   */
+  uint64_t bytes() const { return m_bytes; }
+
+  /**
+   * Number of items (statements, documents, rows...) processed by a single
+   * call to run().
+   */
+  uint64_t items() const { return m_items; }
+
+ protected:
+  void set_bytes(uint64_t bytes) { m_bytes = bytes; }
+  void set_items(uint64_t items) { m_items = items; }
+
+ private:
+  uint64_t m_bytes = 0;
+  uint64_t m_items = 1;
+};
+
+using Benchmark_factory = std::function<std::unique_ptr<Benchmark>()>;
+
+/**
+ * Benchmarks sorted by their names, names use the "component/case" form.
+ */
+std::map<std::string, Benchmark_factory> &registry();
+
+template <class T>
+struct Benchmark_registrar {
+  explicit Benchmark_registrar(const char *name) {
+    registry()[name] = []() { return std::unique_ptr<Benchmark>(new T()); };
+  }
+};
+
+#define REGISTER_BENCHMARK(name, type)                         \
+  static const mysqlsh::benchmarks::Benchmark_registrar<type> \
+      k_##type##_registrar(name)
+
+/**
+ * Makes the given value observable, so computations producing it are not
+ * optimized away.
+ */
+void consume(uint64_t value);
+
+}  // namespace benchmarks
+}  // namespace mysqlsh
+
+#endif  // UNITTEST_BENCHMARKS_BENCHMARK_H_
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+// Benchmarks of the SQL splitter, the JSON document parser and the URI parser.
+
+#include <istream>
+#include <random>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/db/uri_parser.h"
+#include "mysqlshdk/libs/utils/document_parser.h"
+#include "mysqlshdk/libs/utils/utils_buffered_input.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_mysql_parsing.h"
+#include "unittest/benchmarks/benchmark.h"
+
+namespace mysqlsh {
+namespace benchmarks {
+
+namespace {
+
+constexpr size_t k_chunk_size = 64 * 1024;
+
+/**
+ * Stream reading from a string without copying it.
+ */
+class Memory_buffer : public std::streambuf {
+ public:
+  explicit Memory_buffer(const std::string &data) {
+    const auto begin = const_cast<char *>(data.data());
+    setg(begin, begin, begin + data.size());
+  }
+};
+
+std::string random_text(std::mt19937 *rng, size_t length) {
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::string text;
+
+  for (size_t i = 0; i < length; ++i) {
+    text.push_back(static_cast<char>(chars(*rng)));
+  }
+
+  return text;
+}
+
+class Sql_splitter_benchmark : public Benchmark {
+ public:
+  void setup(const Options &options) override {
+    if (options.sql_script.empty()) {
+      m_script = generate_script();
+    } else if (!shcore::load_text_file(options.sql_script, m_script)) {
+      throw std::runtime_error("Could not read " + options.sql_script);
+    }
+
+    set_bytes(m_script.size());
+    set_items(split());
+  }
+
+  void run() override { consume(split()); }
+
+ protected:
+  virtual std::string generate_script() = 0;
+
+ private:
+  size_t split() {
+    Memory_buffer buffer(m_script);
+    std::istream stream(&buffer);
+    size_t statements = 0;
+
+    mysqlshdk::utils::iterate_sql_stream(
+        &stream, k_chunk_size,
+        [&statements](const char *, size_t, const std::string &, size_t) {
+          ++statements;
+          return true;
+        },
+        [](const std::string &err) { throw std::runtime_error(err); });
+
+    return statements;
+  }
+
+  std::string m_script;
+};
+
+/**
+ * Dump-like script, with large extended INSERT statements.
+ */
+class Sql_splitter_dump : public Sql_splitter_benchmark {
+ protected:
+  std::string generate_script() override {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> specials(0, 99);
+    std::string script = "SET NAMES utf8mb4;\nUSE `test`;\n";
+    size_t id = 0;
+
+    while (script.size() < 16 * 1024 * 1024) {
+      script.append("INSERT INTO `t` VALUES ");
+
+      for (int row = 0; row < 100; ++row) {
+        if (row > 0) script.push_back(',');
+        script.append("(").append(std::to_string(++id)).append(",'");
+
+        for (int i = 0; i < 64; ++i) {
+          const int special = specials(rng);
+          if (special == 0)
+            script.append("\\'");
+          else if (special == 1)
+            script.append("\\n");
+          else if (special == 2)
+            script.push_back(';');
+          else
+            script.append(random_text(&rng, 4));
+        }
+
+        script.append("',").append(std::to_string(id * 7 % 1000)).append(")");
+      }
+
+      script.append(";\n");
+    }
+
+    return script;
+  }
+};
+
+/**
+ * Script with many short statements, comments and stored programs using a
+ * custom delimiter.
+ */
+class Sql_splitter_statements : public Sql_splitter_benchmark {
+ protected:
+  std::string generate_script() override {
+    std::mt19937 rng(42);
+    std::string script;
+
+    for (int i = 0; script.size() < 4 * 1024 * 1024; ++i) {
+      const auto n = std::to_string(i);
+      const auto text = random_text(&rng, 16);
+
+      script.append("-- statement ").append(n).append("\n");
+      script.append("SELECT * FROM `t` WHERE id = ")
+          .append(n)
+          .append(" AND name = '")
+          .append(text)
+          .append(";';\n");
+      script.append("/* update; */ UPDATE t SET c = \"x\\\"")
+          .append(text)
+          .append("\" WHERE id = ")
+          .append(n)
+          .append(";\n");
+
+      if (i % 10 == 0) {
+        script.append("DELIMITER $$\nCREATE PROCEDURE p")
+            .append(n)
+            .append("()\nBEGIN\n  SELECT 1;\n  # comment;\n  SELECT '")
+            .append(text)
+            .append("';\nEND$$\nDELIMITER ;\n");
+      }
+    }
+
+    return script;
+  }
+};
+
+REGISTER_BENCHMARK("sql_splitter/dump", Sql_splitter_dump);
+REGISTER_BENCHMARK("sql_splitter/statements", Sql_splitter_statements);
+
+class Json_parser_benchmark : public Benchmark {
+ public:
+  void setup(const Options &options) override {
+    if (options.json_file.empty()) {
+      m_path = shcore::get_tempfile_path("mysqlsh_benchmarks.json");
+      m_temporary = true;
+
+      if (!shcore::create_file(m_path, generate_documents())) {
+        throw std::runtime_error("Could not write " + m_path);
+      }
+    } else {
+      m_path = options.json_file;
+    }
+
+    set_bytes(shcore::file_size(m_path));
+    set_items(parse());
+  }
+
+  void run() override { consume(parse()); }
+
+  void teardown() override {
+    if (m_temporary) shcore::delete_file(m_path);
+  }
+
+ protected:
+  virtual size_t parse() = 0;
+
+  std::string m_path;
+  shcore::Document_reader_options m_options;
+
+ private:
+  static std::string generate_documents() {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> numbers(0, 99999);
+    std::string documents;
+
+    for (int i = 0; documents.size() < 4 * 1024 * 1024; ++i) {
+      const auto n = std::to_string(i);
+
+      documents.append("{\"_id\": {\"$oid\": \"5b7a2c")
+          .append(std::string(18 - n.size(), '0'))
+          .append(n)
+          .append("\"}, \"name\": \"")
+          .append(random_text(&rng, 12))
+          .append("\", \"age\": ")
+          .append(std::to_string(numbers(rng) % 100))
+          .append(", \"score\": ")
+          .append(std::to_string(numbers(rng) / 100.0))
+          .append(", \"active\": ")
+          .append(i % 2 ? "true" : "false")
+          .append(", \"created\": {\"$date\": \"2018-08-20T10:00:00Z\"}")
+          .append(", \"tags\": [\"")
+          .append(random_text(&rng, 5))
+          .append("\", \"")
+          .append(random_text(&rng, 7))
+          .append("\", null], \"address\": {\"street\": \"")
+          .append(random_text(&rng, 20))
+          .append("\", \"zip\": \"")
+          .append(std::to_string(numbers(rng)))
+          .append("\"}, \"bio\": \"")
+          .append(random_text(&rng, 40))
+          .append(" \\\"quoted\\\"\\n\\u00e9")
+          .append(random_text(&rng, 40))
+          .append("\"}\n");
+    }
+
+    return documents;
+  }
+
+  bool m_temporary = false;
+};
+
+/**
+ * Documents are copied from the buffered input, as done when importing
+ * from a pipe.
+ */
+class Json_parser_parse : public Json_parser_benchmark {
+ protected:
+  size_t parse() override {
+    shcore::Buffered_input input(m_path);
+    shcore::Json_reader reader(&input, m_options);
+    size_t documents = 0;
+
+    while (!reader.eof()) {
+      if (!reader.next().empty()) ++documents;
+    }
+
+    return documents;
+  }
+};
+
+/**
+ * Documents with BSON types ($oid, $date) are converted.
+ */
+class Json_parser_convert_bson : public Json_parser_parse {
+ public:
+  Json_parser_convert_bson() {
+    m_options.convert_bson_types = true;
+    m_options.convert_bson_id = true;
+  }
+};
+
+/**
+ * Documents are only validated and referenced in the memory mapped input,
+ * as done when importing from a regular file.
+ */
+class Json_parser_validate : public Json_parser_benchmark {
+ protected:
+  size_t parse() override {
+    shcore::Buffered_input input;
+    input.open(m_path, true);
+    shcore::Json_reader reader(&input, m_options);
+
+    if (!reader.supports_views()) {
+      throw std::runtime_error("Could not map " + m_path + " into memory");
+    }
+
+    shcore::Document_view document;
+    size_t documents = 0;
+
+    while (reader.next(&document)) ++documents;
+
+    return documents;
+  }
+};
+
+REGISTER_BENCHMARK("json_parser/parse", Json_parser_parse);
+REGISTER_BENCHMARK("json_parser/convert_bson", Json_parser_convert_bson);
+REGISTER_BENCHMARK("json_parser/validate", Json_parser_validate);
+
+class Uri_parser_benchmark : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    size_t bytes = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+      const auto n = std::to_string(i);
+
+      switch (i % 5) {
+        case 0:
+          m_uris.emplace_back("mysql://user" + n + ":pass" + n + "@host" + n +
+                              ".example.com:" + std::to_string(3306 + i) +
+                              "/schema" + n);
+          break;
+
+        case 1:
+          m_uris.emplace_back("mysqlx://root@127.0.0." +
+                              std::to_string(i % 256) + ":33060/test");
+          break;
+
+        case 2:
+          m_uris.emplace_back("mysql://admin%2A" + n +
+                              ":p%2Ass@[::1:2:3:4:5:6:7]:3306/world%20x");
+          break;
+
+        case 3:
+          m_uris.emplace_back("mysqlx://user" + n +
+                              "@(/var/run/mysqld/mysqld" + n + ".sock)/db");
+          break;
+
+        default:
+          m_uris.emplace_back("mysqlx://user@10.150.123." +
+                              std::to_string(i % 256) +
+                              ":2845/world?ssl-ca=(/etc/ssl/ca.pem)&"
+                              "ssl-cipher=AES256-SHA&auth-method=PLAIN");
+          break;
+      }
+
+      bytes += m_uris.back().size();
+    }
+
+    set_bytes(bytes);
+    set_items(m_uris.size());
+  }
+
+  void run() override {
+    for (const auto &uri : m_uris) {
+      // parser keeps the state of the last parsed URI, it cannot be reused
+      mysqlshdk::db::uri::Uri_parser parser;
+      consume(parser.parse(uri).has_port());
+    }
+  }
+
+ private:
+  std::vector<std::string> m_uris;
+};
+
+REGISTER_BENCHMARK("uri_parser/parse", Uri_parser_benchmark);
+
+}  // namespace
+
+}  // namespace benchmarks
+}  // namespace mysqlsh
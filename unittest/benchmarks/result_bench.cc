@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+// Benchmarks of the copies of rows and of the formatting of results, using
+// synthetic results instead of the ones received from a server.
+
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
+#include "mysqlshdk/include/shellcore/shell_resultset_dumper.h"
+#include "mysqlshdk/libs/db/mutable_result.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/shellcore/shell_console.h"
+#include "unittest/benchmarks/benchmark.h"
+
+namespace mysqlsh {
+namespace benchmarks {
+
+namespace {
+
+using mysqlshdk::db::Mutable_result;
+using mysqlshdk::db::Mutable_row;
+using mysqlshdk::db::Type;
+
+constexpr int k_rows = 1000;
+
+const std::vector<Type> k_types{Type::Integer, Type::String, Type::Double,
+                                Type::Decimal, Type::DateTime, Type::String};
+
+std::vector<std::unique_ptr<Mutable_row>> generate_rows() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::uniform_int_distribution<int> numbers(0, 99999);
+
+  const auto text = [&rng, &chars](size_t length) {
+    std::string result;
+    for (size_t i = 0; i < length; ++i) {
+      result.push_back(static_cast<char>(chars(rng)));
+    }
+    return result;
+  };
+
+  std::vector<std::unique_ptr<Mutable_row>> rows;
+
+  for (int i = 0; i < k_rows; ++i) {
+    auto row = shcore::make_unique<Mutable_row>(k_types);
+
+    row->set_field(0, static_cast<int64_t>(i));
+    row->set_field(1, text(8 + i % 24));
+    row->set_field(2, numbers(rng) / 100.0);
+    row->set_field(3, std::to_string(numbers(rng)) + ".25");
+    row->set_field(4, std::string("2018-08-20 10:00:00"));
+
+    if (i % 10 == 0)
+      row->set_field(5, nullptr);
+    else
+      row->set_field(5, text(40));
+
+    rows.emplace_back(std::move(row));
+  }
+
+  return rows;
+}
+
+class Mem_row_copy : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    m_rows = generate_rows();
+    set_items(m_rows.size());
+  }
+
+  void run() override {
+    for (const auto &row : m_rows) {
+      mysqlshdk::db::Row_copy copy(*row);
+      consume(copy.num_fields());
+    }
+  }
+
+ private:
+  std::vector<std::unique_ptr<Mutable_row>> m_rows;
+};
+
+/**
+ * Rows are buffered the way results are buffered before they are printed.
+ */
+class Mem_row_batch : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    m_rows = generate_rows();
+    set_items(m_rows.size());
+  }
+
+  void run() override {
+    m_batch.clear();
+
+    for (const auto &row : m_rows) {
+      m_batch.append(*row);
+    }
+
+    consume(m_batch.size());
+  }
+
+ private:
+  std::vector<std::unique_ptr<Mutable_row>> m_rows;
+  mysqlshdk::db::Row_batch m_batch{k_types};
+};
+
+REGISTER_BENCHMARK("mem_row/row_copy", Mem_row_copy);
+REGISTER_BENCHMARK("mem_row/row_batch", Mem_row_batch);
+
+/**
+ * Prints a result using the given format, the printed text is discarded and
+ * its size is reported as the number of processed bytes.
+ */
+class Resultset_dumper_benchmark : public Benchmark {
+ public:
+  explicit Resultset_dumper_benchmark(const char *format) : m_format(format) {}
+
+  void setup(const Options &) override {
+    std::vector<mysqlshdk::db::Column> columns;
+    const char *names[] = {"id", "name", "score", "price", "created", "note"};
+
+    for (size_t i = 0; i < k_types.size(); ++i) {
+      columns.emplace_back(Mutable_result::make_column(names[i], k_types[i]));
+    }
+
+    m_result = shcore::make_unique<Mutable_result>(columns);
+
+    for (auto &row : generate_rows()) {
+      m_result->add_row(std::move(row));
+    }
+
+    auto options = std::make_shared<Shell_options>();
+    options->set(SHCORE_RESULT_FORMAT, m_format);
+
+    m_delegate.user_data = &m_printed;
+    m_delegate.print = &Resultset_dumper_benchmark::print;
+    m_delegate.print_diag = &Resultset_dumper_benchmark::print;
+    m_delegate.print_error = &Resultset_dumper_benchmark::print;
+
+    m_options = shcore::make_unique<Scoped_shell_options>(options);
+    m_console = shcore::make_unique<Scoped_console>(
+        std::make_shared<Shell_console>(&m_delegate));
+
+    dump();
+    set_bytes(m_printed);
+    set_items(k_rows);
+  }
+
+  void run() override { consume(dump()); }
+
+  void teardown() override {
+    m_console.reset();
+    m_options.reset();
+  }
+
+ private:
+  static void print(void *user_data, const char *text) {
+    *static_cast<size_t *>(user_data) += strlen(text);
+  }
+
+  size_t dump() {
+    m_printed = 0;
+    m_result->reset();
+
+    // results are streamed, as done in SQL mode, Mutable_result cannot be
+    // rewound to print the buffered rows
+    Resultset_dumper dumper(m_result.get(), false);
+    dumper.dump("row", true, false);
+
+    return m_printed;
+  }
+
+  std::string m_format;
+  std::unique_ptr<Mutable_result> m_result;
+  shcore::Interpreter_delegate m_delegate;
+  size_t m_printed = 0;
+  std::unique_ptr<Scoped_shell_options> m_options;
+  std::unique_ptr<Scoped_console> m_console;
+};
+
+class Resultset_dumper_table : public Resultset_dumper_benchmark {
+ public:
+  Resultset_dumper_table() : Resultset_dumper_benchmark("table") {}
+};
+
+class Resultset_dumper_tabbed : public Resultset_dumper_benchmark {
+ public:
+  Resultset_dumper_tabbed() : Resultset_dumper_benchmark("tabbed") {}
+};
+
+class Resultset_dumper_vertical : public Resultset_dumper_benchmark {
+ public:
+  Resultset_dumper_vertical() : Resultset_dumper_benchmark("vertical") {}
+};
+
+class Resultset_dumper_json : public Resultset_dumper_benchmark {
+ public:
+  Resultset_dumper_json() : Resultset_dumper_benchmark("json") {}
+};
+
+REGISTER_BENCHMARK("resultset_dumper/table", Resultset_dumper_table);
+REGISTER_BENCHMARK("resultset_dumper/tabbed", Resultset_dumper_tabbed);
+REGISTER_BENCHMARK("resultset_dumper/vertical", Resultset_dumper_vertical);
+REGISTER_BENCHMARK("resultset_dumper/json", Resultset_dumper_json);
+
+}  // namespace
+
+}  // namespace benchmarks
+}  // namespace mysqlsh
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+// Measures the throughput of the SQL splitter, as used to execute SQL scripts
+// in batch mode.
+//
+// Usage: sql_splitter_bench [script.sql]
+//
+// If no script is given, a dump-like script with large extended INSERT
+// statements is generated. Compare with the output of
+// sql_splitter_bench_scalar to see the gain of the vectorized scanning.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "mysqlshdk/libs/utils/utils_mysql_parsing.h"
+
+namespace {
+
+constexpr size_t k_chunk_size = 64 * 1024;
+constexpr int k_iterations = 5;
+
+std::string generate_script(size_t size) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::uniform_int_distribution<int> specials(0, 99);
+
+  std::string script;
+  script.reserve(size + 1024 * 1024);
+  script.append("SET NAMES utf8mb4;\nUSE `test`;\n");
+
+  size_t id = 0;
+  while (script.size() < size) {
+    script.append("INSERT INTO `blobs` VALUES ");
+
+    for (int row = 0; row < 100; ++row) {
+      if (row > 0) script.push_back(',');
+      script.append("(").append(std::to_string(++id)).append(",'");
+
+      for (int i = 0; i < 4096; ++i) {
+        const int special = specials(rng);
+        if (special == 0)
+          script.append("\\'");
+        else if (special == 1)
+          script.append("\\n");
+        else if (special == 2)
+          script.push_back(';');
+        else
+          script.push_back(static_cast<char>(chars(rng)));
+      }
+
+      script.append("',`id`)");
+    }
+
+    script.append(";\n");
+  }
+
+  return script;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  std::string script;
+
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      fprintf(stderr, "Could not open %s\n", argv[1]);
+      return 1;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    script = contents.str();
+  } else {
+    script = generate_script(256 * 1024 * 1024);
+  }
+
+  double best = 0.0;
+  size_t statements = 0;
+
+  for (int i = 0; i < k_iterations; ++i) {
+    std::istringstream stream(script);
+    statements = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    mysqlshdk::utils::iterate_sql_stream(
+        &stream, k_chunk_size,
+        [&statements](const char *, size_t, const std::string &, size_t) {
+          ++statements;
+          return true;
+        },
+        [](const std::string &err) { fprintf(stderr, "%s\n", err.c_str()); });
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    best = std::max(best, script.size() / elapsed.count() / (1024 * 1024));
+  }
+
+#ifdef MYSQLSHDK_SQL_SPLITTER_SCALAR
+  const char *variant = "scalar";
+#else
+  const char *variant = "vectorized";
+#endif
+
+  printf("%s: %zu bytes, %zu statements, %.1f MB/s\n", variant, script.size(),
+         statements, best);
+
+  return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+// Benchmarks of the conversions of shcore::Value to and from text, and of the
+// escaping of SQL strings and identifiers.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/utils_sqlstring.h"
+#include "scripting/types.h"
+#include "unittest/benchmarks/benchmark.h"
+
+namespace mysqlsh {
+namespace benchmarks {
+
+namespace {
+
+constexpr int k_documents = 1000;
+
+/**
+ * Array of documents, as returned by the X DevAPI or given as options.
+ */
+std::string generate_documents() {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int> chars('a', 'z');
+  std::uniform_int_distribution<int> numbers(0, 99999);
+
+  const auto text = [&rng, &chars](size_t length) {
+    std::string result;
+    for (size_t i = 0; i < length; ++i) {
+      result.push_back(static_cast<char>(chars(rng)));
+    }
+    return result;
+  };
+
+  std::string documents = "[";
+
+  for (int i = 0; i < k_documents; ++i) {
+    if (i > 0) documents.append(", ");
+
+    documents.append("{\"id\": ")
+        .append(std::to_string(i))
+        .append(", \"name\": \"")
+        .append(text(12))
+        .append("\", \"score\": ")
+        .append(std::to_string(numbers(rng) / 100.0))
+        .append(", \"active\": ")
+        .append(i % 2 ? "true" : "false")
+        .append(", \"tags\": [\"")
+        .append(text(5))
+        .append("\", \"")
+        .append(text(7))
+        .append("\"], \"address\": {\"street\": \"")
+        .append(text(20))
+        .append("\", \"zip\": ")
+        .append(std::to_string(numbers(rng)))
+        .append("}, \"note\": null, \"bio\": \"")
+        .append(text(30))
+        .append(" \\\"quoted\\\"\\n")
+        .append(text(30))
+        .append("\"}");
+  }
+
+  documents.append("]");
+
+  return documents;
+}
+
+class Value_parse : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    m_text = generate_documents();
+    set_bytes(m_text.size());
+    set_items(k_documents);
+  }
+
+  void run() override {
+    consume(shcore::Value::parse(m_text).as_array()->size());
+  }
+
+ private:
+  std::string m_text;
+};
+
+/**
+ * Base of the benchmarks converting a Value to text, bytes are counted in
+ * the produced text.
+ */
+class Value_to_text : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    m_value = shcore::Value::parse(generate_documents());
+    set_bytes(convert().size());
+    set_items(k_documents);
+  }
+
+  void run() override { consume(convert().size()); }
+
+ protected:
+  virtual std::string convert() const = 0;
+
+  shcore::Value m_value;
+};
+
+class Value_json : public Value_to_text {
+ protected:
+  std::string convert() const override { return m_value.json(); }
+};
+
+class Value_json_pretty : public Value_to_text {
+ protected:
+  std::string convert() const override { return m_value.json(true); }
+};
+
+class Value_repr : public Value_to_text {
+ protected:
+  std::string convert() const override { return m_value.repr(); }
+};
+
+class Value_descr : public Value_to_text {
+ protected:
+  std::string convert() const override { return m_value.descr(true); }
+};
+
+REGISTER_BENCHMARK("value/parse", Value_parse);
+REGISTER_BENCHMARK("value/json", Value_json);
+REGISTER_BENCHMARK("value/json_pretty", Value_json_pretty);
+REGISTER_BENCHMARK("value/repr", Value_repr);
+REGISTER_BENCHMARK("value/descr", Value_descr);
+
+/**
+ * Names and values with characters which need to be escaped.
+ */
+class Sqlstring_benchmark : public Benchmark {
+ public:
+  void setup(const Options &) override {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> chars(0, 99);
+    size_t bytes = 0;
+
+    for (int i = 0; i < 1000; ++i) {
+      std::string value;
+
+      for (int c = 0; c < 64; ++c) {
+        const int special = chars(rng);
+        if (special == 0)
+          value.push_back('\'');
+        else if (special == 1)
+          value.push_back('\\');
+        else if (special == 2)
+          value.push_back('\n');
+        else if (special == 3)
+          value.push_back('\0');
+        else if (special == 4)
+          value.push_back('%');
+        else
+          value.push_back(static_cast<char>('a' + special % 26));
+      }
+
+      m_names.emplace_back("column`" + std::to_string(i));
+      m_values.emplace_back(std::move(value));
+      bytes += m_names.back().size() + m_values.back().size();
+    }
+
+    set_bytes(bytes);
+    set_items(m_values.size());
+  }
+
+ protected:
+  std::vector<std::string> m_names;
+  std::vector<std::string> m_values;
+};
+
+class Sqlstring_format : public Sqlstring_benchmark {
+ public:
+  void run() override {
+    for (size_t i = 0; i < m_values.size(); ++i) {
+      shcore::sqlstring query("SELECT ! FROM !.! WHERE ! = ? AND id > ?", 0);
+      query << m_names[i] << "schema" << "table" << m_names[i] << m_values[i]
+            << i;
+      consume(query.str().size());
+    }
+  }
+};
+
+class Sqlstring_escape : public Sqlstring_benchmark {
+ public:
+  void run() override {
+    for (size_t i = 0; i < m_values.size(); ++i) {
+      consume(shcore::escape_sql_string(m_values[i], true).size() +
+              shcore::quote_identifier(m_names[i]).size());
+    }
+  }
+};
+
+REGISTER_BENCHMARK("sqlstring/format", Sqlstring_format);
+REGISTER_BENCHMARK("sqlstring/escape", Sqlstring_escape);
+
+}  // namespace
+
+}  // namespace benchmarks
+}  // namespace mysqlsh
@@ -25,11 +25,13 @@
 
 #ifndef _WIN32
 #include <sys/stat.h>
+#include <unistd.h>
 #endif
 #include "ext/linenoise-ng/include/linenoise.h"
 #include "mysqlshdk/libs/utils/strformat.h"
 #include "mysqlshdk/libs/utils/utils_file.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
 #include "mysqlshdk/libs/utils/utils_string.h"
 #include "src/mysqlsh/cmdline_shell.h"
 #include "unittest/test_utils.h"
@@ -198,4 +200,72 @@ TEST(Cmdline_shell, help) {
   EXPECT_EQ(expected, capture);
 }
 
+#ifndef _WIN32
+TEST(Cmdline_shell, buffered_output) {
+  const std::string path = shcore::path::join_path(
+      getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp", "buffered_output.txt");
+
+  // redirect stdout to a file, so output is buffered
+  fflush(stdout);
+  const int saved_stdout = dup(fileno(stdout));
+  FILE *file = fopen(path.c_str(), "w");
+  ASSERT_NE(nullptr, file);
+  dup2(fileno(file), fileno(stdout));
+  fclose(file);
+
+  {
+    Command_line_shell shell(std::make_shared<Shell_options>());
+    // output is not flushed because of time passing, unless requested
+    shell.set_output_flush_interval(std::chrono::hours(1));
+    shell.flush_output();
+    const std::string initial = shcore::get_text_file(path);
+
+    Command_line_shell::deleg_print(&shell, "one ");
+    Command_line_shell::deleg_print(&shell, "two ");
+    EXPECT_EQ(initial, shcore::get_text_file(path));
+
+    shell.flush_output();
+    EXPECT_EQ(initial + "one two ", shcore::get_text_file(path));
+
+    // errors are written right away
+    Command_line_shell::deleg_print(&shell, "three ");
+    Command_line_shell::deleg_print_error(&shell, "error\n");
+    EXPECT_EQ(initial + "one two three error\n", shcore::get_text_file(path));
+
+    // text bigger than the buffer is not buffered
+    const std::string big(100000, 'x');
+    Command_line_shell::deleg_print(&shell, "four ");
+    Command_line_shell::deleg_print(&shell, big.c_str());
+    EXPECT_EQ(initial + "one two three error\nfour " + big,
+              shcore::get_text_file(path));
+
+    // output is written out once the flush interval passes
+    shell.set_output_flush_interval(std::chrono::milliseconds(0));
+    Command_line_shell::deleg_print(&shell, "five ");
+    EXPECT_EQ(initial + "one two three error\nfour " + big + "five ",
+              shcore::get_text_file(path));
+
+    // also if nothing else is printed
+    shell.set_output_flush_interval(std::chrono::milliseconds(50));
+    Command_line_shell::deleg_print(&shell, "six ");
+    for (int i = 0; i < 1000; ++i) {
+      if (shcore::str_endswith(shcore::get_text_file(path), "six ")) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(shcore::str_endswith(shcore::get_text_file(path), "six "));
+
+    shell.set_output_flush_interval(std::chrono::hours(1));
+    Command_line_shell::deleg_print(&shell, "seven");
+  }
+
+  // output is written out when shell is destroyed
+  fflush(stdout);
+  dup2(saved_stdout, fileno(stdout));
+  close(saved_stdout);
+
+  EXPECT_TRUE(shcore::str_endswith(shcore::get_text_file(path), "six seven"));
+  shcore::delete_file(path);
+}
+#endif  // !_WIN32
+
 }  // namespace mysqlsh
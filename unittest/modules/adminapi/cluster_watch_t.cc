@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "modules/adminapi/dba/cluster_watch.h"
+#include "unittest/gtest_clean.h"
+
+namespace mysqlsh {
+namespace dba {
+
+TEST(Cluster_watch, describe_changes) {
+  using mysqlshdk::gr::Member;
+  using mysqlshdk::gr::Member_role;
+  using mysqlshdk::gr::Member_state;
+
+  const auto member = [](const std::string &uuid, int port, Member_state state,
+                         Member_role role) {
+    Member m;
+    m.uuid = uuid;
+    m.host = "localhost";
+    m.gr_port = port;
+    m.state = state;
+    m.role = role;
+    return m;
+  };
+
+  const std::map<std::string, std::string> labels{{"uuid1", "node1:3306"},
+                                                  {"uuid2", "node2:3306"}};
+
+  std::map<std::string, Member> before;
+  std::map<std::string, Member> after;
+
+  // nothing to report
+  EXPECT_TRUE(Cluster_watch::describe_changes(before, after, labels).empty());
+
+  // initial view, every member is reported
+  after["uuid1"] = member("uuid1", 3306, Member_state::ONLINE,
+                          Member_role::PRIMARY);
+  after["uuid2"] = member("uuid2", 3306, Member_state::RECOVERING,
+                          Member_role::SECONDARY);
+  EXPECT_EQ(std::vector<std::string>(
+                {"node1:3306: ONLINE, PRIMARY",
+                 "node2:3306: RECOVERING, SECONDARY"}),
+            Cluster_watch::describe_changes(before, after, labels));
+
+  // same view, nothing is reported
+  EXPECT_TRUE(Cluster_watch::describe_changes(after, after, labels).empty());
+
+  // state changes, unknown member joins
+  before = after;
+  after["uuid2"].state = Member_state::ONLINE;
+  after["uuid3"] = member("uuid3", 3310, Member_state::RECOVERING,
+                          Member_role::SECONDARY);
+  EXPECT_EQ(std::vector<std::string>(
+                {"node2:3306: RECOVERING, SECONDARY -> ONLINE, SECONDARY",
+                 "localhost:3310: RECOVERING, SECONDARY"}),
+            Cluster_watch::describe_changes(before, after, labels));
+
+  // role changes, member leaves
+  before = after;
+  after.erase("uuid1");
+  after["uuid2"].role = Member_role::PRIMARY;
+  EXPECT_EQ(std::vector<std::string>(
+                {"node2:3306: ONLINE, SECONDARY -> ONLINE, PRIMARY",
+                 "node1:3306: no longer in the group"}),
+            Cluster_watch::describe_changes(before, after, labels));
+}
+
+}  // namespace dba
+}  // namespace mysqlsh
@@ -176,4 +176,66 @@ TEST_F(Dba_replicaset_test, bug28219398) {
 
   md_session->close();
 }
+
+TEST_F(Dba_replicaset_test, metadata_snapshot) {
+  auto md_session = create_session(_mysql_sandbox_port1);
+  auto metadata = std::make_shared<mysqlsh::dba::MetadataStorage>(md_session);
+  uint64_t rs_id = m_cluster->get_default_replicaset()->get_id();
+  std::string address = "localhost:" + std::to_string(_mysql_sandbox_port1);
+
+  auto expected = metadata->get_replicaset_instances(rs_id);
+  auto expected_instance = metadata->get_instance(address);
+  uint64_t cluster_id = metadata->get_cluster_id("sample");
+  ASSERT_FALSE(expected.empty());
+
+  {
+    mysqlsh::dba::MetadataStorage::Snapshot snapshot(metadata);
+
+    EXPECT_EQ(cluster_id, metadata->get_cluster_id("sample"));
+    EXPECT_EQ(cluster_id, metadata->get_cluster_id(rs_id));
+    EXPECT_EQ(0u, metadata->get_cluster_id("no_such_cluster"));
+    EXPECT_TRUE(metadata->is_replicaset_active(rs_id));
+    EXPECT_FALSE(metadata->is_replicaset_empty(rs_id));
+    EXPECT_EQ(expected.size(), metadata->get_replicaset_count(rs_id));
+    EXPECT_TRUE(metadata->is_instance_on_replicaset(rs_id, address));
+
+    auto instances = metadata->get_replicaset_instances(rs_id);
+    ASSERT_EQ(expected.size(), instances.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected[i].uuid, instances[i].uuid);
+      EXPECT_EQ(expected[i].label, instances[i].label);
+      EXPECT_EQ(expected[i].endpoint, instances[i].endpoint);
+    }
+
+    auto instance = metadata->get_instance(address);
+    EXPECT_EQ(expected_instance.uuid, instance.uuid);
+    EXPECT_EQ(expected_instance.xendpoint, instance.xendpoint);
+    EXPECT_EQ(expected_instance.grendpoint, instance.grendpoint);
+    EXPECT_THROW(metadata->get_instance("localhost:1"), shcore::Exception);
+
+    // writes discard the snapshot
+    metadata->set_instance_label(rs_id, instance.label, "snapshot_label");
+    EXPECT_FALSE(metadata->is_instance_label_unique(rs_id, "snapshot_label"));
+    EXPECT_TRUE(metadata->is_instance_label_unique(rs_id, instance.label));
+    EXPECT_EQ("snapshot_label", metadata->get_instance(address).label);
+
+    metadata->set_instance_label(rs_id, "snapshot_label", instance.label);
+    EXPECT_EQ(instance.label, metadata->get_instance(address).label);
+
+    // as well as writes through other objects
+    auto other = std::make_shared<mysqlsh::dba::MetadataStorage>(md_session);
+    auto mode = metadata->get_replicaset_topology_mode(rs_id);
+    auto other_mode = mode == mysqlshdk::gr::Topology_mode::SINGLE_PRIMARY
+                          ? mysqlshdk::gr::Topology_mode::MULTI_PRIMARY
+                          : mysqlshdk::gr::Topology_mode::SINGLE_PRIMARY;
+
+    other->update_replicaset_topology_mode(rs_id, other_mode);
+    EXPECT_EQ(other_mode, metadata->get_replicaset_topology_mode(rs_id));
+
+    other->update_replicaset_topology_mode(rs_id, mode);
+    EXPECT_EQ(mode, metadata->get_replicaset_topology_mode(rs_id));
+  }
+
+  md_session->close();
+}
 }  // namespace tests
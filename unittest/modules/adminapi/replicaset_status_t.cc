@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "modules/adminapi/dba/replicaset_status.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/mocks/mysqlshdk/libs/db/mock_result.h"
+#include "unittest/test_utils/mocks/mysqlshdk/libs/db/mock_session.h"
+
+namespace mysqlsh {
+namespace dba {
+
+namespace {
+
+// Classic session which records the statements sent to the server instead of
+// executing them
+class Counting_session : public mysqlshdk::db::mysql::Session {
+ public:
+  std::shared_ptr<mysqlshdk::db::IResult> querys(const char *sql, size_t len,
+                                                 bool) override {
+    queries.emplace_back(sql, len);
+    return nullptr;
+  }
+
+  void execute_batch(const char *sql, size_t len,
+                     std::vector<std::shared_ptr<mysqlshdk::db::IResult>> *res,
+                     bool keep_resultsets) override {
+    batches.emplace_back(sql, len);
+    EXPECT_TRUE(keep_resultsets);
+    res->resize(3);
+  }
+
+  std::vector<std::string> queries;
+  std::vector<std::string> batches;
+};
+
+}  // namespace
+
+TEST(Replicaset_status, query_batch_classic) {
+  const std::string sql = "SELECT 1;SELECT ';';SELECT 3";
+  auto session = std::make_shared<Counting_session>();
+
+  // all the statements are sent in a single round trip
+  EXPECT_EQ(3u, detail::query_batch(session, sql).size());
+  EXPECT_EQ(std::vector<std::string>{sql}, session->batches);
+  EXPECT_TRUE(session->queries.empty());
+}
+
+TEST(Replicaset_status, query_batch_split) {
+  using mysqlshdk::db::Type;
+
+  auto session = std::make_shared<testing::Mock_session>();
+
+  // statements are split by the SQL parser, not on every ';'
+  const std::vector<std::string> statements = {
+      "SELECT 1", "SELECT ';' AS `a;b`", "SELECT 3 /* ; */"};
+
+  for (const auto &stmt : statements) {
+    session->expect_query(stmt).then_return(
+        {{stmt, {"x"}, {Type::Integer}, {{"1"}}}});
+  }
+
+  const auto results =
+      detail::query_batch(session, shcore::str_join(statements, ";"));
+  ASSERT_EQ(3u, results.size());
+
+  for (const auto &result : results) {
+    ASSERT_NE(nullptr, result);
+    EXPECT_NE(nullptr, result->fetch_one());
+  }
+}
+
+TEST(Replicaset_status, run_for_each_member) {
+  std::atomic<int> running{0};
+  std::atomic<int> max_running{0};
+  std::vector<int> count(20, 0);
+
+  const auto errors =
+      detail::run_for_each_member(20, 4, [&](size_t i) {
+        int now = ++running;
+        int max = max_running;
+        while (now > max && !max_running.compare_exchange_weak(max, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        count[i]++;
+        --running;
+      });
+
+  // every call completes before it returns, with no more than the requested
+  // number of threads
+  EXPECT_EQ(std::vector<std::exception_ptr>(20), errors);
+  EXPECT_EQ(std::vector<int>(20, 1), count);
+  EXPECT_EQ(0, running);
+  EXPECT_GE(4, max_running);
+
+  EXPECT_TRUE(
+      detail::run_for_each_member(0, 4, [](size_t) { FAIL(); }).empty());
+}
+
+TEST(Replicaset_status, run_for_each_member_error) {
+  std::vector<int> count(3, 0);
+
+  const auto errors = detail::run_for_each_member(3, 3, [&count](size_t i) {
+    if (i == 1) throw std::runtime_error("x");
+    count[i]++;
+  });
+
+  // the error is reported for its index only, the other calls complete
+  ASSERT_EQ(3u, errors.size());
+  EXPECT_FALSE(errors[0]);
+  EXPECT_FALSE(errors[2]);
+  ASSERT_TRUE(errors[1]);
+  EXPECT_THROW(std::rethrow_exception(errors[1]), std::runtime_error);
+  EXPECT_EQ(std::vector<int>({1, 0, 1}), count);
+}
+
+}  // namespace dba
+}  // namespace mysqlsh
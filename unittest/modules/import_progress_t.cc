@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <string>
+
+#include "modules/util/import_progress.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "unittest/test_utils.h"
+
+namespace mysqlsh {
+
+class Import_progress_test : public Shell_core_test_wrapper {
+ protected:
+  void SetUp() override {
+    Shell_core_test_wrapper::SetUp();
+
+    m_input = shcore::path::join_path(getenv("TMPDIR"), "progress_input.json");
+    m_path = m_input + ".progress";
+    shcore::create_file(m_input, std::string(100, ' '));
+  }
+
+  void TearDown() override {
+    shcore::delete_file(m_input);
+    shcore::delete_file(m_path);
+
+    Shell_core_test_wrapper::TearDown();
+  }
+
+  std::string m_input;
+  std::string m_path;
+};
+
+TEST_F(Import_progress_test, resume) {
+  {
+    Import_progress progress{m_path, m_input};
+    EXPECT_TRUE(progress.ranges().empty());
+
+    progress.start({{0, 40}, {40, 100}});
+    EXPECT_TRUE(shcore::file_exists(m_path));
+
+    progress.committed(0, 10);
+    progress.committed(1, 70);
+    // offsets never move back
+    progress.committed(0, 5);
+    EXPECT_EQ(40, progress.committed_bytes());
+  }
+
+  Import_progress progress{m_path, m_input};
+  progress.load();
+
+  const auto ranges = progress.ranges();
+  ASSERT_EQ(2, ranges.size());
+  EXPECT_EQ(0, ranges[0].begin);
+  EXPECT_EQ(40, ranges[0].end);
+  EXPECT_EQ(10, ranges[0].committed);
+  EXPECT_EQ(40, ranges[1].begin);
+  EXPECT_EQ(100, ranges[1].end);
+  EXPECT_EQ(70, ranges[1].committed);
+
+  progress.remove();
+  EXPECT_FALSE(shcore::file_exists(m_path));
+}
+
+TEST_F(Import_progress_test, invalid) {
+  Import_progress missing{m_path, m_input};
+  EXPECT_THROW(missing.load(), std::runtime_error);
+
+  {
+    Import_progress progress{m_path, m_input};
+    progress.start({{0, 100}});
+  }
+
+  // input has changed since the progress was recorded
+  shcore::create_file(m_input, std::string(50, ' '));
+  Import_progress changed{m_path, m_input};
+  EXPECT_THROW(changed.load(), std::runtime_error);
+
+  shcore::create_file(m_path, "not json");
+  EXPECT_THROW(changed.load(), std::runtime_error);
+}
+
+TEST_F(Import_progress_test, not_required) {
+  const auto path = shcore::path::join_path(m_input, "progress");
+
+  Import_progress required{path, m_input};
+  EXPECT_THROW(required.start({{0, 100}}), std::runtime_error);
+
+  Import_progress optional{path, m_input, false};
+  EXPECT_NO_THROW(optional.start({{0, 100}}));
+  EXPECT_NO_THROW(optional.committed(0, 50));
+  EXPECT_FALSE(shcore::file_exists(path));
+  MY_EXPECT_STDOUT_CONTAINS("it cannot be resumed");
+}
+
+}  // namespace mysqlsh
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+
+#include "modules/util/table_exporter.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "unittest/test_utils.h"
+
+namespace mysqlsh {
+
+TEST(Table_exporter, append_field) {
+  const auto format = [](Table_exporter::Format format,
+                         const std::string &value) {
+    std::string out;
+    Table_exporter::append_field(format, value.data(), value.size(), &out);
+    return out;
+  };
+
+  using Format = Table_exporter::Format;
+
+  EXPECT_EQ("abc", format(Format::TSV, "abc"));
+  EXPECT_EQ("", format(Format::TSV, ""));
+  EXPECT_EQ("a\\tb\\nc\\\\d\\re", format(Format::TSV, "a\tb\nc\\d\re"));
+  EXPECT_EQ("\\0x", format(Format::TSV, std::string("\0x", 2)));
+
+  EXPECT_EQ("abc", format(Format::CSV, "abc"));
+  EXPECT_EQ("\"\"", format(Format::CSV, ""));
+  EXPECT_EQ("\"a,b\"", format(Format::CSV, "a,b"));
+  EXPECT_EQ("\"say \"\"hi\"\"\"", format(Format::CSV, "say \"hi\""));
+  EXPECT_EQ("\"a\nb\"", format(Format::CSV, "a\nb"));
+  EXPECT_EQ("a\\\\N", format(Format::CSV, "a\\N"));
+  EXPECT_EQ("\"a\\\\,\"\"\"", format(Format::CSV, "a\\,\""));
+  EXPECT_EQ("\\0x", format(Format::CSV, std::string("\0x", 2)));
+  EXPECT_EQ("\"NULL\"", format(Format::CSV, "NULL"));
+  EXPECT_EQ("\"null\"", format(Format::CSV, "null"));
+  EXPECT_EQ("NULLS", format(Format::CSV, "NULLS"));
+
+  EXPECT_EQ("\"abc\"", format(Format::NDJSON, "abc"));
+  EXPECT_EQ("\"a\\\"b\\\\c\\nd\\u0001\"",
+            format(Format::NDJSON, "a\"b\\c\nd\x01"));
+  EXPECT_EQ("\"\\u0000\"", format(Format::NDJSON, std::string(1, '\0')));
+
+  EXPECT_EQ(Format::CSV, Table_exporter::to_format("CSV"));
+  EXPECT_THROW(Table_exporter::to_format("xml"), std::invalid_argument);
+}
+
+TEST(Table_exporter, append_base64) {
+  const auto encode = [](const std::string &value) {
+    std::string out = "x";
+    Table_exporter::append_base64(value.data(), value.size(), &out);
+    return out;
+  };
+
+  // RFC 4648 test vectors
+  EXPECT_EQ("x", encode(""));
+  EXPECT_EQ("xZg==", encode("f"));
+  EXPECT_EQ("xZm8=", encode("fo"));
+  EXPECT_EQ("xZm9v", encode("foo"));
+  EXPECT_EQ("xZm9vYg==", encode("foob"));
+  EXPECT_EQ("xZm9vYmE=", encode("fooba"));
+  EXPECT_EQ("xZm9vYmFy", encode("foobar"));
+
+  EXPECT_EQ("xAP/+", encode(std::string("\x00\xff\xfe", 3)));
+}
+
+TEST(Table_exporter, encode_file_name) {
+  EXPECT_EQ("t_1-A", Table_exporter::encode_file_name("t_1-A"));
+  EXPECT_EQ("a%2Fb%5Cc", Table_exporter::encode_file_name("a/b\\c"));
+  EXPECT_EQ("%2E%2E", Table_exporter::encode_file_name(".."));
+  EXPECT_EQ("a%40b%25c%20d", Table_exporter::encode_file_name("a@b%c d"));
+  EXPECT_EQ("%3A%2A%3F%22%3C%3E%7C",
+            Table_exporter::encode_file_name(":*?\"<>|"));
+  EXPECT_EQ("\xc5\xbc\xc3\xb3\xc5\x82w",
+            Table_exporter::encode_file_name("\xc5\xbc\xc3\xb3\xc5\x82w"));
+}
+
+class Table_exporter_test : public Shell_core_test_wrapper {
+ protected:
+  void SetUp() override {
+    Shell_core_test_wrapper::SetUp();
+
+    m_session = mysqlshdk::db::mysql::Session::create();
+    m_session->connect(shcore::get_connection_options(_mysql_uri));
+
+    m_session->execute("DROP SCHEMA IF EXISTS table_exporter_test");
+    m_session->execute("CREATE SCHEMA table_exporter_test");
+    m_session->execute(
+        "CREATE TABLE table_exporter_test.t (id INT PRIMARY KEY, "
+        "name VARCHAR(20), value DOUBLE)");
+
+    std::string sql = "INSERT INTO table_exporter_test.t VALUES (0, NULL, 0)";
+    for (int i = 1; i < 1000; ++i) {
+      sql += ",(" + std::to_string(i) + ",'n\t" + std::to_string(i) + "'," +
+             std::to_string(i) + ".5)";
+    }
+    m_session->execute(sql);
+    m_session->execute("ANALYZE TABLE table_exporter_test.t");
+
+    m_output_dir = shcore::path::join_path(getenv("TMPDIR"), "table_export");
+  }
+
+  void TearDown() override {
+    m_session->execute("DROP SCHEMA IF EXISTS table_exporter_test");
+    m_session->close();
+
+    if (shcore::is_folder(m_output_dir))
+      shcore::remove_directory(m_output_dir);
+
+    Shell_core_test_wrapper::TearDown();
+  }
+
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_session;
+  std::string m_output_dir;
+};
+
+TEST_F(Table_exporter_test, export_chunks) {
+  Table_exporter exporter{m_session};
+  exporter.set_table("table_exporter_test", "t");
+  exporter.set_output_dir(m_output_dir);
+  exporter.set_threads(3);
+  exporter.set_chunk_rows(100);
+
+  ASSERT_NO_THROW(exporter.run());
+
+  // all rows are exported exactly once, in key order within a chunk
+  std::string all;
+  size_t files = 0;
+  for (; files < 100; ++files) {
+    const auto path =
+        shcore::path::join_path(m_output_dir, "t@" + std::to_string(files) +
+                                                  ".tsv");
+    if (!shcore::file_exists(path)) break;
+    all += shcore::get_text_file(path);
+  }
+
+  EXPECT_LT(1, files);
+
+  std::string expected = "0\t\\N\t0\n";
+  for (int i = 1; i < 1000; ++i) {
+    expected += std::to_string(i) + "\tn\\t" + std::to_string(i) + "\t" +
+                std::to_string(i) + ".5\n";
+  }
+  EXPECT_EQ(expected, all);
+
+  const auto manifest = shcore::Value::parse(shcore::get_text_file(
+      shcore::path::join_path(m_output_dir, "t.manifest.json")));
+  const auto map = manifest.as_map();
+  EXPECT_EQ("id", map->get_string("chunkKey"));
+  EXPECT_EQ(1000, map->get_int("rows"));
+  EXPECT_EQ(files, map->get_array("chunks")->size());
+  EXPECT_EQ(3, map->get_array("columns")->size());
+}
+
+TEST_F(Table_exporter_test, export_ndjson) {
+  Table_exporter exporter{m_session};
+  exporter.set_table("table_exporter_test", "t");
+  exporter.set_output_dir(m_output_dir);
+  exporter.set_format(Table_exporter::Format::NDJSON);
+  exporter.set_threads(1);
+
+  ASSERT_NO_THROW(exporter.run());
+
+  const auto data = shcore::get_text_file(
+      shcore::path::join_path(m_output_dir, "t@0.ndjson"));
+
+  EXPECT_EQ(0, data.find("{\"id\":0,\"name\":null,\"value\":0}\n"
+                         "{\"id\":1,\"name\":\"n\\t1\",\"value\":1.5}\n"));
+
+  EXPECT_THROW(
+      {
+        Table_exporter missing{m_session};
+        missing.set_table("table_exporter_test", "missing");
+        missing.set_output_dir(m_output_dir);
+        missing.run();
+      },
+      std::runtime_error);
+}
+
+}  // namespace mysqlsh
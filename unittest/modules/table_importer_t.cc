@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+
+#include <string>
+
+#include "modules/util/table_exporter.h"
+#include "modules/util/table_importer.h"
+#include "mysqlshdk/libs/db/mysql/session.h"
+#include "mysqlshdk/libs/utils/utils_file.h"
+#include "mysqlshdk/libs/utils/utils_general.h"
+#include "mysqlshdk/libs/utils/utils_path.h"
+#include "unittest/test_utils.h"
+
+namespace mysqlsh {
+
+TEST(Table_importer, split_on_lines) {
+  using Ranges = std::vector<std::pair<size_t, size_t>>;
+  const std::string data = "aaa\nbb\ncccc\nd";
+
+  EXPECT_EQ((Ranges{{0, 13}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 100));
+  EXPECT_EQ((Ranges{{0, 4}, {4, 7}, {7, 12}, {12, 13}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 1));
+  // chunk which ends right after a new line is not extended
+  EXPECT_EQ((Ranges{{0, 4}, {4, 12}, {12, 13}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 4));
+  EXPECT_EQ((Ranges{{0, 7}, {7, 13}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 6));
+  EXPECT_EQ(Ranges{}, Table_importer::split_on_lines(data.data(), 0, 10));
+}
+
+TEST(Table_importer, split_on_lines_escaped) {
+  using Ranges = std::vector<std::pair<size_t, size_t>>;
+  const std::string data = "a\\\nb\nc\\\\\nd";
+
+  // escaped new line characters do not terminate a line
+  EXPECT_EQ((Ranges{{0, 5}, {5, 9}, {9, 10}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 1));
+  EXPECT_EQ((Ranges{{0, 3}, {3, 5}, {5, 9}, {9, 10}}),
+            Table_importer::split_on_lines(data.data(), data.size(), 1, 0));
+}
+
+TEST(Table_importer, split_on_lines_quoted) {
+  using Ranges = std::vector<std::pair<size_t, size_t>>;
+  const auto split = [](const std::string &data, uint64_t bytes) {
+    return Table_importer::split_on_lines(data.data(), data.size(), bytes,
+                                          '\\', '"');
+  };
+
+  // new line characters in quoted fields do not terminate a line
+  EXPECT_EQ((Ranges{{0, 10}, {10, 12}}), split("\"a\nb\",\"\n\"\nc\n", 1));
+  // doubled and escaped quotes do not end the field
+  EXPECT_EQ((Ranges{{0, 11}, {11, 13}}), split("\"\"\"\n\\\"\n\",x\nd\n", 1));
+  // quotes which are not at the start of a field are part of the data
+  EXPECT_EQ((Ranges{{0, 4}, {4, 7}, {7, 8}}), split("a\"b\nc\"\n\"", 1));
+  // quote followed by other data does not end the field
+  EXPECT_EQ((Ranges{{0, 8}, {8, 10}}), split("\"a\"b\nc\"\nd\n", 1));
+  EXPECT_EQ((Ranges{{0, 10}, {10, 12}}), split("\"a\nb\",\"\n\"\nc\n", 8));
+  EXPECT_EQ((Ranges{{0, 12}}), split("\"a\nb\",\"\n\"\nc\n", 11));
+}
+
+class Table_importer_test : public Shell_core_test_wrapper {
+ protected:
+  void SetUp() override {
+    Shell_core_test_wrapper::SetUp();
+
+    m_session = mysqlshdk::db::mysql::Session::create();
+    m_session->connect(shcore::get_connection_options(_mysql_uri));
+
+    m_local_infile =
+        m_session->query("SELECT @@GLOBAL.local_infile")->fetch_one()->get_int(
+            0);
+    m_session->execute("SET GLOBAL local_infile = 1");
+
+    m_session->execute("DROP SCHEMA IF EXISTS table_importer_test");
+    m_session->execute("CREATE SCHEMA table_importer_test");
+    m_session->execute(
+        "CREATE TABLE table_importer_test.t (id INT PRIMARY KEY, "
+        "name VARCHAR(20), value DOUBLE)");
+    m_session->execute(
+        "CREATE TABLE table_importer_test.copy LIKE table_importer_test.t");
+
+    // values contain the separators, quotes and escape characters of both
+    // formats, as well as strings which look like NULL
+    std::string sql =
+        "INSERT INTO table_importer_test.t VALUES (0, NULL, 0), "
+        "(1, '', 1), (2, 'NULL', 2), (3, '\\\\N', 3)";
+    for (int i = 4; i < 1000; ++i) {
+      sql += ",(" + std::to_string(i) + ",'n\t\n,\"\\\\" + std::to_string(i) +
+             "'," + std::to_string(i) + ".5)";
+    }
+    m_session->execute(sql);
+
+    m_output_dir = shcore::path::join_path(getenv("TMPDIR"), "table_import");
+  }
+
+  void TearDown() override {
+    m_session->execute("DROP SCHEMA IF EXISTS table_importer_test");
+    m_session->execute("SET GLOBAL local_infile = " +
+                       std::to_string(m_local_infile));
+    m_session->close();
+
+    if (shcore::is_folder(m_output_dir))
+      shcore::remove_directory(m_output_dir);
+
+    Shell_core_test_wrapper::TearDown();
+  }
+
+  std::string checksum(const std::string &table) {
+    return m_session
+        ->query("CHECKSUM TABLE table_importer_test." + table)
+        ->fetch_one()
+        ->get_as_string(1);
+  }
+
+  std::shared_ptr<mysqlshdk::db::mysql::Session> m_session;
+  std::string m_output_dir;
+  int64_t m_local_infile = 0;
+};
+
+TEST_F(Table_importer_test, import_exported_table) {
+  for (const auto format :
+       {Table_exporter::Format::TSV, Table_exporter::Format::CSV}) {
+    SCOPED_TRACE(Table_exporter::extension(format));
+
+    m_session->execute("TRUNCATE TABLE table_importer_test.copy");
+
+    Table_exporter exporter{m_session};
+    exporter.set_table("table_importer_test", "t");
+    exporter.set_output_dir(m_output_dir);
+    exporter.set_format(format);
+    exporter.set_threads(1);
+    ASSERT_NO_THROW(exporter.run());
+
+    Table_importer importer{m_session};
+    importer.set_file(shcore::path::join_path(
+        m_output_dir, std::string("t@0.") + Table_exporter::extension(format)));
+    importer.set_table("table_importer_test", "copy");
+    importer.set_format(format);
+    importer.set_threads(3);
+    // small chunks, so the file is loaded by all the threads
+    importer.set_bytes_per_chunk(1000);
+    ASSERT_NO_THROW(importer.run());
+
+    EXPECT_EQ(1000, m_session->query("SELECT COUNT(*) FROM "
+                                     "table_importer_test.copy")
+                        ->fetch_one()
+                        ->get_int(0));
+
+    EXPECT_EQ(checksum("t"), checksum("copy"));
+  }
+}
+
+TEST_F(Table_importer_test, local_infile_disabled) {
+  m_session->execute("SET GLOBAL local_infile = 0");
+
+  Table_importer importer{m_session};
+  importer.set_file(shcore::path::join_path(m_output_dir, "t.tsv"));
+  importer.set_table("table_importer_test", "copy");
+
+  EXPECT_THROW(importer.run(), std::runtime_error);
+}
+
+}  // namespace mysqlsh
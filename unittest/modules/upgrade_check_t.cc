@@ -21,6 +21,8 @@
  * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+#include <algorithm>
+
 #include "modules/util/mod_util.h"
 #include "modules/util/upgrade_check.h"
 #include "mysqlshdk/libs/db/mysql/session.h"
@@ -679,6 +681,66 @@ TEST_F(MySQL_upgrade_check_test, check_table_command) {
   EXPECT_TRUE(issues.size() == 1 && issues[0].table == "part");
 }
 
+TEST_F(MySQL_upgrade_check_test, parallel_check_runner) {
+  if (_target_server_version < Version(5, 7, 0) ||
+      _target_server_version >= Version(8, 0, 0))
+    SKIP_TEST("This test requires running against MySQL server version 5.7");
+  PrepareTestDatabase("mysql_parallel_check_test");
+  ASSERT_NO_THROW(
+      session->execute("create table part(i integer) engine=myisam partition "
+                       "by range(i) (partition p0 values less than (1000), "
+                       "partition p1 values less than MAXVALUE);"));
+  ASSERT_NO_THROW(session->execute("create table Clone(COMPONENT integer);"));
+
+  Check_table_command check;
+  auto schemas = check.list_tables(session);
+  auto schema = std::find_if(
+      schemas.begin(), schemas.end(),
+      [](const Check_table_command::Table_list &tables) {
+        return tables.front().first == "mysql_parallel_check_test";
+      });
+  ASSERT_NE(schemas.end(), schema);
+  EXPECT_EQ(2, schema->size());
+
+  auto checklist = Upgrade_check::create_checklist(
+      _target_server_version.get_base(), "8.0.11");
+
+  auto first = mysqlshdk::db::mysql::Session::create();
+  first->connect(shcore::get_connection_options(_mysql_uri));
+  auto second = mysqlshdk::db::mysql::Session::create();
+  second->connect(shcore::get_connection_options(_mysql_uri));
+
+  Parallel_check_runner runner(checklist, {first, second},
+                               _target_server_version.get_base());
+
+  // results are the same as when the checks are run one after another
+  for (size_t i = 0; i < checklist.size(); ++i) {
+    if (!checklist[i]->is_runnable()) continue;
+    SCOPED_TRACE(checklist[i]->get_name());
+
+    std::vector<Upgrade_issue> expected;
+    std::string expected_error;
+    try {
+      expected = checklist[i]->run(session, _target_server_version.get_base());
+    } catch (const std::exception &e) {
+      expected_error = e.what();
+    }
+
+    try {
+      auto issues = runner.get_issues(i);
+      EXPECT_TRUE(expected_error.empty());
+      ASSERT_EQ(expected.size(), issues.size());
+      for (size_t j = 0; j < issues.size(); ++j)
+        EXPECT_EQ(to_string(expected[j]), to_string(issues[j]));
+    } catch (const std::exception &e) {
+      EXPECT_EQ(expected_error, e.what());
+    }
+  }
+
+  first->close();
+  second->close();
+}
+
 TEST_F(MySQL_upgrade_check_test, manual_checks) {
   auto manual = Upgrade_check::create_checklist("5.7", "8.0.11");
   manual.erase(std::remove_if(manual.begin(), manual.end(),
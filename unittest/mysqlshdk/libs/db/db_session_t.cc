@@ -224,5 +224,77 @@ TEST_F(Db_tests, auto_close) {
   } while (switch_proto());
 }
 
+TEST_F(Db_tests, execute_batch_resultsets) {
+  auto classic = mysqlshdk::db::mysql::Session::create();
+  ASSERT_NO_THROW(classic->connect(Connection_options(uri())));
+
+  const std::string sql = "select 1, 'a' union select 2, 'b';do 1;select 3";
+  std::vector<std::shared_ptr<IResult>> results;
+
+  // data is discarded by default
+  ASSERT_NO_THROW(classic->execute_batch(sql.data(), sql.size(), &results));
+  ASSERT_EQ(3u, results.size());
+  EXPECT_EQ(nullptr, results[0]->fetch_one());
+
+  results.clear();
+  ASSERT_NO_THROW(
+      classic->execute_batch(sql.data(), sql.size(), &results, true));
+  ASSERT_EQ(3u, results.size());
+
+  // rows of all the statements can be read once the batch completes
+  EXPECT_EQ(3, results[2]->fetch_one()->get_int(0));
+  EXPECT_EQ(nullptr, results[2]->fetch_one());
+
+  EXPECT_FALSE(results[1]->has_resultset());
+
+  auto row = results[0]->fetch_one_named();
+  EXPECT_EQ(1, row.get_int("1"));
+  EXPECT_EQ("a", row.get_string("a"));
+  EXPECT_EQ(2, results[0]->fetch_one()->get_int(0));
+  EXPECT_EQ(nullptr, results[0]->fetch_one());
+
+  // the session can be used normally afterwards
+  EXPECT_EQ(4, classic->query("select 4")->fetch_one()->get_int(0));
+  EXPECT_THROW(classic->query("select 5;select 6"), std::exception);
+
+  classic->close();
+}
+
+TEST_F(Db_tests, execute_batch_multi_statements) {
+  auto classic = mysqlshdk::db::mysql::Session::create();
+  ASSERT_NO_THROW(classic->connect(Connection_options(uri())));
+
+  // COM_SET_OPTION is accounted as Com_set_option by the server
+  auto set_option_count = [&classic]() {
+    return std::stoull(
+        classic->query("SHOW SESSION STATUS LIKE 'Com_set_option'")
+            ->fetch_one()
+            ->get_string(1));
+  };
+
+  const std::string sql = "do 1;do 2";
+  std::vector<std::shared_ptr<IResult>> results;
+  const uint64_t before = set_option_count();
+
+  // multiple statements are enabled and disabled again by every batch
+  for (int i = 0; i < 3; i++) {
+    ASSERT_NO_THROW(classic->execute_batch(sql.data(), sql.size(), &results));
+    EXPECT_THROW(classic->query("select 1;select 2"), std::exception);
+  }
+  EXPECT_EQ(6u, results.size());
+  EXPECT_EQ(before + 6, set_option_count());
+
+  // also when the batch fails
+  const std::string failing = "do 1;select * from no_such_table;do 2";
+  results.clear();
+  EXPECT_THROW(
+      classic->execute_batch(failing.data(), failing.size(), &results),
+      mysqlshdk::db::Error);
+  EXPECT_EQ(1u, results.size());
+  EXPECT_THROW(classic->query("select 1;select 2"), std::exception);
+
+  classic->close();
+}
+
 }  // namespace db
 }  // namespace mysqlshdk
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/libs/db/mutable_result.h"
+#include "mysqlshdk/libs/db/row_copy.h"
+#include "unittest/gtest_clean.h"
+
+namespace mysqlshdk {
+namespace db {
+
+TEST(Row_batch, append) {
+  std::vector<Type> types{Type::Integer, Type::UInteger, Type::Double,
+                          Type::String,  Type::Decimal,  Type::Date};
+  Row_batch batch(types);
+
+  batch.append(Mutable_row(types, -5, 7u, 2.5, "text", "12.50", "2018-01-01"));
+  batch.append(Mutable_row(types, 1, nullptr, nullptr, std::string(), nullptr,
+                           nullptr));
+
+  ASSERT_EQ(2, batch.size());
+
+  const IRow *row = batch.at(0);
+  EXPECT_EQ(6, row->num_fields());
+  EXPECT_EQ(Type::Double, row->get_type(2));
+  EXPECT_EQ(-5, row->get_int(0));
+  EXPECT_EQ(7, row->get_uint(1));
+  EXPECT_EQ(7, row->get_int(1));
+  EXPECT_DOUBLE_EQ(2.5, row->get_double(2));
+  EXPECT_EQ("text", row->get_string(3));
+  EXPECT_EQ("12.50", row->get_as_string(4));
+  EXPECT_DOUBLE_EQ(12.5, row->get_double(4));
+  EXPECT_EQ("2018-01-01", row->get_string(5));
+  EXPECT_THROW(row->get_uint(0), std::invalid_argument);
+  EXPECT_THROW(row->get_string(0), std::invalid_argument);
+  EXPECT_THROW(row->get_int(6), std::invalid_argument);
+
+  auto data = row->get_string_data(3);
+  EXPECT_EQ("text", std::string(data.first, data.second));
+
+  row = batch.at(1);
+  EXPECT_FALSE(row->is_null(0));
+  EXPECT_TRUE(row->is_null(1));
+  EXPECT_TRUE(row->is_null(2));
+  EXPECT_FALSE(row->is_null(3));
+  EXPECT_EQ("", row->get_string(3));
+  EXPECT_EQ("NULL", row->get_as_string(4));
+  EXPECT_THROW(row->get_string(5), std::invalid_argument);
+
+  EXPECT_THROW(batch.append(Mutable_row({Type::Integer}, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(batch.append(Mutable_row({Type::String, Type::UInteger,
+                                         Type::Double, Type::String,
+                                         Type::Decimal, Type::Date},
+                                        "1", 7u, 2.5, "", "1", "")),
+               std::invalid_argument);
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(Row_batch, big_rows) {
+  std::vector<Type> types{Type::Integer, Type::Bytes};
+  Row_batch batch(types);
+
+  std::string big(100000, 'x');
+  big[10] = '\0';
+
+  for (int i = 0; i < 1000; i++) {
+    batch.append(Mutable_row(types, i, i % 100 ? std::string(i, 'y') : big));
+  }
+
+  for (int i = 0; i < 1000; i++) {
+    const IRow *row = batch.at(i);
+    EXPECT_EQ(i, row->get_int(0));
+    auto data = row->get_string_data(1);
+    EXPECT_EQ(i % 100 ? std::string(i, 'y') : big,
+              std::string(data.first, data.second));
+  }
+}
+
+TEST(Row_batch, spill) {
+  std::vector<Type> types{Type::Integer, Type::String, Type::Double};
+  Row_batch batch(types);
+  batch.set_memory_limit(256 * 1024);
+
+  const auto text = [](int i) { return std::string(i % 500, 'a' + i % 26); };
+
+  for (int i = 0; i < 5000; i++) {
+    if (i % 7)
+      batch.append(Mutable_row(types, i, text(i), i / 2.0));
+    else
+      batch.append(Mutable_row(types, i, nullptr, nullptr));
+  }
+
+  ASSERT_EQ(5000, batch.size());
+  EXPECT_LT(0, batch.spilled());
+  EXPECT_GT(5000, batch.spilled());
+
+  const auto check = [&](int i) {
+    SCOPED_TRACE(i);
+    const IRow *row = batch.at(i);
+    ASSERT_NE(nullptr, row);
+    EXPECT_EQ(3, row->num_fields());
+    EXPECT_EQ(i, row->get_int(0));
+    if (i % 7) {
+      EXPECT_EQ(text(i), row->get_string(1));
+      EXPECT_DOUBLE_EQ(i / 2.0, row->get_double(2));
+    } else {
+      EXPECT_TRUE(row->is_null(1));
+      EXPECT_TRUE(row->is_null(2));
+    }
+  };
+
+  // sequential reads, twice as done by a rewound result
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < 5000; i++) check(i);
+  }
+
+  // random access, repeated access to the same row
+  for (int i : {4000, 10, 10, 4999, 0, 2500}) check(i);
+
+  // rows can still be added once the previous ones were read
+  batch.append(Mutable_row(types, 5000, "last", 1.0));
+  ASSERT_EQ(5001, batch.size());
+  check(0);
+  EXPECT_EQ("last", batch.at(5000)->get_string(1));
+  check(4999);
+
+  batch.add_field(Type::Integer, 0);
+  ASSERT_EQ(5001, batch.size());
+  for (int i = 0; i < 5001; i += 1000) {
+    const IRow *row = batch.at(i);
+    EXPECT_EQ(4, row->num_fields());
+    EXPECT_TRUE(row->is_null(0));
+    EXPECT_EQ(i, row->get_int(1));
+  }
+
+  batch.clear();
+  EXPECT_TRUE(batch.empty());
+  EXPECT_EQ(0, batch.spilled());
+  EXPECT_EQ(256 * 1024, batch.memory_limit());
+}
+
+TEST(Row_batch, add_field) {
+  std::vector<Type> types{Type::Integer, Type::String};
+  Row_batch batch(types);
+
+  batch.append(Mutable_row(types, 1, "one"));
+  batch.append(Mutable_row(types, 2, "two"));
+
+  batch.add_field(Type::Double, 1);
+  batch.add_field(Type::Integer, 3);
+  EXPECT_THROW(batch.add_field(Type::Integer, 5), std::invalid_argument);
+
+  ASSERT_EQ(4, batch.types().size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    const IRow *row = batch.at(i);
+    EXPECT_EQ(4, row->num_fields());
+    EXPECT_EQ(static_cast<int64_t>(i + 1), row->get_int(0));
+    EXPECT_EQ(Type::Double, row->get_type(1));
+    EXPECT_TRUE(row->is_null(1));
+    EXPECT_EQ(i ? "two" : "one", row->get_string(2));
+    EXPECT_TRUE(row->is_null(3));
+  }
+}
+
+TEST(Row_batch, mutable_result) {
+  Mutable_result result({Type::Integer, Type::String});
+
+  result.append(1, "one");
+  result.append(2, "two");
+  result.add_column(Mutable_result::make_column("extra", Type::Double), 0);
+
+  auto row = result.fetch_one();
+  ASSERT_NE(nullptr, row);
+  EXPECT_TRUE(row->is_null(0));
+  EXPECT_EQ(1, row->get_int(1));
+  EXPECT_EQ("one", row->get_string(2));
+
+  row = result.fetch_one();
+  ASSERT_NE(nullptr, row);
+  EXPECT_EQ(2, row->get_int(1));
+  EXPECT_EQ("two", row->get_string(2));
+  EXPECT_EQ(nullptr, result.fetch_one());
+
+  result.reset();
+  Mutable_result copy(&result);
+  result.reset();
+  EXPECT_TRUE(copy == result);
+}
+
+}  // namespace db
+}  // namespace mysqlshdk
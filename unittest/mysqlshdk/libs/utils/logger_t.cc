@@ -24,6 +24,8 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "unittest/gtest_clean.h"
 #include "unittest/test_utils/mocks/gmock_clean.h"
@@ -69,6 +71,8 @@ class Logger_test : public ::testing::Test {
 
   static bool get_log_file_contents(const char *filename,
                                     std::string *contents) {
+    // entries are written by a background thread
+    Logger::flush();
     return shcore::load_text_file(get_log_file(filename), *contents);
   }
 
@@ -280,6 +284,89 @@ TEST_F(Logger_test, log_exception_format) {
   EXPECT_TRUE(is_timestamp(lines[1].c_str()));
 }
 
+TEST_F(Logger_test, log_from_multiple_threads) {
+  Logger::setup_instance(get_log_file("mylog.txt").c_str(), false,
+                         Logger::LOG_INFO);
+
+  const auto l = Logger::singleton();
+  const auto dropped = l->dropped_entries();
+  constexpr int k_threads = 4;
+  constexpr int k_entries = 1000;
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < k_threads; ++i) {
+    threads.emplace_back([l, i]() {
+      for (int j = 0; j < k_entries; ++j) {
+        l->log(Logger::LOG_INFO, "Unit Test Domain", "Thread %d entry %d", i,
+               j);
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // an error is written before the call returns, together with all the
+  // entries queued before it
+  l->log(Logger::LOG_ERROR, "Unit Test Domain", "Last entry");
+
+  std::string contents;
+  EXPECT_TRUE(shcore::load_text_file(get_log_file("mylog.txt"), contents));
+
+  auto lines = shcore::str_split(contents, "\n", -1, true);
+  if (!lines.empty() && lines.back().empty()) lines.pop_back();
+  const uint64_t lost = l->dropped_entries() - dropped;
+
+  ASSERT_FALSE(lines.empty());
+  EXPECT_EQ(": Error: Unit Test Domain: Last entry",
+            lines.back().substr(19));
+
+  if (lost == 0) {
+    EXPECT_EQ(static_cast<size_t>(k_threads * k_entries + 1), lines.size());
+  } else {
+    EXPECT_THAT(contents, ::testing::HasSubstr(std::to_string(lost) +
+                                               " log entries were dropped"));
+  }
+
+  for (int i = 0; i < k_threads; ++i) {
+    const auto prefix = "Thread " + std::to_string(i) + " entry ";
+    int expected = 0;
+
+    // entries of a single thread are written in order
+    for (const auto &line : lines) {
+      const auto pos = line.find(prefix);
+      if (std::string::npos == pos) continue;
+      const int entry = std::stoi(line.substr(pos + prefix.length()));
+      EXPECT_LE(expected, entry);
+      expected = entry + 1;
+    }
+  }
+}
+
+TEST_F(Logger_test, flush_on_crash) {
+  Logger::setup_instance(get_log_file("mylog.txt").c_str(), false,
+                         Logger::LOG_INFO);
+
+  const auto l = Logger::singleton();
+
+  for (int i = 0; i < 10; ++i) {
+    l->log(Logger::LOG_INFO, "Unit Test Domain", "Queued entry %d", i);
+  }
+
+  // entries are written without waiting for the writer thread
+  Logger::flush_on_crash();
+
+  std::string contents;
+  EXPECT_TRUE(shcore::load_text_file(get_log_file("mylog.txt"), contents));
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_THAT(contents, ::testing::HasSubstr("Info: Unit Test Domain: "
+                                               "Queued entry " +
+                                               std::to_string(i) + "\n"));
+  }
+}
+
 #ifndef _WIN32
 // on Windows Logger is using OutputDebugString() instead of stderr
 
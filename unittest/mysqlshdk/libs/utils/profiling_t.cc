@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mysqlshdk/libs/utils/profiling.h"
+#include "mysqlshdk/libs/utils/utils_string.h"
+#include "unittest/gtest_clean.h"
+
+namespace mysqlshdk {
+namespace utils {
+
+namespace {
+
+// each line of the stage tree ends with three columns of 15 characters
+constexpr size_t k_columns_width = 45;
+
+/**
+ * Names of the stages, indented by their depth, followed by the number of
+ * calls.
+ */
+std::vector<std::string> stage_lines() {
+  std::vector<std::string> result;
+  const auto lines = shcore::str_split(Profiler::stage_tree(), "\n");
+
+  // skips the header
+  for (size_t i = 1; i < lines.size(); ++i) {
+    const auto &line = lines[i];
+    if (line.length() < k_columns_width) continue;
+
+    const auto split = line.length() - k_columns_width;
+    auto name = line.substr(0, split);
+    name.erase(name.find_last_not_of(' ') + 1);
+
+    result.push_back(name + " " +
+                     std::to_string(std::stoull(line.substr(split, 15))));
+  }
+
+  return result;
+}
+
+}  // namespace
+
+TEST(Profiler, not_running) {
+  Profiler::stop();
+  Profiler::reset();
+
+  stage_begin("stage");
+  stage_end();
+  { Profile_stage stage("guard"); }
+
+  EXPECT_EQ("", Profiler::stage_tree());
+}
+
+TEST(Profiler, nested_stages) {
+  Profiler::start();
+
+  {
+    Profile_stage outer("outer");
+
+    for (int i = 0; i < 3; ++i) {
+      Profile_stage inner("inner");
+    }
+
+    stage_begin("other");
+    stage_end();
+  }
+
+  stage_begin("unfinished");
+
+  Profiler::stop();
+  // stage which was started while the profiler was running is still open
+  stage_end();
+
+  const auto tree = Profiler::stage_tree();
+  EXPECT_EQ(0, tree.find("Stage "));
+  EXPECT_NE(std::string::npos, tree.find("Calls"));
+
+  const std::vector<std::string> expected = {"outer 1", "  inner 3",
+                                             "  other 1", "unfinished 1"};
+  EXPECT_EQ(expected, stage_lines());
+
+  Profiler::reset();
+  EXPECT_EQ("", Profiler::stage_tree());
+}
+
+TEST(Profiler, threads) {
+  Profiler::start();
+
+  {
+    Profile_stage stage("main");
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([]() {
+        Profile_stage worker("worker");
+        Profile_stage step("step");
+      });
+    }
+
+    for (auto &thread : threads) thread.join();
+  }
+
+  Profiler::stop();
+
+  // stages of the threads start at the top level
+  const std::vector<std::string> expected = {"main 1", "worker 4",
+                                             "  step 4"};
+  EXPECT_EQ(expected, stage_lines());
+
+  const auto trace = Profiler::chrome_trace();
+  EXPECT_EQ(0, trace.find("{\"traceEvents\":["));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"main\",\"ph\":\"X\""));
+
+  size_t workers = 0;
+  for (size_t pos = trace.find("\"worker\""); pos != std::string::npos;
+       pos = trace.find("\"worker\"", pos + 1)) {
+    ++workers;
+  }
+  EXPECT_EQ(4, workers);
+
+  // threads which finished are discarded on reset
+  Profiler::reset();
+  EXPECT_EQ("{\"traceEvents\":[\n\n],\n\"displayTimeUnit\":\"ms\"}\n",
+            Profiler::chrome_trace());
+}
+
+TEST(Profiler, chrome_trace_escapes_names) {
+  Profiler::start();
+  { Profile_stage stage("say \"hi\"\\"); }
+  Profiler::stop();
+
+  EXPECT_NE(std::string::npos,
+            Profiler::chrome_trace().find("\"name\":\"say \\\"hi\\\"\\\\\""));
+
+  Profiler::reset();
+}
+
+}  // namespace utils
+}  // namespace mysqlshdk
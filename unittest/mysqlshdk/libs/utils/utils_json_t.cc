@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <string>
+
+#include "mysqlshdk/libs/utils/utils_json.h"
+#include "unittest/gtest_clean.h"
+
+namespace shcore {
+
+TEST(Utils_json, flush) {
+  for (const bool pprint : {false, true}) {
+    JSON_dumper whole(pprint);
+    JSON_dumper parts(pprint);
+    std::string output;
+
+    for (auto dumper : {&whole, &parts}) {
+      dumper->start_object();
+      dumper->append_string("rows");
+      dumper->start_array();
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+      for (auto dumper : {&whole, &parts}) {
+        dumper->start_object();
+        dumper->append_string("id");
+        dumper->append_int(i);
+        dumper->append_string("name", "row \"" + std::to_string(i) + "\"");
+        dumper->append_string("value");
+        dumper->append_float(i / 4.0);
+        dumper->end_object();
+      }
+
+      if (i % 100 == 0) {
+        EXPECT_LT(0u, parts.size());
+        output += parts.flush();
+        EXPECT_EQ(0u, parts.size());
+      }
+    }
+
+    for (auto dumper : {&whole, &parts}) {
+      dumper->end_array();
+      dumper->end_object();
+    }
+
+    output += parts.flush();
+
+    EXPECT_EQ(whole.str(), output);
+    EXPECT_EQ("", parts.str());
+  }
+}
+
+}  // namespace shcore
@@ -22,6 +22,7 @@
 #include <bitset>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <stack>
 #include <string>
@@ -541,4 +542,116 @@ TEST(UtilsString, unquote_string) {
   }
 }
 
+TEST(UtilsString, str_find_first_of) {
+  const auto find = [](const std::string &s, const char *chars) {
+    return static_cast<size_t>(
+        str_find_first_of(s.data(), s.data() + s.size(), chars) - s.data());
+  };
+
+  EXPECT_EQ(0u, find("", "\""));
+  EXPECT_EQ(3u, find("abc", "\""));
+  EXPECT_EQ(0u, find("\"abc", "\""));
+  EXPECT_EQ(3u, find("abc\\\"", "\"\\"));
+  EXPECT_EQ(3u, find("abc\"\\", "\"\\"));
+
+  // matches found in vectorized part, in the tail and past the first block
+  for (const size_t length : {15, 16, 17, 31, 32, 33, 100}) {
+    for (size_t position = 0; position < length; ++position) {
+      std::string s(length, 'x');
+      s[position] = '{';
+      EXPECT_EQ(position, find(s, "\"\\{}"));
+      EXPECT_EQ(length, find(s, "\"\\"));
+    }
+  }
+
+  // first of many matches is returned
+  EXPECT_EQ(20u, find(std::string(20, 'a') + "}}{{\"\\", "{}\"\\"));
+}
+
+TEST(UtilsString, str_to_int64) {
+  const auto convert = [](const std::string &s, int64_t *out) {
+    return str_to_int64(s.data(), s.data() + s.size(), out);
+  };
+
+  int64_t value = 0;
+
+  EXPECT_TRUE(convert("0", &value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(convert("-1234", &value));
+  EXPECT_EQ(-1234, value);
+  EXPECT_TRUE(convert("+42", &value));
+  EXPECT_EQ(42, value);
+  EXPECT_TRUE(convert("9223372036854775807", &value));
+  EXPECT_EQ(INT64_MAX, value);
+  EXPECT_TRUE(convert("-9223372036854775808", &value));
+  EXPECT_EQ(INT64_MIN, value);
+
+  EXPECT_FALSE(convert("", &value));
+  EXPECT_FALSE(convert("-", &value));
+  EXPECT_FALSE(convert("12a", &value));
+  EXPECT_FALSE(convert(" 12", &value));
+  EXPECT_FALSE(convert("1.5", &value));
+  EXPECT_FALSE(convert("9223372036854775808", &value));
+  EXPECT_FALSE(convert("-9223372036854775809", &value));
+
+  uint64_t uvalue = 0;
+  const std::string max = "18446744073709551615";
+
+  EXPECT_TRUE(str_to_uint64(max.data(), max.data() + max.size(), &uvalue));
+  EXPECT_EQ(UINT64_MAX, uvalue);
+
+  const std::string overflow = "18446744073709551616";
+  EXPECT_FALSE(str_to_uint64(overflow.data(),
+                             overflow.data() + overflow.size(), &uvalue));
+
+  const std::string negative = "-1";
+  EXPECT_FALSE(str_to_uint64(negative.data(),
+                             negative.data() + negative.size(), &uvalue));
+}
+
+TEST(UtilsString, str_to_double) {
+  const auto convert = [](const std::string &s, double *out) {
+    return str_to_double(s.data(), s.data() + s.size(), out);
+  };
+
+  double value = 0;
+
+  // results have to be the same as the ones from strtod()
+  for (const auto &s :
+       {"0", "-0", "1", "-1", "0.1", "3.14159", "-2.5", "1e10", "1.5E-3",
+        "123456789012345", "0.000001", ".5", "5.", "1e22", "-7.25e+2",
+        "9007199254740992", "0.3", "2.5e-20"}) {
+    SCOPED_TRACE(s);
+    ASSERT_TRUE(convert(s, &value));
+    EXPECT_EQ(strtod(s, nullptr), value);
+  }
+
+  // cannot be converted exactly
+  EXPECT_FALSE(convert("1e23", &value));
+  EXPECT_FALSE(convert("1e-23", &value));
+  EXPECT_FALSE(convert("9007199254740993", &value));
+  EXPECT_FALSE(convert("12345678901234567890", &value));
+
+  // invalid
+  EXPECT_FALSE(convert("", &value));
+  EXPECT_FALSE(convert("-", &value));
+  EXPECT_FALSE(convert(".", &value));
+  EXPECT_FALSE(convert("1..2", &value));
+  EXPECT_FALSE(convert("1e", &value));
+  EXPECT_FALSE(convert("e5", &value));
+  EXPECT_FALSE(convert("1.5x", &value));
+  EXPECT_FALSE(convert("nan", &value));
+
+  float fvalue = 0;
+
+  for (const auto &s : {"0", "1.5", "-3.25", "0.1", "16777216", "1e10"}) {
+    SCOPED_TRACE(s);
+    ASSERT_TRUE(str_to_float(s, s + strlen(s), &fvalue));
+    EXPECT_EQ(strtof(s, nullptr), fvalue);
+  }
+
+  const std::string big = "16777217";
+  EXPECT_FALSE(str_to_float(big.data(), big.data() + big.size(), &fvalue));
+}
+
 }  // namespace shcore
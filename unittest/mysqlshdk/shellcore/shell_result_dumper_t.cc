@@ -22,7 +22,14 @@
  */
 
 #include <gtest_clean.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "mysqlshdk/include/shellcore/shell_resultset_dumper.h"
+#include "mysqlshdk/libs/db/mutable_result.h"
+#include "mysqlshdk/shellcore/shell_console.h"
 
 using Print_flags = mysqlsh::Print_flags;
 using Print_flag = mysqlsh::Print_flag;
@@ -67,3 +74,122 @@ TEST(Resultset_dumper, get_data_sizes) {
   // Multibyte character 3 bytes represented in 2 spaces
   TEST_DATA_SIZES("I 爱 MySQL Shell\0", 17, Print_flags(), 16, 17);
 }
+
+namespace {
+
+using mysqlshdk::db::Column;
+using mysqlshdk::db::Mutable_result;
+using mysqlshdk::db::Mutable_row;
+using mysqlshdk::db::Type;
+
+void append_output(void *user_data, const char *text) {
+  static_cast<std::string *>(user_data)->append(text);
+}
+
+/**
+ * Prints the result in table format, streaming the rows as done in SQL mode.
+ */
+std::string dump_table(Mutable_result *result) {
+  std::string output;
+  shcore::Interpreter_delegate delegate;
+  delegate.user_data = &output;
+  delegate.print = &append_output;
+  delegate.print_diag = &append_output;
+  delegate.print_error = &append_output;
+
+  auto options = std::make_shared<mysqlsh::Shell_options>();
+  options->set(SHCORE_RESULT_FORMAT, "table");
+
+  mysqlsh::Scoped_shell_options scoped_options(options);
+  mysqlsh::Scoped_console scoped_console(
+      std::make_shared<mysqlsh::Shell_console>(&delegate));
+
+  mysqlsh::Resultset_dumper dumper(result, false);
+  dumper.dump("row", true, false);
+
+  return output;
+}
+
+Column zerofill_column(const std::string &name, uint32_t length) {
+  return Column("", "", "", "", name, name, length, 0, Type::UInteger, 0, true,
+                true, false);
+}
+
+void add_row(Mutable_result *result, const std::vector<Type> &types,
+             const std::vector<std::string> &values) {
+  std::unique_ptr<Mutable_row> row(new Mutable_row(types));
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (types[i] == Type::UInteger)
+      row->set_field(i, static_cast<uint64_t>(std::stoull(values[i])));
+    else
+      row->set_field(i, values[i]);
+  }
+  result->add_row(std::move(row));
+}
+
+}  // namespace
+
+TEST(Resultset_dumper, table_zerofill) {
+  const std::vector<Type> types{Type::UInteger, Type::String};
+  Mutable_result result(
+      std::vector<Column>{zerofill_column("id", 5),
+                          Mutable_result::make_column("name", Type::String)});
+
+  add_row(&result, types, {"42", "a"});
+  add_row(&result, types, {"123456", "b"});
+  add_row(&result, types, {"7", "c"});
+
+  EXPECT_EQ(
+      "+--------+------+\n"
+      "| id     | name |\n"
+      "+--------+------+\n"
+      "|  00042 | a    |\n"
+      "| 123456 | b    |\n"
+      "|  00007 | c    |\n"
+      "+--------+------+\n",
+      dump_table(&result));
+}
+
+TEST(Resultset_dumper, table_multibyte) {
+  const std::vector<Type> types{Type::String, Type::UInteger};
+  Mutable_result result(
+      std::vector<Column>{Mutable_result::make_column("name", Type::String),
+                          zerofill_column("n", 3)});
+
+  add_row(&result, types, {"I \xe2\x9d\xa4 MySQL", "1"});
+  add_row(&result, types, {"\xe7\x88\xb1", "22"});
+  add_row(&result, types, {"plain", "333"});
+
+  EXPECT_EQ(
+      "+-----------+-----+\n"
+      "| name      | n   |\n"
+      "+-----------+-----+\n"
+      "| I \xe2\x9d\xa4 MySQL | 001 |\n"
+      "| \xe7\x88\xb1        | 022 |\n"
+      "| plain     | 333 |\n"
+      "+-----------+-----+\n",
+      dump_table(&result));
+}
+
+TEST(Resultset_dumper, table_frozen_overflow) {
+  // the column width is calculated using a sample of the rows, data which
+  // does not fit into it is printed as is
+  const std::vector<Type> types{Type::String, Type::UInteger};
+  Mutable_result result(
+      std::vector<Column>{Mutable_result::make_column("name", Type::String),
+                          zerofill_column("n", 4)});
+
+  for (int i = 0; i < 1000; ++i) add_row(&result, types, {"abc", "1"});
+  add_row(&result, types, {"abcdef", "12"});
+  add_row(&result, types, {"\xe7\x88\xb1\xe7\x88\xb1", "123"});
+  add_row(&result, types, {"xyz", "123456"});
+
+  const std::string output = dump_table(&result);
+
+  EXPECT_NE(std::string::npos, output.find("| abc  | 0001 |\n"));
+  EXPECT_NE(std::string::npos, output.find("| abcdef | 0012 |\n"));
+  EXPECT_NE(std::string::npos,
+            output.find("| \xe7\x88\xb1\xe7\x88\xb1 | 0123 |\n"));
+  EXPECT_NE(std::string::npos, output.find("| xyz  | 123456 |\n"));
+  EXPECT_NE(std::string::npos, output.find("+------+------+\n", 1));
+}
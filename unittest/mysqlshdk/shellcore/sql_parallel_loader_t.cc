@@ -0,0 +1,584 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License, version 2.0,
+ * as published by the Free Software Foundation.
+ *
+ * This program is also distributed with certain software (including
+ * but not limited to OpenSSL) that is licensed under separate terms, as
+ * designated in a particular file or component or in included license
+ * documentation.  The authors of MySQL hereby grant you an additional
+ * permission to link the program and your derivative works with the
+ * separately licensed software that they have included with MySQL.
+ * This program is distributed in the hope that it will be useful,  but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See
+ * the GNU General Public License, version 2.0, for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mysqlshdk/shellcore/sql_parallel_loader.h"
+#include "unittest/gtest_clean.h"
+#include "unittest/test_utils/mocks/mysqlshdk/libs/db/mock_result.h"
+
+namespace shcore {
+
+using detail::Statement_type;
+using detail::classify;
+
+namespace {
+
+Statement_type type_of(const std::string &sql) {
+  return classify(sql.data(), sql.length()).type;
+}
+
+std::string table_of(const std::string &sql) {
+  const auto stmt = classify(sql.data(), sql.length());
+  return stmt.tables.empty() ? "" : stmt.tables[0];
+}
+
+/**
+ * Statements executed by the sessions of the loader, shared by all of them.
+ */
+struct Server {
+  std::mutex mutex;
+  std::condition_variable killed_cond;
+  uint64_t next_id = 1;
+  // connection id -> executed statements
+  std::map<uint64_t, std::vector<std::string>> executed;
+  std::set<uint64_t> killed;
+  std::set<std::string> failing;
+  bool foreign_key_checks = false;
+  // tables which have foreign keys or triggers
+  std::set<std::string> dependent;
+};
+
+/**
+ * Session which records the statements it executes. Statements containing
+ * SLEEP block until the query is killed.
+ */
+class Recording_session : public mysqlshdk::db::ISession {
+ public:
+  explicit Recording_session(Server *server) : m_server(server) {
+    std::lock_guard<std::mutex> lock(m_server->mutex);
+    m_id = m_server->next_id++;
+  }
+
+  void connect(const mysqlshdk::db::Connection_options &options) override {
+    m_options = options;
+  }
+
+  uint64_t get_connection_id() const override { return m_id; }
+
+  const mysqlshdk::db::Connection_options &get_connection_options()
+      const override {
+    return m_options;
+  }
+
+  const char *get_ssl_cipher() const override { return nullptr; }
+
+  mysqlshdk::utils::Version get_server_version() const override {
+    return mysqlshdk::utils::Version(8, 0, 13);
+  }
+
+  std::shared_ptr<mysqlshdk::db::IResult> querys(const char *sql, size_t len,
+                                                 bool) override {
+    const std::string query(sql, len);
+    std::shared_ptr<testing::Mock_result> result(new testing::Mock_result());
+    std::lock_guard<std::mutex> lock(m_server->mutex);
+
+    if (query.find("foreign_key_checks") != std::string::npos) {
+      result->add_result({"foreign_key_checks"},
+                         {mysqlshdk::db::Type::Integer},
+                         {{m_server->foreign_key_checks ? "1" : "0"}});
+    } else if (query.find("information_schema") != std::string::npos) {
+      int count = 0;
+      for (const auto &table : m_server->dependent) {
+        if (query.find("'" + table + "'") != std::string::npos) ++count;
+      }
+      result->add_result({"count"}, {mysqlshdk::db::Type::Integer},
+                         {{std::to_string(count)}});
+    } else {
+      result->add_result({"DATABASE()"}, {mysqlshdk::db::Type::String},
+                         {{"test"}});
+    }
+
+    return result;
+  }
+
+  void executes(const char *sql, size_t len) override {
+    const std::string stmt(sql, len);
+    std::unique_lock<std::mutex> lock(m_server->mutex);
+
+    m_server->executed[m_id].push_back(stmt);
+
+    if (stmt.compare(0, 11, "KILL QUERY ") == 0) {
+      m_server->killed.insert(std::stoull(stmt.substr(11)));
+      m_server->killed_cond.notify_all();
+    } else if (stmt.find("SLEEP") != std::string::npos) {
+      m_server->killed_cond.wait(
+          lock, [this]() { return m_server->killed.count(m_id) > 0; });
+      throw mysqlshdk::db::Error("Query execution was interrupted", 1317);
+    } else if (m_server->failing.count(stmt)) {
+      throw mysqlshdk::db::Error("Duplicate entry", 1062);
+    }
+  }
+
+  void close() override {}
+
+  bool is_open() const override { return true; }
+
+  const mysqlshdk::db::Error *get_last_error() const override {
+    return nullptr;
+  }
+
+ private:
+  Server *m_server;
+  uint64_t m_id;
+  mysqlshdk::db::Connection_options m_options;
+};
+
+class Sql_parallel_loader_test : public ::testing::Test {
+ protected:
+  std::unique_ptr<Sql_parallel_loader> make_loader(size_t threads,
+                                                   bool stop_on_error = true) {
+    m_main = std::make_shared<Recording_session>(&m_server);
+
+    return std::unique_ptr<Sql_parallel_loader>(new Sql_parallel_loader(
+        m_main, threads, stop_on_error,
+        [this](const shcore::Exception &e) { m_errors.push_back(e.what()); },
+        [this]() { return std::make_shared<Recording_session>(&m_server); }));
+  }
+
+  /**
+   * Feeds a statement to the loader the way Shell_sql does.
+   */
+  void run(Sql_parallel_loader *loader, const std::string &sql,
+           size_t line = 0) {
+    if (loader->accepts(sql.data(), sql.length())) {
+      loader->execute(sql.data(), sql.length(), line);
+    } else {
+      loader->wait();
+      m_main->execute(sql);
+      loader->executed(sql.data(), sql.length(), ";");
+    }
+  }
+
+  // statements executed by the sessions of the pool
+  std::vector<std::vector<std::string>> worker_statements() {
+    std::vector<std::vector<std::string>> result;
+    for (const auto &session : m_server.executed) {
+      if (session.first != m_main->get_connection_id())
+        result.push_back(session.second);
+    }
+    return result;
+  }
+
+  std::vector<std::string> main_statements() {
+    return m_server.executed[m_main->get_connection_id()];
+  }
+
+  Server m_server;
+  std::shared_ptr<Recording_session> m_main;
+  std::vector<std::string> m_errors;
+};
+
+}  // namespace
+
+TEST(Sql_parallel_loader_classify, insert) {
+  EXPECT_EQ(Statement_type::INSERT, type_of("INSERT INTO t VALUES (1)"));
+  EXPECT_EQ("t", table_of("INSERT INTO t VALUES (1)"));
+  EXPECT_EQ("t", table_of("insert t value (1)"));
+  EXPECT_EQ("t", table_of("REPLACE INTO T VALUES (1)"));
+  EXPECT_EQ("t1", table_of("INSERT LOW_PRIORITY IGNORE INTO s.t1 VALUES (1)"));
+  EXPECT_EQ("my table", table_of("INSERT INTO `s`.`My Table` VALUES (1)"));
+  EXPECT_EQ("in`to", table_of("INSERT INTO `in``to` (a, `b`) VALUES (1, 2)"));
+  EXPECT_EQ("t", table_of("/*!40000 INSERT */ INTO t VALUES (1)"));
+  EXPECT_EQ("ignore", table_of("INSERT `ignore` VALUES (1)"));
+
+  // data which looks like session state
+  EXPECT_EQ(Statement_type::INSERT,
+            type_of("INSERT INTO t VALUES ('@a', 'SELECT', "
+                    "\"LAST_INSERT_ID()\", 'it''s @b', 'a\\'@c')"));
+  EXPECT_EQ(Statement_type::INSERT,
+            type_of("INSERT INTO t VALUES (1) ON DUPLICATE KEY UPDATE "
+                    "a = VALUES(a)"));
+
+  // other tables are read
+  EXPECT_EQ(Statement_type::OTHER, type_of("INSERT INTO t SELECT * FROM s"));
+  EXPECT_EQ(Statement_type::OTHER, type_of("INSERT INTO t SET a = 1"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES ((SELECT MAX(a) FROM s))"));
+  EXPECT_EQ(Statement_type::OTHER, type_of("INSERT INTO t (a"));
+
+  // the state of the session is referenced
+  EXPECT_EQ(Statement_type::OTHER, type_of("INSERT INTO t VALUES (@a)"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES (@@sql_mode)"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES (LAST_INSERT_ID())"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES (last_insert_id ())"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES (CONNECTION_ID())"));
+  EXPECT_EQ(Statement_type::OTHER,
+            type_of("INSERT INTO t VALUES (1) ON DUPLICATE KEY UPDATE "
+                    "a = ROW_COUNT()"));
+}
+
+TEST(Sql_parallel_loader_classify, set) {
+  const auto set = [](const std::string &sql) {
+    return classify(sql.data(), sql.length());
+  };
+
+  auto stmt = set("SET sql_mode = ''");
+  EXPECT_EQ(Statement_type::SET, stmt.type);
+  EXPECT_TRUE(stmt.session_state);
+  EXPECT_FALSE(stmt.sets_autocommit);
+  EXPECT_FALSE(stmt.diverges);
+
+  EXPECT_TRUE(set("SET @a = 1").session_state);
+  EXPECT_TRUE(set("SET @`a b` := 1").session_state);
+  EXPECT_TRUE(set("SET @@unique_checks = 0").session_state);
+  EXPECT_TRUE(set("SET @@session.foreign_key_checks = 0").session_state);
+  EXPECT_TRUE(set("SET LOCAL unique_checks = 0").session_state);
+  EXPECT_TRUE(set("SET NAMES utf8mb4 COLLATE utf8mb4_bin").session_state);
+  EXPECT_TRUE(set("SET CHARACTER SET utf8").session_state);
+  EXPECT_TRUE(
+      set("SET SESSION TRANSACTION ISOLATION LEVEL READ COMMITTED")
+          .session_state);
+  EXPECT_TRUE(set("/*!40101 SET @OLD_SQL_MODE=@@SQL_MODE, "
+                  "SQL_MODE='NO_AUTO_VALUE_ON_ZERO' */")
+                  .session_state);
+
+  EXPECT_FALSE(set("SET GLOBAL max_connections = 10").session_state);
+  EXPECT_FALSE(set("SET @@global.max_connections = 10").session_state);
+  EXPECT_FALSE(set("SET PERSIST a = 1, b = 2").session_state);
+  EXPECT_FALSE(set("SET TRANSACTION READ ONLY").session_state);
+  EXPECT_FALSE(set("SET PASSWORD = 'secret'").session_state);
+  EXPECT_FALSE(set("SET DEFAULT ROLE ALL TO u").session_state);
+  EXPECT_TRUE(set("SET GLOBAL a = 1, SESSION b = 2").session_state);
+  EXPECT_TRUE(set("SET GLOBAL a = 1, @@b = 2").session_state);
+
+  // values are not mistaken for assignments
+  EXPECT_FALSE(set("SET GLOBAL a = 'autocommit', b = f(1, 2)").session_state);
+  EXPECT_FALSE(set("SET GLOBAL a = 'x, autocommit = 0'").sets_autocommit);
+  EXPECT_FALSE(set("SET @a = 'autocommit'").sets_autocommit);
+
+  // values which are different in other sessions
+  EXPECT_TRUE(set("SET @id = LAST_INSERT_ID()").diverges);
+  EXPECT_TRUE(set("SET @n := (SELECT COUNT(*) FROM t)").diverges);
+  EXPECT_FALSE(set("SET @@global.a = CONNECTION_ID()").diverges);
+  EXPECT_FALSE(set("SET unique_checks = @old_unique_checks").diverges);
+}
+
+TEST(Sql_parallel_loader_classify, autocommit) {
+  const auto set = [](const std::string &sql) {
+    return classify(sql.data(), sql.length());
+  };
+
+  for (const auto sql :
+       {"SET autocommit = 0", "SET AUTOCOMMIT=OFF", "set @@autocommit := 0",
+        "SET SESSION autocommit = 'OFF'", "SET @@session.autocommit = FALSE",
+        "SET @@local.AutoCommit = 0", "SET sql_mode = '', autocommit = 0",
+        "SET autocommit = @old_autocommit", "SET autocommit = 1 - 1"}) {
+    SCOPED_TRACE(sql);
+    const auto stmt = set(sql);
+    EXPECT_TRUE(stmt.sets_autocommit);
+    EXPECT_FALSE(stmt.autocommit);
+    EXPECT_TRUE(stmt.session_state);
+  }
+
+  for (const auto sql : {"SET autocommit = 1", "SET autocommit = ON",
+                         "SET @@autocommit = 'on'", "SET autocommit=TRUE"}) {
+    SCOPED_TRACE(sql);
+    const auto stmt = set(sql);
+    EXPECT_TRUE(stmt.sets_autocommit);
+    EXPECT_TRUE(stmt.autocommit);
+  }
+
+  for (const auto sql :
+       {"SET GLOBAL autocommit = 0", "SET @@global.autocommit = 0",
+        "SET PERSIST autocommit = 0", "SET @autocommit = 0",
+        "SET @@session.autocommit_x = 0", "SET sql_mode = 'autocommit'"}) {
+    SCOPED_TRACE(sql);
+    EXPECT_FALSE(set(sql).sets_autocommit);
+  }
+}
+
+TEST(Sql_parallel_loader_classify, other) {
+  EXPECT_EQ(Statement_type::USE, type_of("USE test"));
+  EXPECT_EQ(Statement_type::SERIAL_BEGIN, type_of("LOCK TABLES t WRITE"));
+  EXPECT_EQ(Statement_type::SERIAL_BEGIN, type_of("BEGIN"));
+  EXPECT_EQ(Statement_type::SERIAL_BEGIN, type_of("START TRANSACTION"));
+  EXPECT_EQ(Statement_type::SERIAL_BEGIN, type_of("XA START 'x'"));
+  EXPECT_EQ(Statement_type::SERIAL_END, type_of("UNLOCK TABLES"));
+  EXPECT_EQ(Statement_type::SERIAL_END, type_of("COMMIT"));
+  EXPECT_EQ(Statement_type::SERIAL_END, type_of("ROLLBACK"));
+  EXPECT_EQ(Statement_type::OTHER, type_of("ROLLBACK TO SAVEPOINT a"));
+  EXPECT_EQ(Statement_type::SERIAL_END, type_of("XA COMMIT 'x'"));
+
+  const std::string create =
+      "CREATE TEMPORARY TABLE IF NOT EXISTS s.Tmp (a INT)";
+  auto stmt = classify(create.data(), create.length());
+  EXPECT_EQ(Statement_type::CREATE_TEMPORARY_TABLE, stmt.type);
+  EXPECT_EQ(std::vector<std::string>{"tmp"}, stmt.tables);
+  EXPECT_EQ(Statement_type::OTHER, type_of("CREATE TABLE t (a INT)"));
+
+  const std::string drop = "DROP TEMPORARY TABLE IF EXISTS a, `s`.`b`";
+  stmt = classify(drop.data(), drop.length());
+  EXPECT_EQ(Statement_type::DROP_TABLE, stmt.type);
+  EXPECT_EQ((std::vector<std::string>{"a", "b"}), stmt.tables);
+
+  const auto diverges = [](const std::string &sql) {
+    return classify(sql.data(), sql.length()).diverges;
+  };
+
+  EXPECT_TRUE(diverges("CALL p()"));
+  EXPECT_TRUE(diverges("EXECUTE stmt"));
+  EXPECT_TRUE(diverges("SELECT MAX(id) INTO @max FROM t"));
+  EXPECT_TRUE(diverges("SELECT @n := COUNT(*) FROM t"));
+  EXPECT_FALSE(diverges("SELECT @a, @b"));
+  EXPECT_FALSE(diverges("SELECT '@a := 1' INTO OUTFILE '/tmp/x'"));
+  EXPECT_FALSE(diverges("CREATE TABLE t (a INT)"));
+}
+
+TEST_F(Sql_parallel_loader_test, table_order) {
+  auto loader = make_loader(3);
+
+  for (int i = 0; i < 100; ++i) {
+    for (const auto table : {"a", "b", "c", "d"}) {
+      run(loader.get(), std::string("INSERT INTO ") + table + " VALUES (" +
+                            std::to_string(i) + ")");
+    }
+  }
+
+  EXPECT_TRUE(loader->wait());
+  loader.reset();
+
+  // all rows of a table are inserted by the same session, in order
+  std::map<std::string, size_t> sessions;
+  std::map<std::string, int> last_row;
+  size_t index = 0;
+
+  for (const auto &statements : worker_statements()) {
+    for (const auto &sql : statements) {
+      if (sql.compare(0, 12, "INSERT INTO ") != 0) continue;
+
+      const std::string table = sql.substr(12, 1);
+      const int row = std::stoi(sql.substr(22));
+
+      if (sessions.count(table)) {
+        EXPECT_EQ(sessions[table], index) << sql;
+      } else {
+        sessions[table] = index;
+      }
+
+      if (last_row.count(table)) {
+        EXPECT_EQ(last_row[table] + 1, row) << sql;
+      }
+      last_row[table] = row;
+    }
+    ++index;
+  }
+
+  EXPECT_EQ(4u, sessions.size());
+  for (const auto &row : last_row) EXPECT_EQ(99, row.second);
+  EXPECT_TRUE(m_errors.empty());
+}
+
+TEST_F(Sql_parallel_loader_test, session_state) {
+  auto loader = make_loader(2);
+
+  run(loader.get(), "INSERT INTO a VALUES (1)");
+  run(loader.get(), "SET unique_checks = 0");
+  run(loader.get(), "SET GLOBAL max_connections = 10");
+  run(loader.get(), "INSERT INTO a VALUES (2)");
+  run(loader.get(), "INSERT INTO b VALUES (2)");
+  EXPECT_TRUE(loader->wait());
+  loader.reset();
+
+  // the main session executes barriers only
+  EXPECT_EQ((std::vector<std::string>{"SET unique_checks = 0",
+                                      "SET GLOBAL max_connections = 10"}),
+            main_statements());
+
+  // session state is replayed before the inserts which follow it
+  for (const auto &statements : worker_statements()) {
+    bool replayed = false;
+    for (const auto &sql : statements) {
+      EXPECT_NE("SET GLOBAL max_connections = 10", sql);
+      if (sql == "SET unique_checks = 0") replayed = true;
+      if (sql.find("(2)") != std::string::npos) {
+        EXPECT_TRUE(replayed) << sql;
+      } else if (sql.find("(1)") != std::string::npos) {
+        EXPECT_FALSE(replayed) << sql;
+      }
+    }
+  }
+}
+
+TEST_F(Sql_parallel_loader_test, barriers) {
+  auto loader = make_loader(2);
+
+  const std::vector<std::string> main = {
+      // references the session state
+      "INSERT INTO a VALUES (LAST_INSERT_ID())",
+      "INSERT INTO a VALUES (@a)",
+      // temporary tables exist in the main session only
+      "CREATE TEMPORARY TABLE tmp (a INT)",
+      "INSERT INTO tmp VALUES (1)",
+      // transactions
+      "START TRANSACTION",
+      "INSERT INTO a VALUES (2)",
+      "COMMIT",
+      // autocommit
+      "SET autocommit = 0",
+      "INSERT INTO a VALUES (3)",
+      "COMMIT",
+      "INSERT INTO a VALUES (4)",
+      "SET autocommit = 1",
+  };
+
+  for (const auto &sql : main) run(loader.get(), sql);
+
+  run(loader.get(), "INSERT INTO a VALUES (5)");
+  run(loader.get(), "DROP TEMPORARY TABLE tmp");
+  run(loader.get(), "INSERT INTO tmp VALUES (6)");
+
+  EXPECT_TRUE(loader->wait());
+
+  std::vector<std::string> expected = main;
+  expected.push_back("DROP TEMPORARY TABLE tmp");
+  EXPECT_EQ(expected, main_statements());
+
+  // once the session state cannot be replayed, the pool is no longer used
+  run(loader.get(), "SELECT COUNT(*) INTO @n FROM a");
+  run(loader.get(), "INSERT INTO a VALUES (7)");
+  run(loader.get(), "SET autocommit = 1");
+  run(loader.get(), "INSERT INTO a VALUES (8)");
+  EXPECT_TRUE(loader->wait());
+
+  expected.push_back("SELECT COUNT(*) INTO @n FROM a");
+  expected.push_back("INSERT INTO a VALUES (7)");
+  expected.push_back("SET autocommit = 1");
+  expected.push_back("INSERT INTO a VALUES (8)");
+  EXPECT_EQ(expected, main_statements());
+
+  loader.reset();
+
+  std::vector<std::string> inserts;
+  for (const auto &statements : worker_statements()) {
+    for (const auto &sql : statements) {
+      if (sql.compare(0, 6, "INSERT") == 0) inserts.push_back(sql);
+    }
+  }
+  std::sort(inserts.begin(), inserts.end());
+  EXPECT_EQ((std::vector<std::string>{"INSERT INTO a VALUES (5)",
+                                      "INSERT INTO tmp VALUES (6)"}),
+            inserts);
+}
+
+TEST_F(Sql_parallel_loader_test, foreign_keys) {
+  m_server.foreign_key_checks = true;
+  m_server.dependent.insert("child");
+
+  auto loader = make_loader(2);
+
+  // rows may be checked against other tables
+  run(loader.get(), "INSERT INTO parent VALUES (1)");
+
+  m_server.foreign_key_checks = false;
+  run(loader.get(), "SET foreign_key_checks = 0");
+
+  // with the checks disabled, only tables with foreign keys or triggers are
+  // inserted into on the main session
+  run(loader.get(), "INSERT INTO parent VALUES (2)");
+  run(loader.get(), "INSERT INTO child VALUES (3)");
+  run(loader.get(), "INSERT INTO other VALUES (4)");
+  EXPECT_TRUE(loader->wait());
+  loader.reset();
+
+  EXPECT_EQ((std::vector<std::string>{"INSERT INTO parent VALUES (1)",
+                                      "SET foreign_key_checks = 0",
+                                      "INSERT INTO child VALUES (3)"}),
+            main_statements());
+
+  std::vector<std::string> inserts;
+  for (const auto &statements : worker_statements()) {
+    for (const auto &sql : statements) {
+      if (sql.compare(0, 6, "INSERT") == 0) inserts.push_back(sql);
+    }
+  }
+  std::sort(inserts.begin(), inserts.end());
+  EXPECT_EQ((std::vector<std::string>{"INSERT INTO other VALUES (4)",
+                                      "INSERT INTO parent VALUES (2)"}),
+            inserts);
+}
+
+TEST_F(Sql_parallel_loader_test, errors) {
+  m_server.failing.insert("INSERT INTO a VALUES (2)");
+
+  auto loader = make_loader(2);
+
+  run(loader.get(), "INSERT INTO a VALUES (1)", 1);
+  run(loader.get(), "INSERT INTO a VALUES (2)", 2);
+  run(loader.get(), "INSERT INTO a VALUES (3)", 3);
+
+  EXPECT_FALSE(loader->wait());
+  EXPECT_FALSE(loader->ok());
+  ASSERT_EQ(1u, m_errors.size());
+  EXPECT_NE(std::string::npos, m_errors[0].find("Duplicate entry"));
+}
+
+TEST_F(Sql_parallel_loader_test, interrupt) {
+  auto loader = make_loader(2);
+
+  run(loader.get(), "INSERT INTO a VALUES (SLEEP)");
+  run(loader.get(), "INSERT INTO b VALUES (SLEEP)");
+  run(loader.get(), "INSERT INTO a VALUES (1)");
+
+  // wait until both statements are running
+  while (true) {
+    std::lock_guard<std::mutex> lock(m_server.mutex);
+    size_t running = 0;
+    for (const auto &session : m_server.executed) {
+      for (const auto &sql : session.second) {
+        if (sql.find("SLEEP") != std::string::npos) ++running;
+      }
+    }
+    if (running == 2) break;
+  }
+
+  loader->interrupt();
+
+  EXPECT_FALSE(loader->wait());
+  EXPECT_FALSE(loader->ok());
+  EXPECT_EQ(2u, m_server.killed.size());
+
+  // queued statements are discarded
+  for (const auto &statements : worker_statements()) {
+    for (const auto &sql : statements)
+      EXPECT_NE("INSERT INTO a VALUES (1)", sql);
+  }
+
+  ASSERT_FALSE(m_errors.empty());
+  EXPECT_EQ("Execution of the queued statements was interrupted",
+            m_errors.back());
+}
+
+}  // namespace shcore
@@ -131,6 +131,12 @@ cluster.help("switchToSinglePrimaryMode")
 //@ switchToSinglePrimaryMode, \? [USE:switchToSinglePrimaryMode]
 \? cluster.switchToSinglePrimaryMode
 
+//@ Watch
+cluster.help("watch")
+
+//@ Watch, \? [USE:Watch]
+\? cluster.watch
+
 
 //@ Finalization
 cluster.disconnect();
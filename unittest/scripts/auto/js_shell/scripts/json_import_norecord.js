@@ -549,6 +549,99 @@ EXPECT_STDOUT_CONTAINS(
     '" to collection `wl10606`.`2MB_less________` in MySQL Server at');
 EXPECT_STDOUT_CONTAINS("Total successfully imported documents 1 ");
 
+//@<> Import using multiple threads
+util.importJson(__import_data_path + '/sample.json', {
+  schema: target_schema,
+  collection: 'threads_sample',
+  threads: 4
+});
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 18 ");
+EXPECT_EQ(18, session.getSchema(target_schema).getCollection('threads_sample').count());
+
+util.importJson(__import_data_path + '/sample_pretty.json', {
+  schema: target_schema,
+  collection: 'threads_sample_pretty',
+  threads: 4
+});
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 18 ");
+EXPECT_EQ(18, session.getSchema(target_schema).getCollection('threads_sample_pretty').count());
+
+//@<> Import using invalid number of threads
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample.json', {
+    schema: target_schema,
+    collection: 'threads_sample',
+    threads: 0
+  });
+}, "Util.importJson: Option 'threads' must be a positive integer.");
+
+//@<> Import using pinned batch sizes
+util.importJson(__import_data_path + '/sample.json', {
+  schema: target_schema,
+  collection: 'pinned_sample',
+  documentsPerInsert: 5,
+  insertsPerCommit: 2
+});
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 18 ");
+EXPECT_STDOUT_CONTAINS("Average batch: 4.5 documents per insert (pinned to 5), 2.0 inserts per commit (pinned to 2), target commit latency 1000 ms");
+EXPECT_EQ(18, session.getSchema(target_schema).getCollection('pinned_sample').count());
+
+//@<> Import using adaptive batch sizes
+util.importJson(__import_data_path + '/sample.json', {
+  schema: target_schema,
+  collection: 'adaptive_sample',
+  commitLatency: 200
+});
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 18 ");
+EXPECT_STDOUT_CONTAINS("documents per insert (adaptive)");
+EXPECT_STDOUT_CONTAINS("inserts per commit (adaptive), target commit latency 200 ms");
+
+//@<> Import using invalid batch sizes
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample.json', {
+    schema: target_schema,
+    collection: 'pinned_sample',
+    documentsPerInsert: 0
+  });
+}, "Util.importJson: Option 'documentsPerInsert' must be a positive integer.");
+
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample.json', {
+    schema: target_schema,
+    collection: 'pinned_sample',
+    commitLatency: -1
+  });
+}, "Util.importJson: Option 'commitLatency' must be a positive integer.");
+
+//@<> Resume an import which was finished
+// progress file is removed once the import is finished
+EXPECT_THROWS(function() {
+  util.importJson(__import_data_path + '/sample.json', {
+    schema: target_schema,
+    collection: 'threads_sample',
+    resume: true
+  });
+}, "Util.importJson: Progress file '" + __import_data_path + "/sample.json.progress' does not exist, there is no import to be resumed.");
+
+//@<> Resume an interrupted import
+testutil.createFile("resume.json", '{"a":1}\n{"a":2}\n{"a":3}\n{"a":4}\n');
+testutil.createFile("resume.json.progress", JSON.stringify({
+  input: "resume.json",
+  size: 32,
+  ranges: [{begin: 0, end: 32, committed: 16}]
+}));
+
+util.importJson("resume.json", {
+  schema: target_schema,
+  collection: 'resume_sample',
+  resume: true
+});
+EXPECT_STDOUT_CONTAINS("Resuming the import, 16 bytes of the input were already committed.");
+EXPECT_STDOUT_CONTAINS("Total successfully imported documents 2 ");
+EXPECT_EQ(2, session.getSchema(target_schema).getCollection('resume_sample').find('a > 2').execute().fetchAll().length);
+EXPECT_EQ(2, session.getSchema(target_schema).getCollection('resume_sample').count());
+testutil.rmfile("resume.json");
+
 //@<> Import document using invalid options
 EXPECT_THROWS(function() {
   util.importJson(__import_data_path + '/2MB_doc.json', {
@@ -76,6 +76,12 @@ shell.help("parseUri")
 //@ Help on parseUri, \? [USE:Help on parseUri]
 \? parseuri
 
+//@ Help on profile
+shell.help("profile")
+
+//@ Help on profile, \? [USE:Help on profile]
+\? shell.profile
+
 //@ Help on Prompt
 shell.help("prompt")
 
@@ -0,0 +1,38 @@
+// Tests of shell.profile()
+
+//@<> Profiling is disabled by default
+EXPECT_FALSE(shell.options.profile);
+shell.profile();
+EXPECT_STDOUT_CONTAINS("No stages were recorded");
+
+//@<> Stages of the queries
+shell.options.profile = true;
+
+var session = mysql.getClassicSession(__uripwd);
+session.runSql("select 1");
+session.runSql("select 2");
+session.close();
+
+shell.profile({traceFile: "profile_trace.json", reset: true});
+EXPECT_STDOUT_CONTAINS("Classic connect");
+EXPECT_STDOUT_CONTAINS("Classic query");
+EXPECT_STDOUT_CONTAINS("  Execute");
+EXPECT_STDOUT_CONTAINS("  Receive result");
+
+var trace = JSON.parse(os.load_text_file("profile_trace.json"));
+EXPECT_TRUE(trace.traceEvents.length > 0);
+EXPECT_EQ("Classic connect", trace.traceEvents[0].name);
+EXPECT_EQ("X", trace.traceEvents[0].ph);
+testutil.rmfile("profile_trace.json");
+
+//@<> Recorded stages are discarded on reset
+shell.profile();
+EXPECT_STDOUT_CONTAINS("No stages were recorded");
+
+//@<> Invalid options
+EXPECT_THROWS(function() {
+  shell.profile({unknown: 1});
+}, "Shell.profile: Invalid options: unknown");
+
+//@<> Cleanup
+shell.options.profile = false;
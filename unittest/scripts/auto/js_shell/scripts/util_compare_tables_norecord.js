@@ -0,0 +1,98 @@
+// Tests of util.compareTables()
+
+// Setup
+testutil.deploySandbox(__mysql_sandbox_port1, "root");
+testutil.deploySandbox(__mysql_sandbox_port2, "root");
+
+function create_tables(uri) {
+  var s = mysql.getClassicSession(uri);
+  s.runSql("create schema compare_test");
+  s.runSql("create table compare_test.t (id int primary key, name varchar(20), value double)");
+  s.runSql("create table compare_test.nokey (id int)");
+
+  var values = [];
+  for (var i = 1; i <= 1000; ++i) {
+    values.push("(" + i + ",'n" + i + "'," + i + ".5)");
+  }
+  s.runSql("insert into compare_test.t values " + values.join(","));
+  s.runSql("analyze table compare_test.t");
+
+  return s;
+}
+
+var source = create_tables(__sandbox_uri1);
+var target = create_tables(__sandbox_uri2);
+
+const options = {schema: "compare_test", table: "t", chunkSize: 100, threads: 3};
+
+//@<> Identical tables
+var result = util.compareTables(__sandbox_uri1, __sandbox_uri2, options);
+EXPECT_TRUE(result.identical);
+EXPECT_TRUE(result.chunks > 1);
+EXPECT_EQ(0, result.differentChunks);
+EXPECT_EQ(0, result.missingRows);
+EXPECT_EQ(0, result.extraRows);
+EXPECT_EQ(0, result.differentRows);
+EXPECT_STDOUT_CONTAINS("Compared 1000 rows from ");
+
+//@<> Different tables
+target.runSql("delete from compare_test.t where id = 10");
+target.runSql("update compare_test.t set name = NULL where id = 500");
+target.runSql("update compare_test.t set name = 'x', value = 0 where id = 501");
+target.runSql("insert into compare_test.t values (5000, 'extra', 0)");
+
+var result = util.compareTables(__sandbox_uri1, __sandbox_uri2, options);
+EXPECT_FALSE(result.identical);
+EXPECT_EQ(3, result.differentChunks);
+EXPECT_EQ(1, result.missingRows);
+EXPECT_EQ(1, result.extraRows);
+EXPECT_EQ(2, result.differentRows);
+EXPECT_STDOUT_CONTAINS("Row (10) is missing on the target server.");
+EXPECT_STDOUT_CONTAINS("Row (500) differs in columns: name.");
+EXPECT_STDOUT_CONTAINS("Row (501) differs in columns: name, value.");
+EXPECT_STDOUT_CONTAINS("Row (5000) exists only on the target server.");
+
+//@<> Single chunk, schema taken from the source URI
+var result = util.compareTables(__sandbox_uri1 + "/compare_test", __sandbox_uri2, {table: "t", chunkSize: 1000000});
+EXPECT_EQ(1, result.chunks);
+EXPECT_EQ(1, result.differentChunks);
+EXPECT_EQ(4, result.missingRows + result.extraRows + result.differentRows);
+
+//@<> Invalid options
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test"});
+}, "Util.compareTables: The name of the table must be provided in the 'table' option.");
+
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {table: "t"});
+}, "Util.compareTables: The schema of the table must be provided in the options or in the source connection data.");
+
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test", table: "t", threads: 0});
+}, "Util.compareTables: Option 'threads' must be a positive integer.");
+
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test", table: "t", unknown: 1});
+}, "Util.compareTables: Invalid options: unknown");
+
+//@<> Tables which cannot be compared
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test", table: "nokey"});
+}, "Table `compare_test`.`nokey` does not have a primary key, which is required to compare its rows.");
+
+source.runSql("create table compare_test.missing (id int primary key)");
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test", table: "missing"});
+}, "Table `compare_test`.`missing` does not exist on the target server.");
+
+source.runSql("create table compare_test.other (id int primary key, a int)");
+target.runSql("create table compare_test.other (id int primary key, a bigint)");
+EXPECT_THROWS(function() {
+  util.compareTables(__sandbox_uri1, __sandbox_uri2, {schema: "compare_test", table: "other"});
+}, "Table `compare_test`.`other` has different definitions on the source and target servers.");
+
+//@<> Cleanup
+source.close();
+target.close();
+testutil.destroySandbox(__mysql_sandbox_port1);
+testutil.destroySandbox(__mysql_sandbox_port2);
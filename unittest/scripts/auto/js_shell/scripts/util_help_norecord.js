@@ -7,3 +7,11 @@ util.help('checkForServerUpgrade');
 //@ util importJson help
 util.help('importJson');
 
+//@ util exportTable help
+util.help('exportTable');
+
+//@ util importTable help
+util.help('importTable');
+
+//@ util compareTables help
+util.help('compareTables');
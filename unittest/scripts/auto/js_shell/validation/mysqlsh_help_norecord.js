@@ -110,6 +110,9 @@ Usage: mysqlsh [OPTIONS] [URI]
                                 ENV variable PAGER. This option only works in
                                 interactive mode. This option is disabled by
                                 default.
+  --profile                     Record the time spent in the stages of the
+                                shell operations, use shell.profile() to print
+                                them.
   --name-cache                  Enable database name caching for autocompletion
                                 and DevAPI (default).
   -A, --no-name-cache           Disable automatic database name caching for
@@ -264,6 +267,9 @@ Usage: mysqlsh [OPTIONS] [URI]
                                 ENV variable PAGER. This option only works in
                                 interactive mode. This option is disabled by
                                 default.
+  --profile                     Record the time spent in the stages of the
+                                shell operations, use shell.profile() to print
+                                them.
   --name-cache                  Enable database name caching for autocompletion
                                 and DevAPI (default).
   -A, --no-name-cache           Disable automatic database name caching for
@@ -13,6 +13,14 @@ DESCRIPTION
         enabled. The \rehash command can be used for manual refresh
       - batchContinueOnError: read-only, boolean value to indicate if the
         execution of an SQL script in batch mode shall continue if errors occur
+      - batchStatements: maximum number of consecutive DML statements sent to
+        the server in a single round trip when executing an SQL script in batch
+        mode using a classic session, 1 sends every statement on its own
+      - batchThreads: number of sessions used to insert rows into different
+        tables in parallel when executing an SQL script in batch mode, 1
+        executes every statement on the main session. Rows are inserted in
+        parallel only while foreign_key_checks is disabled, and never into
+        tables with foreign keys or triggers
       - credentialStore.excludeFilters: array of URLs for which automatic
         password storage is disabled, supports glob characters '*' and '?'
       - credentialStore.helper: name of the credential helper to use to
@@ -41,6 +49,8 @@ DESCRIPTION
         used to display the paged output
       - passwordsFromStdin: boolean value that indicates if the shell should
         read passwords from stdin instead of the tty
+      - profile: true to record the time spent in the stages of the shell
+        operations, see shell.profile()
       - sandboxDir: default path where the new sandbox instances for InnoDB
         cluster will be deployed
       - showColumnTypeInfo: display column type information in SQL mode. Please
@@ -247,6 +247,8 @@
 //@<OUT> List all the options using \option
  autocomplete.nameCache          true
  batchContinueOnError            false
+ batchStatements                 1
+ batchThreads                    1
  credentialStore.excludeFilters  []
  credentialStore.helper          default
  credentialStore.savePasswords   prompt
@@ -262,6 +264,7 @@
  outputFormat                    table
  pager                           ""
  passwordsFromStdin              false
+ profile                         false
  resultFormat                    table
  sandboxDir                      <<<_defaultSandboxDir>>>
  showColumnTypeInfo              false
@@ -271,6 +274,8 @@
 //@<OUT> List all the options using \option and show-origin
  autocomplete.nameCache          true (Compiled default)
  batchContinueOnError            false (Compiled default)
+ batchStatements                 1 (Compiled default)
+ batchThreads                    1 (Compiled default)
  credentialStore.excludeFilters  [] (Compiled default)
  credentialStore.helper          default (Compiled default)
  credentialStore.savePasswords   prompt (Compiled default)
@@ -286,6 +291,7 @@
  outputFormat                    table (Compiled default)
  pager                           "" (Compiled default)
  passwordsFromStdin              false (Compiled default)
+ profile                         false (Compiled default)
  resultFormat                    table (Compiled default)
  sandboxDir                      <<<_defaultSandboxDir>>> (Compiled default)
  showColumnTypeInfo              false (Compiled default)
@@ -326,6 +332,8 @@
 //@<OUT> List all the options using \option for SQL mode
  autocomplete.nameCache          true
  batchContinueOnError            false
+ batchStatements                 1
+ batchThreads                    1
  credentialStore.excludeFilters  []
  credentialStore.helper          default
  credentialStore.savePasswords   prompt
@@ -341,6 +349,7 @@
  outputFormat                    table
  pager                           ""
  passwordsFromStdin              false
+ profile                         false
  resultFormat                    table
  sandboxDir                      <<<_defaultSandboxDir>>>
  showColumnTypeInfo              false
@@ -351,6 +360,8 @@
  Switching to SQL mode... Commands end with ;
  autocomplete.nameCache          true (Compiled default)
  batchContinueOnError            false (Compiled default)
+ batchStatements                 1 (Compiled default)
+ batchThreads                    1 (Compiled default)
  credentialStore.excludeFilters  [] (Compiled default)
  credentialStore.helper          default (Compiled default)
  credentialStore.savePasswords   prompt (Compiled default)
@@ -366,6 +377,7 @@
  outputFormat                    table (Compiled default)
  pager                           "" (Compiled default)
  passwordsFromStdin              false (Compiled default)
+ profile                         false (Compiled default)
  resultFormat                    table (Compiled default)
  sandboxDir                      <<<_defaultSandboxDir>>> (Compiled default)
  showColumnTypeInfo              false (Compiled default)
@@ -12,6 +12,14 @@ FUNCTIONS
             Performs series of tests on specified MySQL server to check if the
             upgrade process will succeed.
 
+      compareTables(source, target[, options])
+            Compares contents of a table on two MySQL Servers, using checksums
+            computed by the servers to find the rows which differ.
+
+      exportTable(table, outputDir[, options])
+            Exports contents of a table to files, using multiple MySQL Protocol
+            sessions to read the data in parallel.
+
       help([member])
             Provides help about this object and it's members
 
@@ -19,6 +27,10 @@ FUNCTIONS
             Import JSON documents from file to collection or table in MySQL
             Server using X Protocol session.
 
+      importTable(file[, options])
+            Imports contents of a text file into a table, using multiple MySQL
+            Protocol sessions to load the data in parallel.
+
 
 //@<OUT> util checkForServerUpgrade help
 NAME
@@ -42,6 +54,8 @@ DESCRIPTION
       - outputFormat - value can be either TEXT (default) or JSON.
       - targetVersion - version to which upgrade will be checked
         (default=<<<__mysh_version>>>)
+      - threads - number of sessions used to run the checks in parallel, CHECK
+        TABLE is run for several schemas at a time (default=1).
       - password - password for connection.
 
       The connection data may be specified in the following formats:
@@ -142,6 +156,24 @@ DESCRIPTION
         conversion of the BSON ObjectId values.
       - extractOidTime: string (default: empty) - creates a new field based on
         the ObjectID timestamp. Only valid if convertBsonOid is enabled.
+      - threads: int (default: 1) - number of threads used to import the file.
+        The file is split into chunks aligned on document boundaries and each
+        chunk is imported using its own X Protocol session.
+      - commitLatency: int (default: 1000) - time in milliseconds which each
+        transaction should take to be executed and committed. The number of
+        documents per insert and the number of inserts per transaction are tuned
+        to meet it, based on the measured response times of the server.
+      - documentsPerInsert: int (default: adaptive) - maximum number of
+        documents sent in a single insert, disables its tuning. Inserts are also
+        limited by mysqlx_max_allowed_packet.
+      - insertsPerCommit: int (default: adaptive) - number of inserts executed
+        in a single transaction, disables its tuning.
+      - progressFile: string (default: path to the file with the .progress
+        suffix) - file where the offsets of the committed documents are recorded
+        after each commit. It is removed once the import finishes successfully.
+      - resume: bool (default: false) - resumes an interrupted import right
+        after the documents recorded as committed in the progress file. The same
+        file, schema and target have to be used.
 
       The following options are valid only when convertBsonTypes is enabled.
       They are all boolean flags. ignoreRegexOptions is enabled by default,
@@ -214,4 +246,171 @@ EXCEPTIONS
 
       - JSON document is ill-formed
 
+//@<OUT> util exportTable help
+NAME
+      exportTable - Exports contents of a table to files, using multiple MySQL
+                    Protocol sessions to read the data in parallel.
+
+SYNTAX
+      util.exportTable(table, outputDir[, options])
+
+WHERE
+      table: Name of the table to be exported.
+      outputDir: Path to the directory where the files are written.
+      options: Dictionary with export options
+
+DESCRIPTION
+      If the table has a primary key on a single integer column, it is split
+      into chunks of the key values, each chunk is written to its own file named
+      after the table and the chunk number and the chunks are read concurrently.
+      A manifest file named after the table with the .manifest.json suffix,
+      describing the columns, the chunks and the replication coordinates of the
+      exported data, is written once all the chunks are exported. Characters of
+      the table name other than letters, digits, '_' and '-' are percent-encoded
+      in the file names.
+
+      The options dictionary supports the following options:
+
+      - schema: string - name of the schema of the table.
+      - format: string (default: "tsv") - format of the files, one of: tsv
+        (format used by LOAD DATA with default options), csv (RFC 4180 with NULL
+        written as \N and backslashes escaped), ndjson (a JSON object per line,
+        values of binary columns are base64 encoded strings).
+      - threads: int (default: 4) - number of threads and sessions used to read
+        the chunks.
+      - chunkRows: int (default: 1000000) - approximate number of rows in each
+        chunk.
+      - consistent: bool (default: true) - lock the table while the sessions
+        start their transactions, so all the chunks are read from the same
+        snapshot. FLUSH TABLES WITH READ LOCK is used if the user has the RELOAD
+        privilege, LOCK TABLES otherwise.
+
+      If the schema is not provided, an active schema on the global session, if
+      set, will be used.
+
+EXCEPTIONS
+      Throws ArgumentError when:
+
+      - Option name is invalid
+      - Format is not valid
+      - Number of threads or chunk rows is not positive
+
+      Throws RuntimeError when:
+
+      - Shell is not connected to MySQL Server using MySQL Protocol
+      - Schema is not provided and there is no active schema on the global
+        session
+      - The table does not exist
+      - The files cannot be written
+      - MySQL Server returns an error
+
+//@<OUT> util importTable help
+NAME
+      importTable - Imports contents of a text file into a table, using multiple
+                    MySQL Protocol sessions to load the data in parallel.
+
+SYNTAX
+      util.importTable(file[, options])
+
+WHERE
+      file: Path to the file with the data to be imported.
+      options: Dictionary with import options
+
+DESCRIPTION
+      The file is split into chunks aligned on line boundaries and each chunk is
+      loaded using a LOAD DATA LOCAL INFILE statement, the chunks are loaded
+      concurrently. Fields in the file must not contain unescaped new line
+      characters. The local_infile global system variable must be enabled on the
+      target server.
+
+      The options dictionary supports the following options:
 
+      - schema: string - name of the target schema.
+      - table: string - name of the target table, by default it is the name of
+        the file up to the first dot.
+      - format: string (default: "tsv") - format of the file, one of: tsv
+        (format used by LOAD DATA with default options), csv (RFC 4180 with NULL
+        written as \N and backslashes escaped).
+      - threads: int (default: 4) - number of threads and sessions used to load
+        the chunks.
+      - bytesPerChunk: int (default: 52428800) - approximate size of each chunk
+        in bytes.
+
+      If the schema is not provided, an active schema on the global session, if
+      set, will be used.
+
+EXCEPTIONS
+      Throws ArgumentError when:
+
+      - Option name is invalid
+      - Format is not valid
+      - Number of threads or bytes per chunk is not positive
+
+      Throws RuntimeError when:
+
+      - Shell is not connected to MySQL Server using MySQL Protocol
+      - Schema is not provided and there is no active schema on the global
+        session
+      - The local_infile global system variable is disabled
+      - The file does not exist or cannot be mapped into memory
+      - MySQL Server returns an error
+
+//@<OUT> util compareTables help
+NAME
+      compareTables - Compares contents of a table on two MySQL Servers, using
+                      checksums computed by the servers to find the rows which
+                      differ.
+
+SYNTAX
+      util.compareTables(source, target[, options])
+
+WHERE
+      source: Connection data of the server with the reference data.
+      target: Connection data of the server which is validated.
+      options: Dictionary with comparison options
+
+RETURNS
+       A dictionary with the results of the comparison.
+
+DESCRIPTION
+      If the first column of the primary key of the table is an integer, the
+      table is split into chunks of the values of that column and the chunks are
+      compared concurrently. Both servers compute the number of rows and a
+      checksum of each chunk, using the CRC32() and BIT_XOR() functions, only
+      the rows of the chunks whose checksums differ are read from both servers
+      and compared one by one. The table must have a primary key and the same
+      definition on both servers.
+
+      The options dictionary supports the following options:
+
+      - schema: string - name of the schema of the table.
+      - table: string - name of the table, this option is required.
+      - threads: int (default: 4) - number of threads and pairs of sessions used
+        to compare the chunks.
+      - chunkSize: int (default: 100000) - approximate number of rows in each
+        chunk.
+
+      If the schema is not provided, the schema of the source connection data,
+      if set, will be used.
+
+      The returned dictionary contains the number of compared chunks (chunks),
+      the number of chunks whose checksums differ (differentChunks), the number
+      of rows which are missing on the target (missingRows), exist only on the
+      target (extraRows) or have different values (differentRows) and whether
+      the tables are identical (identical). Rows which are modified while the
+      table is compared may be reported as different.
+
+EXCEPTIONS
+      Throws ArgumentError when:
+
+      - Option name is invalid
+      - The table is not provided
+      - Number of threads or chunk size is not positive
+
+      Throws RuntimeError when:
+
+      - Schema is not provided and it is not set in the source connection data
+      - The table does not exist on any of the servers
+      - The table does not have a primary key
+      - The table has different definitions on the servers
+      - MySQL Server returns an error
@@ -26,7 +26,8 @@ validate_members(cluster, [
     'set_option',
     'set_instance_option',
     'switch_to_multi_primary_mode',
-    'switch_to_single_primary_mode'
+    'switch_to_single_primary_mode',
+    'watch'
     ])
 
 cluster.disconnect()
@@ -186,6 +186,15 @@ c.help('switch_to_single_primary_mode')
 #@ global help for switch_to_single_primary_mode[USE:cluster.switch_to_single_primary_mode]
 \help cluster.switch_to_single_primary_mode
 
+#@ cluster.watch
+c.help('watch')
+
+#@ global ? for watch[USE:cluster.watch]
+\? cluster.watch
+
+#@ global help for watch[USE:cluster.watch]
+\help cluster.watch
+
 c.disconnect()
 
 testutil.destroy_sandbox(__mysql_sandbox_port1);
@@ -73,6 +73,9 @@ FUNCTIONS
       switch_to_single_primary_mode([instance])
             Switches the cluster to single-primary mode.
 
+      watch([interval])
+            Monitors the membership of the cluster, printing the changes.
+
       For more help on a specific function use: cluster.help('<functionName>')
 
       e.g. cluster.help('addInstance')
@@ -895,6 +898,9 @@ DESCRIPTION
       - queryMembers: if true, connect to each Instance of the ReplicaSets to
         query for more detailed stats about the replication machinery.
 
+      To monitor the membership of the cluster, use watch() instead of calling
+      this function repeatedly.
+
 EXCEPTIONS
       MetadataError in the following scenarios:
 
@@ -1008,3 +1014,35 @@ EXCEPTIONS
       - If any of the cluster members has a version < 8.0.13.
       - If the cluster has no visible quorum.
       - If any of the cluster members is not ONLINE.
+
+#@<OUT> cluster.watch
+NAME
+      watch - Monitors the membership of the cluster, printing the changes.
+
+SYNTAX
+      <Cluster>.watch([interval])
+
+WHERE
+      interval: Number of seconds between checks, 2 by default, at least 0.5.
+
+RETURNS
+       Nothing.
+
+DESCRIPTION
+      This function prints the state and role of every member of the cluster,
+      then checks them again every interval seconds and prints only the members
+      which joined, left or changed, until interrupted with Ctrl+C.
+
+      The Metadata is read only once. Each check is a single query to
+      performance_schema.replication_group_members on one member, using sessions
+      which are kept open while watching. If that member cannot be reached or is
+      no longer in the group, the other members are queried instead.
+
+EXCEPTIONS
+      MetadataError in the following scenarios:
+
+      - If the Metadata is inaccessible.
+
+      ArgumentError in the following scenarios:
+
+      - If the interval is not greater than 0.
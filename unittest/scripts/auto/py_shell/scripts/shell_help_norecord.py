@@ -115,6 +115,15 @@ shell.help('parse_uri')
 #@ global help for parse_uri[USE:shell.parse_uri]
 \help Shell.parse_uri
 
+#@ shell.profile
+shell.help('profile')
+
+#@ global ? for profile[USE:shell.profile]
+\? Shell.profile
+
+#@ global help for profile[USE:shell.profile]
+\help Shell.profile
+
 #@ shell.prompt
 shell.help('prompt')
 
@@ -7,3 +7,11 @@ util.help('check_for_server_upgrade')
 #@ util import_json help
 util.help('import_json')
 
+#@ util export_table help
+util.help('export_table')
+
+#@ util import_table help
+util.help('import_table')
+
+#@ util compare_tables help
+util.help('compare_tables')
@@ -44,6 +44,9 @@ FUNCTIONS
       parse_uri(uri)
             Utility function to parse a URI string.
 
+      profile([options])
+            Prints the time spent in the stages of the shell operations.
+
       prompt(message[, options])
             Utility function to prompt data from the user.
 
@@ -314,6 +317,14 @@ DESCRIPTION
         enabled. The \rehash command can be used for manual refresh
       - batchContinueOnError: read-only, boolean value to indicate if the
         execution of an SQL script in batch mode shall continue if errors occur
+      - batchStatements: maximum number of consecutive DML statements sent to
+        the server in a single round trip when executing an SQL script in batch
+        mode using a classic session, 1 sends every statement on its own
+      - batchThreads: number of sessions used to insert rows into different
+        tables in parallel when executing an SQL script in batch mode, 1
+        executes every statement on the main session. Rows are inserted in
+        parallel only while foreign_key_checks is disabled, and never into
+        tables with foreign keys or triggers
       - credentialStore.excludeFilters: array of URLs for which automatic
         password storage is disabled, supports glob characters '*' and '?'
       - credentialStore.helper: name of the credential helper to use to
@@ -342,6 +353,8 @@ DESCRIPTION
         used to display the paged output
       - passwordsFromStdin: boolean value that indicates if the shell should
         read passwords from stdin instead of the tty
+      - profile: true to record the time spent in the stages of the shell
+        operations, see shell.profile()
       - sandboxDir: default path where the new sandbox instances for InnoDB
         cluster will be deployed
       - showColumnTypeInfo: display column type information in SQL mode. Please
@@ -402,6 +415,35 @@ DESCRIPTION
       For more details about how a URI is created as well as the returned
       dictionary, use \? connection
 
+#@<OUT> shell.profile
+NAME
+      profile - Prints the time spent in the stages of the shell operations.
+
+SYNTAX
+      shell.profile([options])
+
+WHERE
+      options: Dictionary with report options
+
+DESCRIPTION
+      The stages are recorded while the shell.options.profile option is enabled,
+      i.e. using the --profile command line option. This includes connecting to
+      the server, executing queries, receiving and printing the results, and the
+      steps of the AdminAPI operations.
+
+      The stages are printed as a tree, stages with the same path are aggregated
+      into a single entry, with the number of calls, total and average time.
+      Stages of the different threads are added together, their total time may
+      be greater than the elapsed time.
+
+      The options dictionary supports the following options:
+
+      - traceFile: string - path to a file where all the recorded stages are
+        written, using the Trace Event Format, which can be loaded by the
+        chrome://tracing tool.
+      - reset: bool (default: false) - discards the recorded stages after they
+        are reported.
+
 #@<OUT> shell.prompt
 NAME
       prompt - Utility function to prompt data from the user.
@@ -41,6 +41,7 @@ validateMember(members, 'setPrimaryInstance');
 validateMember(members, 'options');
 validateMember(members, 'setOption');
 validateMember(members, 'setInstanceOption');
+validateMember(members, 'watch');
 
 //@ Cluster: addInstance errors
 Cluster.addInstance();
@@ -2,7 +2,7 @@
 ||
 
 //@ Cluster: validating members
-|Cluster Members: 19|
+|Cluster Members: 20|
 |name: OK|
 |getName: OK|
 |addInstance: OK|
@@ -22,6 +22,7 @@
 |options: OK|
 |setOption: OK|
 |setInstanceOption: OK|
+|watch: OK|
 
 //@ Cluster: addInstance errors
 ||Cluster.addInstance: Invalid number of arguments, expected 1 to 2 but got 0
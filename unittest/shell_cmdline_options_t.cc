@@ -152,6 +152,8 @@ class Shell_cmdline_options : public tests::Shell_base_test {
       return AS__STRING(options->show_column_type_info);
     else if (option == "compress")
       return AS__STRING(options->compress);
+    else if (option == "profile")
+      return AS__STRING(options->profile);
 
     return "";
   }
@@ -697,6 +699,7 @@ TEST_F(Shell_cmdline_options, default_values) {
   EXPECT_FALSE(options.show_column_type_info);
   EXPECT_FALSE(options.compress);
   EXPECT_FALSE(options.default_compress);
+  EXPECT_FALSE(options.profile);
 }
 
 TEST_F(Shell_cmdline_options, app) {
@@ -815,6 +818,7 @@ TEST_F(Shell_cmdline_options, app) {
   test_option_with_value("quiet-start", "", "2", "1", !IS_CONNECTION_DATA,
                          IS_NULLABLE, "quiet-start", "2");
   test_option_with_no_value("--column-type-info", "showColumnTypeInfo", "1");
+  test_option_with_no_value("--profile", "profile", "1");
   test_option_with_value("interactive", "", "full", "1", !IS_CONNECTION_DATA,
                          IS_NULLABLE, "interactive", "1");
   // test_option_with_value("interactive", "", "full", "1", !IS_CONNECTION_DATA,
@@ -22,6 +22,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
+#include <sstream>
 #include <string>
 
 #include "gtest_clean.h"
@@ -33,6 +34,7 @@
 #include "modules/mod_shell.h"
 #include "mysqlshdk/libs/utils/utils_general.h"
 #include "mysqlshdk/shellcore/shell_console.h"
+#include "mysqlshdk/include/shellcore/scoped_contexts.h"
 #include "scripting/common.h"
 #include "shellcore/base_session.h"
 #include "shellcore/shell_core.h"
@@ -530,5 +532,60 @@ TEST_F(Shell_sql_test, batch_script_error) {
 
 TEST_F(Shell_sql_test, batch_script_error_force) {}
 
+TEST_F(Shell_sql_test, batch_statements) {
+  auto options = std::make_shared<mysqlsh::Shell_options>();
+  options->set(SHCORE_BATCH_STATEMENTS, "10");
+  mysqlsh::Scoped_shell_options scoped_options(options);
+
+  auto session = env.shell_core->get_dev_session()->get_core_session();
+  session->execute("drop schema if exists shell_sql_batch");
+  session->execute("create schema shell_sql_batch");
+  session->execute("create table shell_sql_batch.t (id int primary key)");
+
+  const auto ids = [&session]() {
+    auto result = session->query(
+        "select group_concat(id order by id) from shell_sql_batch.t");
+    auto row = result->fetch_one();
+    return row->is_null(0) ? std::string() : row->get_string(0);
+  };
+
+  size_t results = 0;
+  env.shell_sql->set_result_processor(
+      [&results](std::shared_ptr<mysqlshdk::db::IResult> result,
+                 const Sql_result_info &) {
+        if (result) ++results;
+      });
+
+  std::stringstream script(
+      "insert into shell_sql_batch.t values (1);\n"
+      "insert into shell_sql_batch.t values (2);\n"
+      "update shell_sql_batch.t set id = id + 10;\n"
+      "select 1;\n"
+      "insert into shell_sql_batch.t values (3);\n"
+      "delete from shell_sql_batch.t where id = 11;\n");
+  EXPECT_TRUE(env.shell_sql->handle_input_stream(&script));
+
+  // every statement is reported, the select is executed between two batches
+  EXPECT_EQ(6u, results);
+  EXPECT_EQ("3,12", ids());
+
+  // multiple statements are disabled once the batches are executed
+  EXPECT_THROW(session->query("select 1;select 2"), std::exception);
+
+  // statements following the failed one are not executed
+  results = 0;
+  std::stringstream failing(
+      "insert into shell_sql_batch.t values (5);\n"
+      "insert into shell_sql_batch.t values (5);\n"
+      "insert into shell_sql_batch.t values (6);\n");
+  EXPECT_FALSE(env.shell_sql->handle_input_stream(&failing));
+  EXPECT_EQ(1u, results);
+  EXPECT_EQ("3,5,12", ids());
+  MY_EXPECT_STDERR_CONTAINS("Duplicate entry '5'");
+  EXPECT_THROW(session->query("select 1;select 2"), std::exception);
+
+  session->execute("drop schema shell_sql_batch");
+}
+
 }  // namespace sql_shell_tests
 }  // namespace shcore
@@ -648,6 +648,8 @@ str Testutils::get_shell_log_path();
 #endif
 ///@}
 std::string Testutils::get_shell_log_path() {
+  // make sure all the log entries are in the file
+  ngcommon::Logger::flush();
   return ngcommon::Logger::singleton()->logfile_name();
 }
 
@@ -995,6 +995,29 @@ select 1;
 )*"));
 }
 
+TEST_P(Statement_splitter, long_strings) {
+  // strings longer than the blocks scanned at once, with escapes and quotes
+  // at every position of a block
+  for (size_t i = 0; i < 40; ++i) {
+    const std::string body(i, 'x');
+    const std::string tail(40 - i, 'y');
+
+    for (const char *special : {"\\'", "''", "\\\\", "\\;", "\"", ";"}) {
+      SCOPED_TRACE(std::to_string(i) + " " + special);
+      const std::string stmt =
+          "insert into t values ('" + body + special + tail + "');";
+
+      EXPECT_EQ(strv({stmt, "select 1;"}), split_batch(stmt + "select 1;"));
+    }
+
+    const std::string dq = "select \"" + body + "\\\"\"\"" + tail + "\";";
+    EXPECT_EQ(strv({dq, "select 1;"}), split_batch(dq + "select 1;"));
+  }
+
+  EXPECT_EQ(strv({"select '" + std::string(100, 'x') + "\\';"}),
+            split_batch("select '" + std::string(100, 'x') + "\\';"));
+}
+
 TEST_P(Statement_splitter, ansi_quotes) {
   // if ansi_quotes then "" is handled the same way as ``
   EXPECT_EQ(strv({R"*("a"";b";)*", "'a'';b';", "`a``;b`;"}),